@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "analyzer_pool.hpp"
+
+#include "analysis/analyzers.hpp"
+#include "utils/hash_utils.hpp"
+
+namespace iresearch {
+namespace analysis {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      analyzer_pool implementation
+// -----------------------------------------------------------------------------
+
+struct analyzer_pool::bucket {
+  bucket(const string_ref& name, const type_info& args_format,
+         std::string&& args, size_t pool_size)
+    : name(name),
+      args_format(args_format),
+      args(std::move(args)),
+      pool(pool_size) {
+  }
+
+  std::string name;
+  type_info args_format;
+  std::string args; // normalized arguments
+  pool_t pool;
+}; // bucket
+
+/*static*/ analyzer::ptr analyzer_pool::factory::make(const bucket& owner) {
+  return analyzers::get(owner.name, owner.args_format, owner.args);
+}
+
+analyzer_pool::key::key(
+    const string_ref& name,
+    type_info::type_id args_format,
+    const string_ref& args) noexcept
+  : name(name),
+    args_format(args_format),
+    args(args),
+    hash(hash_combine(
+      hash_combine(hash_utils::hash(name), args_format),
+      hash_utils::hash(args))) {
+}
+
+/*static*/ analyzer_pool& analyzer_pool::global() {
+  static analyzer_pool INSTANCE;
+  return INSTANCE;
+}
+
+analyzer_pool::analyzer_pool(
+    size_t pool_size /*= DEFAULT_POOL_SIZE*/,
+    size_t max_definitions /*= DEFAULT_MAX_DEFINITIONS*/) noexcept
+  : pool_size_(pool_size),
+    max_definitions_(max_definitions) {
+}
+
+analyzer_pool::~analyzer_pool() = default;
+
+analyzer_pool::ptr analyzer_pool::get(
+    const string_ref& name,
+    const type_info& args_format,
+    const string_ref& args,
+    bool load_library /*= true*/) {
+  std::string normalized;
+
+  if (!analyzers::normalize(normalized, name, args_format, args, load_library)) {
+    return ptr(nullptr, nullptr);
+  }
+
+  std::shared_ptr<bucket> target; // keeps bucket alive if evicted concurrently
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (const auto* cached = buckets_.get(key(name, args_format.id(), normalized));
+        cached) {
+      target = *cached;
+    } else {
+      // first usage of the definition
+      target = std::make_shared<bucket>(
+        name, args_format, std::move(normalized), pool_size_);
+
+      buckets_.emplace(
+        key(target->name, args_format.id(), target->args),
+        std::shared_ptr<bucket>(target), 1);
+      buckets_.shrink(max_definitions_);
+    }
+  }
+
+  // acquired instance may outlive an evicted bucket and its volatile pool
+  return target->pool.emplace(*target);
+}
+
+void analyzer_pool::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buckets_.clear();
+}
+
+size_t analyzer_pool::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buckets_.size();
+}
+
+} // analysis
+} // ROOT
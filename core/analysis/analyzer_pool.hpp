@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_ANALYZER_POOL_H
+#define IRESEARCH_ANALYZER_POOL_H
+
+#include <memory>
+#include <mutex>
+
+#include "analyzer.hpp"
+#include "utils/lru_cache.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/object_pool.hpp"
+
+namespace iresearch {
+namespace analysis {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class analyzer_pool
+/// @brief thread-safe pool of analyzer instances keyed by analyzer type and
+///        normalized arguments, an acquired instance is used exclusively by
+///        its owner and returned back into the pool on release, i.e. reusing
+///        an idle instance requires no allocation, the number of known
+///        definitions is bounded, least recently used ones are dropped
+///        together with their idle instances
+//////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API analyzer_pool : private util::noncopyable {
+ private:
+  struct bucket;
+
+  struct factory {
+    using ptr = analyzer::ptr;
+
+    static ptr make(const bucket& owner);
+  };
+
+  using pool_t = unbounded_object_pool_volatile<factory>;
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief exclusively owned analyzer instance returned back into the pool
+  ///        on destruction, evaluates to 'false' if an analyzer can't be
+  ///        instantiated
+  ////////////////////////////////////////////////////////////////////////////////
+  using ptr = pool_t::ptr;
+
+  // max number of idle instances kept per analyzer definition
+  static constexpr size_t DEFAULT_POOL_SIZE = 64;
+
+  // max number of analyzer definitions known to the pool
+  static constexpr size_t DEFAULT_MAX_DEFINITIONS = 1024;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief pool shared by all users within a process
+  ////////////////////////////////////////////////////////////////////////////////
+  static analyzer_pool& global();
+
+  explicit analyzer_pool(
+    size_t pool_size = DEFAULT_POOL_SIZE,
+    size_t max_definitions = DEFAULT_MAX_DEFINITIONS) noexcept;
+  ~analyzer_pool();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief acquires an instance of an analyzer specified by name and
+  ///        arguments, a new instance is created via 'analyzers::get(...)'
+  ///        only if there are no idle ones
+  /// @note arguments are normalized via 'analyzers::normalize(...)' before
+  ///       the lookup, i.e. equivalent arguments share a definition
+  ////////////////////////////////////////////////////////////////////////////////
+  ptr get(
+    const string_ref& name,
+    const type_info& args_format,
+    const string_ref& args,
+    bool load_library = true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief drops all definitions together with their idle instances,
+  ///        acquired instances are unaffected
+  ////////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @returns number of distinct analyzer definitions known to the pool
+  ////////////////////////////////////////////////////////////////////////////////
+  size_t size() const;
+
+ private:
+  struct key {
+    key(const string_ref& name, type_info::type_id args_format,
+        const string_ref& args) noexcept;
+
+    string_ref name;
+    type_info::type_id args_format;
+    string_ref args;
+    size_t hash;
+  };
+
+  struct key_hash {
+    size_t operator()(const key& value) const noexcept { return value.hash; }
+  };
+
+  struct key_equal {
+    bool operator()(const key& lhs, const key& rhs) const noexcept {
+      return lhs.args_format == rhs.args_format
+        && lhs.name == rhs.name
+        && lhs.args == rhs.args;
+    }
+  };
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  mutable std::mutex mutex_;
+  // keyed by normalized arguments, keys refer to strings owned by buckets,
+  // each definition accounts 1 to bound the number of definitions
+  lru_cache<key, std::shared_ptr<bucket>, key_hash, key_equal> buckets_;
+  size_t pool_size_;
+  size_t max_definitions_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // analyzer_pool
+
+} // analysis
+} // ROOT
+
+#endif // IRESEARCH_ANALYZER_POOL_H
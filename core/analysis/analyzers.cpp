@@ -33,6 +33,7 @@
   #include "token_stopwords_stream.hpp"
   #include "pipeline_token_stream.hpp"
   #include "segmentation_token_stream.hpp"
+  #include "common_grams_token_stream.hpp"
 #endif
 
 #include "analysis/analyzers.hpp"
@@ -211,6 +212,7 @@ namespace analysis {
     irs::analysis::token_stopwords_stream::init();
     irs::analysis::pipeline_token_stream::init();
     irs::analysis::segmentation_token_stream::init();
+    irs::analysis::common_grams_token_stream::init();
   #endif
 }
 
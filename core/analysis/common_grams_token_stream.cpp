@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "common_grams_token_stream.hpp"
+
+#include <algorithm>
+
+#include "analyzer_pool.hpp"
+
+#include <rapidjson/rapidjson/document.h> // for rapidjson::Document
+#include <rapidjson/rapidjson/writer.h> // for rapidjson::Writer
+#include <rapidjson/rapidjson/stringbuffer.h> // for rapidjson::StringBuffer
+
+namespace {
+
+constexpr irs::string_ref ANALYZER_PARAM_NAME = "analyzer";
+constexpr irs::string_ref TYPE_PARAM_NAME = "type";
+constexpr irs::string_ref PROPERTIES_PARAM_NAME = "properties";
+constexpr irs::string_ref WORDS_PARAM_NAME = "words";
+constexpr irs::string_ref SEPARATOR_PARAM_NAME = "separator";
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief common grams configuration as read from jSON arguments
+////////////////////////////////////////////////////////////////////////////////
+struct json_options {
+  std::vector<std::string> words;
+  std::string separator{irs::analysis::common_grams_token_stream::DEFAULT_SEPARATOR};
+  std::string type; // wrapped analyzer type
+  std::string properties; // wrapped analyzer properties
+};
+
+bool parse_json_config(const irs::string_ref& args, json_options& options) {
+  rapidjson::Document json;
+  if (json.Parse(args.c_str(), args.size()).HasParseError()) {
+    IR_FRMT_ERROR(
+      "Invalid jSON arguments passed while constructing common_grams_token_stream, "
+      "arguments: %s",
+      args.c_str());
+
+    return false;
+  }
+
+  if (rapidjson::kObjectType != json.GetType()) {
+    IR_FRMT_ERROR(
+      "Not a jSON object passed while constructing common_grams_token_stream, "
+      "arguments: %s",
+      args.c_str());
+
+    return false;
+  }
+
+  if (!json.HasMember(ANALYZER_PARAM_NAME.c_str()) ||
+      !json[ANALYZER_PARAM_NAME.c_str()].IsObject()) {
+    IR_FRMT_ERROR(
+      "Failed to read '%s' attribute as object while constructing "
+      "common_grams_token_stream from jSON arguments: %s",
+      ANALYZER_PARAM_NAME.c_str(), args.c_str());
+    return false;
+  }
+
+  auto& analyzer = json[ANALYZER_PARAM_NAME.c_str()];
+
+  if (!analyzer.HasMember(TYPE_PARAM_NAME.c_str()) ||
+      !analyzer[TYPE_PARAM_NAME.c_str()].IsString()) {
+    IR_FRMT_ERROR(
+      "Failed to read '%s' attribute of '%s' member as string while constructing "
+      "common_grams_token_stream from jSON arguments: %s",
+      TYPE_PARAM_NAME.c_str(), ANALYZER_PARAM_NAME.c_str(), args.c_str());
+    return false;
+  }
+
+  options.type = analyzer[TYPE_PARAM_NAME.c_str()].GetString();
+
+  if (!analyzer.HasMember(PROPERTIES_PARAM_NAME.c_str())) {
+    IR_FRMT_ERROR(
+      "Failed to get '%s' attribute of '%s' member while constructing "
+      "common_grams_token_stream from jSON arguments: %s",
+      PROPERTIES_PARAM_NAME.c_str(), ANALYZER_PARAM_NAME.c_str(), args.c_str());
+    return false;
+  }
+
+  {
+    rapidjson::StringBuffer properties_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(properties_buffer);
+    analyzer[PROPERTIES_PARAM_NAME.c_str()].Accept(writer);
+    options.properties = properties_buffer.GetString();
+  }
+
+  if (!json.HasMember(WORDS_PARAM_NAME.c_str()) ||
+      !json[WORDS_PARAM_NAME.c_str()].IsArray()) {
+    IR_FRMT_ERROR(
+      "Failed to read '%s' attribute as array while constructing "
+      "common_grams_token_stream from jSON arguments: %s",
+      WORDS_PARAM_NAME.c_str(), args.c_str());
+    return false;
+  }
+
+  auto& words = json[WORDS_PARAM_NAME.c_str()];
+  options.words.reserve(words.Size());
+  for (auto word = words.Begin(), end = words.End(); word != end; ++word) {
+    if (!word->IsString()) {
+      IR_FRMT_ERROR(
+        "Non-string value in '%s' while constructing common_grams_token_stream "
+        "from jSON arguments: %s",
+        WORDS_PARAM_NAME.c_str(), args.c_str());
+      return false;
+    }
+
+    options.words.emplace_back(word->GetString(), word->GetStringLength());
+  }
+
+  // canonical order for normalization
+  std::sort(options.words.begin(), options.words.end());
+  options.words.erase(
+    std::unique(options.words.begin(), options.words.end()),
+    options.words.end());
+
+  if (json.HasMember(SEPARATOR_PARAM_NAME.c_str())) {
+    auto& separator = json[SEPARATOR_PARAM_NAME.c_str()];
+    if (!separator.IsString()) {
+      IR_FRMT_ERROR(
+        "Failed to read '%s' attribute as string while constructing "
+        "common_grams_token_stream from jSON arguments: %s",
+        SEPARATOR_PARAM_NAME.c_str(), args.c_str());
+      return false;
+    }
+
+    options.separator.assign(separator.GetString(), separator.GetStringLength());
+  }
+
+  return true;
+}
+
+bool normalize_json_config(const irs::string_ref& args, std::string& definition) {
+  json_options options;
+  if (!parse_json_config(args, options)) {
+    return false;
+  }
+
+  std::string normalized;
+  if (!irs::analysis::analyzers::normalize(
+        normalized, options.type,
+        irs::type<irs::text_format::json>::get(),
+        options.properties)) {
+    IR_FRMT_ERROR(
+      "Failed to normalize wrapped analyzer of type '%s' with properties '%s' "
+      "while constructing common_grams_token_stream from jSON arguments: %s",
+      options.type.c_str(), options.properties.c_str(), args.c_str());
+    return false;
+  }
+
+  rapidjson::Document json;
+  json.SetObject();
+  auto& allocator = json.GetAllocator();
+
+  rapidjson::Document properties;
+  properties.Parse(normalized.c_str(), normalized.size());
+
+  rapidjson::Value analyzer(rapidjson::kObjectType);
+  analyzer.AddMember(
+    rapidjson::StringRef(TYPE_PARAM_NAME.c_str(), TYPE_PARAM_NAME.size()),
+    rapidjson::StringRef(options.type.c_str(), options.type.size()),
+    allocator);
+  analyzer.AddMember(
+    rapidjson::StringRef(PROPERTIES_PARAM_NAME.c_str(), PROPERTIES_PARAM_NAME.size()),
+    rapidjson::Value(properties, allocator),
+    allocator);
+  json.AddMember(
+    rapidjson::StringRef(ANALYZER_PARAM_NAME.c_str(), ANALYZER_PARAM_NAME.size()),
+    analyzer,
+    allocator);
+
+  json.AddMember(
+    rapidjson::StringRef(SEPARATOR_PARAM_NAME.c_str(), SEPARATOR_PARAM_NAME.size()),
+    rapidjson::StringRef(options.separator.c_str(), options.separator.size()),
+    allocator);
+
+  rapidjson::Value words(rapidjson::kArrayType);
+  for (auto& word : options.words) {
+    words.PushBack(rapidjson::StringRef(word.c_str(), word.size()), allocator);
+  }
+  json.AddMember(
+    rapidjson::StringRef(WORDS_PARAM_NAME.c_str(), WORDS_PARAM_NAME.size()),
+    words,
+    allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  json.Accept(writer);
+  definition = buffer.GetString();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief args is a jSON encoded object with the following attributes:
+///        "analyzer" (object): wrapped analyzer definition, i.e. an object
+///                             with "type" and "properties" attributes
+///        "words" (string-list): common words to build bigrams for
+///        "separator" (string): separator between bigram parts,
+///                              a single space by default
+////////////////////////////////////////////////////////////////////////////////
+irs::analysis::analyzer::ptr make_json(const irs::string_ref& args) {
+  json_options json_opts;
+  if (!parse_json_config(args, json_opts)) {
+    return nullptr;
+  }
+
+  irs::analysis::common_grams_token_stream::options_t options;
+
+  // wrapped analyzer is returned back into the pool with the parent
+  auto base = irs::analysis::analyzer_pool::global().get(
+    json_opts.type,
+    irs::type<irs::text_format::json>::get(),
+    json_opts.properties);
+
+  if (!base) {
+    IR_FRMT_ERROR(
+      "Failed to create wrapped analyzer of type '%s' with properties '%s' "
+      "while constructing common_grams_token_stream from jSON arguments: %s",
+      json_opts.type.c_str(), json_opts.properties.c_str(), args.c_str());
+    return nullptr;
+  }
+
+  options.base = base.release();
+  options.separator = std::move(json_opts.separator);
+  options.words.reserve(json_opts.words.size());
+  for (auto& word : json_opts.words) {
+    options.words.emplace(std::move(word));
+  }
+
+  return std::make_shared<irs::analysis::common_grams_token_stream>(
+    std::move(options));
+}
+
+REGISTER_ANALYZER_JSON(irs::analysis::common_grams_token_stream, make_json,
+  normalize_json_config);
+
+}
+
+namespace iresearch {
+namespace analysis {
+
+common_grams_token_stream::common_grams_token_stream(options_t&& options)
+  : analyzer{irs::type<common_grams_token_stream>::get()},
+    words_(std::move(options.words)),
+    separator_(std::move(options.separator)),
+    base_(std::move(options.base)),
+    base_term_(base_ ? irs::get<term_attribute>(*base_) : nullptr),
+    base_inc_(base_ ? irs::get<increment>(*base_) : nullptr),
+    base_offs_(base_ ? irs::get<offset>(*base_) : nullptr),
+    attrs_{ {}, {}, base_offs_ ? &offs_ : attribute_ptr<offset>{} } {
+  assert(!base_ || (base_term_ && base_inc_));
+}
+
+bool common_grams_token_stream::next() {
+  auto& inc = std::get<increment>(attrs_);
+  auto& term = std::get<term_attribute>(attrs_);
+
+  if (pending_unigram_) {
+    // emit unigram following the bigram it ends
+    pending_unigram_ = false;
+    inc.value = base_inc_->value;
+    term.value = base_term_->value;
+    if (base_offs_) {
+      offs_ = *base_offs_;
+    }
+  } else {
+    if (!base_ || !base_->next()) {
+      return false;
+    }
+
+    const bytes_ref value = base_term_->value;
+    const bool common = is_common(value);
+
+    if (has_prev_ && 1 == base_inc_->value && (prev_common_ || common)) {
+      // emit bigram at the position of the previous unigram
+      make_gram(gram_, prev_term_, value, separator_);
+      pending_unigram_ = true;
+      inc.value = 0;
+      term.value = gram_;
+      if (base_offs_) {
+        offs_.start = prev_offs_.start;
+        offs_.end = base_offs_->end;
+      }
+    } else {
+      inc.value = base_inc_->value;
+      term.value = value;
+      if (base_offs_) {
+        offs_ = *base_offs_;
+      }
+    }
+
+    // remember current unigram since wrapped analyzer
+    // may reuse its buffer on the next call
+    has_prev_ = true;
+    prev_common_ = common;
+    prev_term_.assign(value.c_str(), value.size());
+    if (base_offs_) {
+      prev_offs_ = *base_offs_;
+    }
+  }
+
+  return true;
+}
+
+bool common_grams_token_stream::reset(const string_ref& data) {
+  has_prev_ = false;
+  prev_common_ = false;
+  pending_unigram_ = false;
+  return base_ && base_->reset(data);
+}
+
+/*static*/ void common_grams_token_stream::init() {
+  REGISTER_ANALYZER_JSON(common_grams_token_stream, make_json,
+    normalize_json_config);  // match registration above
+}
+
+} // analysis
+} // ROOT
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COMMON_GRAMS_TOKEN_STREAM_H
+#define IRESEARCH_COMMON_GRAMS_TOKEN_STREAM_H
+
+#include <absl/container/flat_hash_set.h>
+
+#include "shared.hpp"
+#include "analyzers.hpp"
+#include "token_attributes.hpp"
+#include "utils/frozen_attributes.hpp"
+
+namespace iresearch {
+namespace analysis {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class common_grams_token_stream
+/// @brief an analyzer producing tokens of the wrapped analyzer interleaved
+///        with bigrams of adjacent tokens where at least one of them is a
+///        common word, e.g. "the state of the art" produces:
+///        "the", "the state", "state", "state of", "of", "of the", "the",
+///        "the art", "art"
+/// @note bigrams share position with their first token (increment 0), so
+///       a phrase over bigrams and uncovered unigrams matches the same
+///       documents as the original phrase while reading far fewer positions
+////////////////////////////////////////////////////////////////////////////////
+class common_grams_token_stream final
+  : public analyzer,
+    private util::noncopyable {
+ public:
+  using words_set = absl::flat_hash_set<std::string>;
+
+  struct options_t {
+    words_set words; // common words
+    std::string separator{DEFAULT_SEPARATOR}; // separator between bigram parts
+    analyzer::ptr base; // wrapped analyzer
+  };
+
+  static constexpr string_ref DEFAULT_SEPARATOR = " ";
+
+  static constexpr string_ref type_name() noexcept { return "common_grams"; }
+  static void init(); // for triggering registration in a static build
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stores in 'out' a bigram composed of 'lhs' and 'rhs' delimited
+  ///        by 'separator'
+  //////////////////////////////////////////////////////////////////////////////
+  static void make_gram(
+      bstring& out,
+      const bytes_ref& lhs,
+      const bytes_ref& rhs,
+      const string_ref& separator) {
+    out.clear();
+    out.reserve(lhs.size() + separator.size() + rhs.size());
+    out.append(lhs.c_str(), lhs.size());
+    out.append(ref_cast<byte_type>(separator).c_str(), separator.size());
+    out.append(rhs.c_str(), rhs.size());
+  }
+
+  explicit common_grams_token_stream(options_t&& options);
+
+  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+  virtual bool next() override;
+  virtual bool reset(const string_ref& data) override;
+
+ private:
+  using attributes = std::tuple<
+    increment,
+    term_attribute,
+    attribute_ptr<offset>>;
+
+  bool is_common(const bytes_ref& term) const {
+    return words_.contains(ref_cast<char>(term));
+  }
+
+  words_set words_;
+  std::string separator_;
+  analyzer::ptr base_;
+  const term_attribute* base_term_;
+  const increment* base_inc_;
+  const offset* base_offs_; // nullptr if wrapped analyzer has no offsets
+  bstring prev_term_; // previous unigram
+  bstring gram_; // current bigram
+  offset prev_offs_; // offsets of the previous unigram
+  offset offs_;
+  attributes attrs_;
+  bool has_prev_{false}; // previous unigram is present
+  bool prev_common_{false}; // previous unigram is a common word
+  bool pending_unigram_{false}; // bigram was emitted, unigram follows
+};
+
+} // analysis
+} // ROOT
+
+#endif // IRESEARCH_COMMON_GRAMS_TOKEN_STREAM_H
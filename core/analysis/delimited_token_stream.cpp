@@ -249,6 +249,32 @@ bool delimited_token_stream::next() {
   return true;
 }
 
+size_t delimited_token_stream::next_batch(token* tokens, size_t count) {
+  const auto& inc = std::get<increment>(attrs_);
+  const auto& offset = std::get<irs::offset>(attrs_);
+  const auto& payload = std::get<irs::payload>(attrs_);
+  const auto& term = std::get<term_attribute>(attrs_);
+
+  batch_buf_.clear();
+
+  size_t i = 0;
+
+  for (; i < count && next(); ++i) {
+    auto& token = tokens[i];
+    token.term = term.value.c_str() == payload.value.c_str()
+      ? term.value
+      : batch_buf_.append(term.value); // quoted term evaluated into 'term_buf_'
+    token.payload = payload.value;
+    token.increment = inc.value;
+    token.start = offset.start;
+    token.end = offset.end;
+  }
+
+  batch_buf_.commit(tokens, tokens + i);
+
+  return i;
+}
+
 bool delimited_token_stream::reset(const string_ref& data) {
   data_ = ref_cast<byte_type>(data);
 
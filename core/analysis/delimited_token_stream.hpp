@@ -48,6 +48,8 @@ class delimited_token_stream final
     return irs::get_mutable(attrs_, type);
   }
   virtual bool next() override;
+  virtual bool batched() const noexcept override { return true; }
+  virtual size_t next_batch(token* tokens, size_t count) override;
   virtual bool reset(const string_ref& data) override;
 
  private:
@@ -61,6 +63,7 @@ class delimited_token_stream final
   bytes_ref delim_;
   bstring delim_buf_;
   bstring term_buf_; // buffer for the last evaluated term
+  token_buffer batch_buf_; // buffer for evaluated terms of the last batch
   attributes attrs_;
 };
 
@@ -364,6 +364,24 @@ bool ngram_token_stream_base::reset(const irs::string_ref& value) noexcept {
   data_end_ = data_.end();
   offset.start = 0;
   length_ = 0;
+  begin_symbol_ = 0;
+  ngram_end_symbol_ = 0;
+  symbols_.clear();
+
+  if (InputType::UTF8 == options_.stream_bytes_type
+      && !utf8_utils::is_ascii(data_)) {
+    // evaluate symbol boundaries once rather than for every emitted ngram,
+    // 'symbols_' keeps its capacity between resets
+    try {
+      for (auto* it = data_.begin(); it < data_end_; it = utf8_utils::next(it, data_end_)) {
+        symbols_.push_back(static_cast<uint32_t>(std::distance(data_.begin(), it)));
+      }
+
+      symbols_.push_back(static_cast<uint32_t>(data_.size()));
+    } catch (...) {
+      return false;
+    }
+  }
   if (options_.preserve_original) {
     if (!start_marker_empty_) {
       emit_original_ = EmitOriginal::WithStartMarker;
@@ -393,13 +411,20 @@ bool ngram_token_stream_base::reset(const irs::string_ref& value) noexcept {
 }
 
 template<irs::analysis::ngram_token_stream_base::InputType StreamType>
-bool ngram_token_stream<StreamType>::next_symbol(const byte_type*& it) const noexcept {
+bool ngram_token_stream<StreamType>::next_symbol(
+    const byte_type*& it,
+    size_t& symbol) const noexcept {
   IRS_ASSERT(it);
   if (it < data_end_) {
     if constexpr (StreamType == InputType::Binary) {
       ++it;
     } else if constexpr (StreamType == InputType::UTF8) {
-      it = irs::utf8_utils::next(it, data_end_);
+      if (symbols_.empty()) {
+        ++it; // single byte symbols only
+      } else {
+        IRS_ASSERT(symbol + 1 < symbols_.size());
+        it = data_.begin() + symbols_[++symbol];
+      }
     }
     return true;
   }
@@ -413,7 +438,7 @@ bool ngram_token_stream<StreamType>::next() noexcept {
   auto& inc = std::get<increment>(attrs_);
 
   while (begin_ < data_end_) {
-    if (length_ < options_.max_gram && next_symbol(ngram_end_)) {
+    if (length_ < options_.max_gram && next_symbol(ngram_end_, ngram_end_symbol_)) {
       // we have next ngram from current position
       ++length_;
       if (length_ >= options_.min_gram) {
@@ -455,10 +480,11 @@ bool ngram_token_stream<StreamType>::next() noexcept {
     } else {
       // need to move to next position
       if (EmitOriginal::None == emit_original_) {
-        if (next_symbol(begin_)) {
+        if (next_symbol(begin_, begin_symbol_)) {
           next_inc_val_ = 1;
           length_ = 0;
           ngram_end_ = begin_;
+          ngram_end_symbol_ = begin_symbol_;
           offset.start = static_cast<uint32_t>(std::distance(data_.begin(), begin_));
         } else {
           return false; // stream exhausted
@@ -475,6 +501,75 @@ bool ngram_token_stream<StreamType>::next() noexcept {
   return false;
 }
 
+template<irs::analysis::ngram_token_stream_base::InputType StreamType>
+size_t ngram_token_stream<StreamType>::next_batch(token* tokens, size_t count) {
+  auto& term = std::get<term_attribute>(attrs_);
+  auto& offset = std::get<irs::offset>(attrs_);
+  auto& inc = std::get<increment>(attrs_);
+
+  batch_buf_.clear();
+
+  const bool unmarked = start_marker_empty_ && end_marker_empty_;
+  size_t i = 0;
+
+  while (i < count) {
+    if (unmarked && EmitOriginal::None == emit_original_) {
+      // every ngram references input data, emit ngrams in a single pass
+      // bypassing the generic state machine of 'next()'
+      if (begin_ >= data_end_) {
+        break; // stream exhausted
+      }
+
+      if (length_ < options_.max_gram && next_symbol(ngram_end_, ngram_end_symbol_)) {
+        if (++length_ >= options_.min_gram) {
+          const auto ngram_byte_len = static_cast<uint32_t>(std::distance(begin_, ngram_end_));
+          auto& token = tokens[i++];
+          token.term = bytes_ref(begin_, ngram_byte_len);
+          token.payload = bytes_ref::NIL;
+          token.increment = next_inc_val_;
+          token.start = offset.start;
+          token.end = offset.start + ngram_byte_len;
+          next_inc_val_ = 0;
+        }
+      } else if (next_symbol(begin_, begin_symbol_)) {
+        next_inc_val_ = 1;
+        length_ = 0;
+        ngram_end_ = begin_;
+        ngram_end_symbol_ = begin_symbol_;
+        offset.start = static_cast<uint32_t>(std::distance(data_.begin(), begin_));
+      } else {
+        break; // stream exhausted
+      }
+
+      continue;
+    }
+
+    if (!ngram_token_stream::next()) {
+      break;
+    }
+
+    auto& token = tokens[i++];
+    token.term = term.value.c_str() == marked_term_buffer_.c_str()
+      ? batch_buf_.append(term.value) // marked term is overwritten by the next one
+      : term.value;
+    token.payload = bytes_ref::NIL;
+    token.increment = inc.value;
+    token.start = offset.start;
+    token.end = offset.end;
+  }
+
+  batch_buf_.commit(tokens, tokens + i);
+
+  if (i) {
+    // attributes reflect the last produced token
+    const auto& last = tokens[i - 1];
+    term.value = last.term;
+    offset.end = last.end;
+    inc.value = last.increment;
+  }
+
+  return i;
+}
 
 } // analysis
 } // ROOT
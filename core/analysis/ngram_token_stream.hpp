@@ -23,6 +23,8 @@
 #ifndef IRESEARCH_NGRAM_TOKEN_STREAM_H
 #define IRESEARCH_NGRAM_TOKEN_STREAM_H
 
+#include <vector>
+
 #include "analyzers.hpp"
 #include "token_attributes.hpp"
 #include "utils/frozen_attributes.hpp"
@@ -105,6 +107,13 @@ class ngram_token_stream_base
    const byte_type* data_end_{};
    const byte_type* ngram_end_{};
    size_t length_{};
+
+   // byte offsets of symbols of UTF8 encoded 'data_' followed by the size
+   // of 'data_', computed once per input, empty if every symbol is a single
+   // byte, i.e. symbols are bytes as for binary input
+   std::vector<uint32_t> symbols_;
+   size_t begin_symbol_{}; // index of the symbol pointed by 'begin_'
+   size_t ngram_end_symbol_{}; // index of the symbol pointed by 'ngram_end_'
   
    enum class EmitOriginal {
      None,
@@ -120,6 +129,9 @@ class ngram_token_stream_base
    // pointers to input memory block
    bstring marked_term_buffer_;
 
+   // buffer for marked terms of the last batch
+   token_buffer batch_buf_;
+
    // increment value for next token
    uint32_t next_inc_val_{ 0 };
 
@@ -136,9 +148,11 @@ class ngram_token_stream: public ngram_token_stream_base {
   ngram_token_stream(const ngram_token_stream_base::Options& options);
   
   virtual bool next() noexcept override;
+  virtual bool batched() const noexcept override { return true; }
+  virtual size_t next_batch(token* tokens, size_t count) override;
 
  private:
-  inline bool next_symbol(const byte_type*& it) const noexcept;
+  inline bool next_symbol(const byte_type*& it, size_t& symbol) const noexcept;
 }; // ngram_token_stream
 
 }
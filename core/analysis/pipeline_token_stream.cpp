@@ -23,6 +23,8 @@
 
 #include "pipeline_token_stream.hpp"
 
+#include "analyzer_pool.hpp"
+
 #include <rapidjson/rapidjson/document.h> // for rapidjson::Document
 #include <rapidjson/rapidjson/writer.h> // for rapidjson::Writer
 #include <rapidjson/rapidjson/stringbuffer.h> // for rapidjson::StringBuffer
@@ -103,12 +105,13 @@ bool parse_json_config(const irs::string_ref& args, T& options) {
             rapidjson::Writer< rapidjson::StringBuffer> writer(properties_buffer);
             properties_atr.Accept(writer);
             if constexpr (std::is_same_v<T, irs::analysis::pipeline_token_stream::options_t>) {
-              auto analyzer = irs::analysis::analyzers::get(
+              // members are returned back into the pool with the pipeline
+              auto analyzer = irs::analysis::analyzer_pool::global().get(
                 type,
                 irs::type<irs::text_format::json>::get(),
                 properties_buffer.GetString());
               if (analyzer) {
-                options.push_back(std::move(analyzer));
+                options.push_back(analyzer.release());
               } else {
                 IR_FRMT_ERROR(
                   "Failed to create pipeline member of type '%s' with properties '%s' while constructing "
@@ -301,6 +301,54 @@ bool segmentation_token_stream::next() {
   return false;
 }
 
+size_t segmentation_token_stream::next_batch(token* tokens, size_t count) {
+  auto& offset = std::get<1>(attrs_);
+  auto& term = std::get<2>(attrs_);
+  const auto inc = std::get<0>(attrs_).value;
+
+  batch_buf_.clear();
+
+  size_t i = 0;
+
+  for (; i < count && state_->begin != state_->end; ++i, ++state_->begin) {
+    assert(state_->begin->first.offset() <=
+           std::numeric_limits<uint32_t>::max());
+    assert(state_->begin->second.offset() <=
+           std::numeric_limits<uint32_t>::max());
+    auto& token = tokens[i];
+    token.payload = bytes_ref::NIL;
+    token.increment = inc;
+    token.start = static_cast<uint32_t>(state_->begin->first.offset());
+    token.end = static_cast<uint32_t>(state_->begin->second.offset());
+    const auto value = RS::Unicorn::u_view(*state_->begin);
+
+    switch (options_.case_convert) {
+      case options_t::case_convert_t::NONE:
+        token.term = irs::ref_cast<irs::byte_type>(irs::string_ref(value));
+        break;
+      case options_t::case_convert_t::LOWER:
+        token.term = batch_buf_.append(irs::ref_cast<irs::byte_type>(
+          irs::string_ref(RS::Unicorn::str_lowercase(value))));
+        break;
+      case options_t::case_convert_t::UPPER:
+        token.term = batch_buf_.append(irs::ref_cast<irs::byte_type>(
+          irs::string_ref(RS::Unicorn::str_uppercase(value))));
+        break;
+    }
+  }
+
+  batch_buf_.commit(tokens, tokens + i);
+
+  if (i) {
+    // attributes reflect the last produced token
+    offset.start = tokens[i - 1].start;
+    offset.end = tokens[i - 1].end;
+    term.value = tokens[i - 1].term;
+  }
+
+  return i;
+}
+
 bool segmentation_token_stream::reset(const string_ref& data) {
   auto flags = RS::Unicorn::Segment::alpha;
   switch (options_.word_break) {
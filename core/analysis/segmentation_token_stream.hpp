@@ -54,6 +54,8 @@ class segmentation_token_stream final
   }
   explicit segmentation_token_stream(options_t&& opts);
   virtual bool next() override;
+  virtual bool batched() const noexcept override { return true; }
+  virtual size_t next_batch(token* tokens, size_t count) override;
   virtual bool reset(const string_ref& data) override;
 
 
@@ -68,6 +70,7 @@ class segmentation_token_stream final
   std::shared_ptr<state_t> state_;
   options_t options_;
   std::string term_buf_; // buffer for value if value cannot be referenced directly
+  token_buffer batch_buf_; // buffer for values of the last batch
   attributes attrs_;
 };
 } // namespace analysis
@@ -23,6 +23,8 @@
 /// @author Yuriy Popov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
 #include <cctype> // for std::isspace(...)
 #include <fstream>
 #include <mutex>
@@ -100,6 +102,14 @@ struct text_token_stream::state_t {
   bytes_ref term;
   uint32_t start{};
   uint32_t end{};
+  std::array<byte_type, 128> ascii_classes; // word break classes of ASCII characters
+  string_ref ascii_data; // data tokenized without ICU
+  std::string ascii_buf; // 'ascii_data' converted from a non-UTF8 locale
+  size_t ascii_pos{}; // end of the last word found in 'ascii_data'
+  bool ascii{}; // 'ascii_data' is being tokenized
+  bool ascii_init{}; // 'ascii_classes' are initialized
+  bool ascii_enabled{}; // ASCII data may be tokenized without ICU
+  bool ascii_partial{}; // some ASCII characters are not handled without ICU
   state_t(const options_t& opts, const stopwords_t& stopw) :
     icu_locale("C"), options(opts), stopwords(stopw) {
     // NOTE: use of the default constructor for Locale() or
@@ -145,7 +155,24 @@ struct cached_options_t: public irs::analysis::text_token_stream::options_t {
 };
 
 
+using ascii_classes_t = std::array<irs::byte_type, 128>;
+
+// -----------------------------------------------------------------------------
+/// @brief word break classes of ASCII characters, see UAX #29
+// -----------------------------------------------------------------------------
+enum ascii_class : irs::byte_type {
+  ASCII_OTHER = 0, // never a part of a word, e.g. whitespace
+  ASCII_LETTER, // 'ALetter'
+  ASCII_NUMERIC, // 'Numeric'
+  ASCII_EXTEND_NUM_LET, // 'ExtendNumLet', e.g. '_'
+  ASCII_MID_LETTER, // 'MidLetter', joins letters
+  ASCII_MID_NUM, // 'MidNum', joins digits
+  ASCII_MID_NUM_LET, // 'MidNumLet', joins either letters or digits
+  ASCII_UNKNOWN // character handled via ICU only
+};
+
 static absl::node_hash_map<irs::hashed_string_ref, cached_options_t> cached_state_by_key;
+static absl::node_hash_map<std::string, ascii_classes_t> ascii_classes_by_locale;
 static std::mutex mutex;
 static auto icu_cleanup = irs::make_finally([]()->void{
   // this call will release/free all memory used by ICU (for all users)
@@ -375,6 +402,237 @@ irs::analysis::analyzer::ptr construct(
   return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief filters and stems a UTF8 term stored in 'state.tmp_buf'
+/// @returns false if the term is a stopword
+////////////////////////////////////////////////////////////////////////////////
+bool process_utf8_term(irs::analysis::text_token_stream::state_t& state) {
+  std::string& word_utf8 = state.tmp_buf;
+
+  // ...........................................................................
+  // skip ignored tokens
+  // ...........................................................................
+  if (state.stopwords.find(word_utf8) != state.stopwords.end()) {
+    return false;
+  }
+
+  // ...........................................................................
+  // find the token stem
+  // ...........................................................................
+  if (state.stemmer) {
+    static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
+    const sb_symbol* value = reinterpret_cast<sb_symbol const*>(word_utf8.c_str());
+
+    value = sb_stemmer_stem(state.stemmer.get(), value, (int)word_utf8.size());
+
+    if (value) {
+      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
+      state.term = irs::bytes_ref(reinterpret_cast<const irs::byte_type*>(value),
+                                  sb_stemmer_length(state.stemmer.get()));
+
+      return true;
+    }
+  }
+
+  // ...........................................................................
+  // use the value of the unstemmed token
+  // ...........................................................................
+  static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
+  state.term_buf.assign(reinterpret_cast<const irs::byte_type*>(word_utf8.c_str()), word_utf8.size());
+  state.term = state.term_buf;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ASCII counterpart of 'process_term(state, icu::UnicodeString)',
+///        normalization and accent removal keep ASCII data intact
+////////////////////////////////////////////////////////////////////////////////
+bool process_term(
+    irs::analysis::text_token_stream::state_t& state,
+    const irs::string_ref& data) {
+  std::string& word_utf8 = state.tmp_buf;
+  word_utf8.assign(data.c_str(), data.size());
+
+  // ...........................................................................
+  // case-convert ASCII
+  // ...........................................................................
+  switch (state.options.case_convert) {
+   case irs::analysis::text_token_stream::options_t::case_convert_t::LOWER:
+    for (auto& c : word_utf8) {
+      if (c >= 'A' && c <= 'Z') {
+        c += 'a' - 'A';
+      }
+    }
+    break;
+   case irs::analysis::text_token_stream::options_t::case_convert_t::UPPER:
+    for (auto& c : word_utf8) {
+      if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+      }
+    }
+    break;
+   default:
+    {} // NOOP
+  };
+
+  return process_utf8_term(state);
+}
+
+FORCE_INLINE bool is_ascii_word_class(irs::byte_type cls) noexcept {
+  return ASCII_LETTER == cls
+    || ASCII_NUMERIC == cls
+    || ASCII_EXTEND_NUM_LET == cls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds the next word in ASCII data according to the UAX #29 rules
+///        restricted to the ASCII range, i.e. a word icu::BreakIterator
+///        reports with a rule status other than UBRK_WORD_NONE
+/// @param pos in: where to start searching, out: end of the found word
+/// @param start out: start of the found word
+/// @returns false if there are no more words
+////////////////////////////////////////////////////////////////////////////////
+bool next_ascii_word(
+    const ascii_classes_t& classes,
+    const irs::string_ref& data,
+    size_t& pos,
+    size_t& start) noexcept {
+  const auto* begin = reinterpret_cast<const irs::byte_type*>(data.c_str());
+  const size_t size = data.size();
+
+  while (pos < size) {
+    auto prev = classes[begin[pos]];
+
+    if (!is_ascii_word_class(prev)) {
+      ++pos;
+      continue;
+    }
+
+    for (start = pos++; pos < size; ) {
+      const auto cls = classes[begin[pos]];
+
+      if (is_ascii_word_class(cls)) { // WB5, WB8, WB9, WB10, WB13a, WB13b
+        prev = cls;
+        ++pos;
+        continue;
+      }
+
+      if (pos + 1 < size) {
+        const auto next = classes[begin[pos + 1]];
+
+        if ((ASCII_LETTER == prev && ASCII_LETTER == next // WB6, WB7
+             && (ASCII_MID_LETTER == cls || ASCII_MID_NUM_LET == cls))
+            || (ASCII_NUMERIC == prev && ASCII_NUMERIC == next // WB11, WB12
+                && (ASCII_MID_NUM == cls || ASCII_MID_NUM_LET == cls))) {
+          prev = next;
+          pos += 2;
+          continue;
+        }
+      }
+
+      break;
+    }
+
+    // standalone 'ExtendNumLet' is not a word
+    if (pos - start > 1 || ASCII_EXTEND_NUM_LET != prev) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief derives word break classes of ASCII characters from the rules used
+///        by a specified break iterator, since the rules depend on a locale
+///        and an ICU version, e.g. ICU 72+ treats '@' as a part of a word,
+///        a character is marked as ASCII_UNKNOWN if none of the classes
+///        reproduces the word boundaries reported by the break iterator
+////////////////////////////////////////////////////////////////////////////////
+void init_ascii_classes(
+    icu::BreakIterator& break_iterator,
+    ascii_classes_t& classes) {
+  // defaults according to UAX #29
+  classes.fill(ASCII_OTHER);
+  for (auto c = 'a'; c <= 'z'; ++c) {
+    classes[c] = ASCII_LETTER;
+    classes[c - 'a' + 'A'] = ASCII_LETTER;
+  }
+  for (auto c = '0'; c <= '9'; ++c) {
+    classes[c] = ASCII_NUMERIC;
+  }
+  classes['_'] = ASCII_EXTEND_NUM_LET;
+  classes[':'] = ASCII_MID_LETTER;
+  classes[','] = ASCII_MID_NUM;
+  classes[';'] = ASCII_MID_NUM;
+  classes['.'] = ASCII_MID_NUM_LET;
+  classes['\''] = ASCII_MID_NUM_LET;
+
+  icu::UnicodeString icu_data;
+  std::vector<std::pair<size_t, size_t>> expected;
+  std::vector<std::pair<size_t, size_t>> actual;
+
+  auto matches = [&](const std::string& data) {
+    icu_data = icu::UnicodeString::fromUTF8(
+      icu::StringPiece(data.c_str(), static_cast<int32_t>(data.size())));
+    break_iterator.setText(icu_data);
+
+    expected.clear();
+    for (auto start = break_iterator.first(), end = break_iterator.next();
+         icu::BreakIterator::DONE != end;
+         start = end, end = break_iterator.next()) {
+      if (UWordBreak::UBRK_WORD_NONE != break_iterator.getRuleStatus()) {
+        expected.emplace_back(start, end);
+      }
+    }
+
+    actual.clear();
+    for (size_t pos = 0, start; next_ascii_word(classes, data, pos, start); ) {
+      actual.emplace_back(start, pos);
+    }
+
+    return expected == actual;
+  };
+
+  const irs::byte_type candidates[] {
+    ASCII_OTHER, ASCII_LETTER, ASCII_NUMERIC, ASCII_EXTEND_NUM_LET,
+    ASCII_MID_LETTER, ASCII_MID_NUM, ASCII_MID_NUM_LET
+  };
+
+  for (size_t i = 0; i < classes.size(); ++i) {
+    const std::string c(1, static_cast<char>(i));
+    const std::string probes[] {
+      c, c + c, "a" + c, c + "a", "1" + c, c + "1", "_" + c, c + "_",
+      "a" + c + "a", "1" + c + "1", "a" + c + "1", "1" + c + "a",
+      "a" + c + c + "a", "1" + c + c + "1"
+    };
+
+    const auto default_class = classes[i];
+    classes[i] = ASCII_UNKNOWN;
+
+    for (auto candidate : candidates) {
+      classes[i] = candidate;
+
+      if (std::all_of(std::begin(probes), std::end(probes), matches)) {
+        break;
+      }
+
+      classes[i] = ASCII_UNKNOWN;
+    }
+
+    // prefer the default class for characters it fits
+    if (ASCII_UNKNOWN != classes[i] && default_class != classes[i]) {
+      const auto cls = classes[i];
+      classes[i] = default_class;
+
+      if (!std::all_of(std::begin(probes), std::end(probes), matches)) {
+        classes[i] = cls;
+      }
+    }
+  }
+}
+
 bool process_term(
   irs::analysis::text_token_stream::state_t& state,
   icu::UnicodeString const& data
@@ -417,39 +675,7 @@ bool process_term(
   word_utf8.clear();
   word.toUTF8String(word_utf8);
 
-  // ...........................................................................
-  // skip ignored tokens
-  // ...........................................................................
-  if (state.stopwords.find(word_utf8) != state.stopwords.end()) {
-    return false;
-  }
-
-  // ...........................................................................
-  // find the token stem
-  // ...........................................................................
-  if (state.stemmer) {
-    static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
-    const sb_symbol* value = reinterpret_cast<sb_symbol const*>(word_utf8.c_str());
-
-    value = sb_stemmer_stem(state.stemmer.get(), value, (int)word_utf8.size());
-
-    if (value) {
-      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
-      state.term = irs::bytes_ref(reinterpret_cast<const irs::byte_type*>(value),
-                                  sb_stemmer_length(state.stemmer.get()));
-
-      return true;
-    }
-  }
-
-  // ...........................................................................
-  // use the value of the unstemmed token
-  // ...........................................................................
-  static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
-  state.term_buf.assign(reinterpret_cast<const irs::byte_type*>(word_utf8.c_str()), word_utf8.size());
-  state.term = state.term_buf;
-
-  return true;
+  return process_utf8_term(state);
 }
 
 bool make_locale_from_name(const irs::string_ref& name,
@@ -1025,6 +1251,35 @@ bool text_token_stream::reset(const string_ref& data) {
     );
   }
 
+  if (!state_->ascii_init) {
+    const string_ref language = state_->icu_locale.getLanguage();
+
+    // ICU case-converts ASCII 'I' and 'i' to non-ASCII characters for
+    // these languages
+    state_->ascii_enabled =
+      options_t::case_convert_t::NONE == state_->options.case_convert
+      || (language != "tr" && language != "az");
+
+    if (state_->ascii_enabled) {
+      const std::string key = state_->icu_locale.getName();
+      auto lock = make_lock_guard(::mutex);
+      auto it = ascii_classes_by_locale.find(key);
+
+      if (it == ascii_classes_by_locale.end()) {
+        ascii_classes_t classes;
+        init_ascii_classes(*state_->break_iterator, classes);
+        it = ascii_classes_by_locale.emplace(key, classes).first;
+      }
+
+      state_->ascii_classes = it->second;
+      state_->ascii_partial = std::end(state_->ascii_classes) != std::find(
+        std::begin(state_->ascii_classes), std::end(state_->ascii_classes),
+        ASCII_UNKNOWN);
+    }
+
+    state_->ascii_init = true;
+  }
+
   // ...........................................................................
   // convert encoding to UTF8 for use with ICU
   // ...........................................................................
@@ -1044,13 +1299,34 @@ bool text_token_stream::reset(const string_ref& data) {
     return false; // ICU UnicodeString signatures can handle at most INT32_MAX
   }
 
-  state_->data = icu::UnicodeString::fromUTF8(
-    icu::StringPiece(data_utf8_ref.c_str(), static_cast<int32_t>(data_utf8_ref.size())));
-
   // ...........................................................................
-  // tokenise the unicode data
+  // tokenise ASCII data without ICU, e.g. without conversion to UTF16
   // ...........................................................................
-  state_->break_iterator->setText(state_->data);
+  auto& classes = state_->ascii_classes;
+  state_->ascii = state_->ascii_enabled
+    && utf8_utils::is_ascii(ref_cast<byte_type>(data_utf8_ref))
+    && (!state_->ascii_partial
+        || std::none_of(data_utf8_ref.begin(), data_utf8_ref.end(),
+                        [&classes](char c) { return ASCII_UNKNOWN == classes[byte_type(c)]; }));
+
+  if (state_->ascii) {
+    if (data_utf8_ref.c_str() == data_utf8.c_str()) {
+      state_->ascii_buf = std::move(data_utf8);
+      state_->ascii_data = state_->ascii_buf;
+    } else {
+      state_->ascii_data = data_utf8_ref;
+    }
+
+    state_->ascii_pos = 0;
+  } else {
+    state_->data = icu::UnicodeString::fromUTF8(
+      icu::StringPiece(data_utf8_ref.c_str(), static_cast<int32_t>(data_utf8_ref.size())));
+
+    // .........................................................................
+    // tokenise the unicode data
+    // .........................................................................
+    state_->break_iterator->setText(state_->data);
+  }
 
   // reset term state for ngrams
   state_->term = bytes_ref::NIL;
@@ -1088,6 +1364,24 @@ bool text_token_stream::next() {
 }
 
 bool text_token_stream::next_word() {
+  if (state_->ascii) {
+    for (size_t start; next_ascii_word(state_->ascii_classes, state_->ascii_data,
+                                       state_->ascii_pos, start); ) {
+      const string_ref word(state_->ascii_data.c_str() + start,
+                            state_->ascii_pos - start);
+
+      if (!process_term(*state_, word)) {
+        continue;
+      }
+
+      state_->start = static_cast<uint32_t>(start);
+      state_->end = static_cast<uint32_t>(state_->ascii_pos);
+      return true;
+    }
+
+    return false;
+  }
+
   // ...........................................................................
   // find boundaries of the next word
   // ...........................................................................
@@ -27,17 +27,87 @@
 #include <memory>
 
 #include "utils/attribute_provider.hpp"
+#include "utils/string.hpp"
 
 namespace iresearch {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @struct token
+/// @brief token produced by 'token_stream::next_batch(...)', mirrors values of
+///        'term_attribute', 'payload', 'increment' and 'offset' attributes
+////////////////////////////////////////////////////////////////////////////////
+struct token {
+  bytes_ref term;
+  bytes_ref payload;
+  uint32_t increment;
+  uint32_t start; // start offset
+  uint32_t end; // end offset
+};
+
 class IRESEARCH_API token_stream : public attribute_provider {
  public:
   using ptr = std::unique_ptr<token_stream>;
 
   virtual ~token_stream() = default;
   virtual bool next() = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the stream implements 'next_batch(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool batched() const noexcept { return false; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief produces up to 'count' next tokens at once, i.e. counterpart of
+  ///        calling 'next()' and reading attributes for every token
+  /// @returns number of produced tokens, 0 if the stream is exhausted
+  /// @note produced values remain valid until the next call to either
+  ///       'next(...)', 'next_batch(...)' or 'reset(...)', attributes reflect
+  ///       the last produced token
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t next_batch(token* /*tokens*/, size_t /*count*/) {
+    return 0;
+  }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class token_buffer
+/// @brief storage for terms of a batch which can't reference an input data,
+///        e.g. case converted terms
+////////////////////////////////////////////////////////////////////////////////
+class token_buffer {
+ public:
+  void clear() noexcept { buf_.clear(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stores a specified term in a buffer
+  /// @returns placeholder value to be resolved by 'commit(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  bytes_ref append(const bytes_ref& term) {
+    buf_.append(term.c_str(), term.size());
+    return bytes_ref(nullptr, term.size());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resolves terms of a specified batch stored via 'append(...)',
+  ///        buffer must not be modified while the terms are in use
+  //////////////////////////////////////////////////////////////////////////////
+  void commit(token* begin, token* end) const noexcept {
+    auto* data = buf_.c_str();
+
+    for (; begin != end; ++begin) {
+      if (!begin->term.c_str()) {
+        begin->term = bytes_ref(data, begin->term.size());
+        data += begin->term.size();
+      }
+    }
+
+    assert(data == buf_.c_str() + buf_.size());
+  }
+
+ private:
+  bstring buf_;
+}; // token_buffer
+
 }
 
 #endif
@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "columnstore_cache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                  columnstore_cache implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ columnstore_cache& columnstore_cache::global() noexcept {
+  static columnstore_cache INSTANCE;
+  return INSTANCE;
+}
+
+/*static*/ uint64_t columnstore_cache::next_id() noexcept {
+  static std::atomic<uint64_t> ID{ 0 };
+  return ++ID;
+}
+
+columnstore_cache::columnstore_cache(
+    size_t max_memory /*= DEFAULT_MAX_MEMORY*/,
+    size_t shards /*= DEFAULT_SHARDS*/)
+  : shards_(new shard[std::max(size_t(1), shards)]),
+    num_shards_(std::max(size_t(1), shards)),
+    max_memory_(max_memory) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    shards_[i].max_memory = max_memory / num_shards_;
+  }
+}
+
+columnstore_cache::shard& columnstore_cache::get_shard(
+    const key_t& key) noexcept {
+  // use high bits of the hash since the low ones are used
+  // for probing within a shard
+  const uint64_t hash = absl::Hash<key_t>()(key);
+  return shards_[(hash >> 32) % num_shards_];
+}
+
+columnstore_cache::value_ptr columnstore_cache::get(
+    uint64_t id,
+    uint64_t offset) {
+  const key_t key(id, offset);
+  auto& shard = get_shard(key);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  if (const auto* value = shard.cache.get(key); value) {
+    ++shard.hits;
+    return *value;
+  }
+
+  ++shard.misses;
+
+  return nullptr;
+}
+
+columnstore_cache::value_ptr columnstore_cache::put(
+    uint64_t id,
+    uint64_t offset,
+    value_ptr value,
+    size_t memory) {
+  assert(value);
+  const key_t key(id, offset);
+  auto& shard = get_shard(key);
+
+  std::unique_lock<std::mutex> lock(shard.mutex);
+
+  if (const auto* cached = shard.cache.find(key); cached) {
+    // block has been loaded concurrently
+    return *cached;
+  }
+
+  if (memory > max_memory_) {
+    // block doesn't fit the cache
+    return value;
+  }
+
+  auto& offsets = shard.owners[id];
+
+  try {
+    offsets.emplace(offset);
+    shard.cache.emplace(key, value_ptr(value), memory);
+  } catch (...) {
+    offsets.erase(offset);
+
+    if (offsets.empty()) {
+      shard.owners.erase(id);
+    }
+
+    throw;
+  }
+
+  memory_ += memory;
+
+  // block exceeding the share of a shard stays there alone
+  memory_ -= shard.shrink(1);
+
+  if (memory_ > max_memory_) {
+    lock.unlock(); // never hold more than one shard lock at once
+    reclaim(shard);
+  }
+
+  return value;
+}
+
+void columnstore_cache::reclaim(const shard& except) {
+  const size_t first = std::distance<const shard*>(shards_.get(), &except);
+
+  for (size_t i = 1; i < num_shards_ && memory_ > max_memory_; ++i) {
+    auto& shard = shards_[(first + i) % num_shards_];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    while (!shard.cache.empty() && memory_ > max_memory_) {
+      memory_ -= shard.pop();
+    }
+  }
+}
+
+void columnstore_cache::erase(uint64_t id) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    auto& shard = shards_[i];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto owner = shard.owners.find(id);
+
+    if (owner == shard.owners.end()) {
+      continue;
+    }
+
+    const size_t memory = shard.cache.memory();
+
+    for (const auto offset : owner->second) {
+      [[maybe_unused]] const bool erased = shard.cache.erase(key_t(id, offset));
+      assert(erased);
+    }
+
+    memory_ -= memory - shard.cache.memory();
+    shard.owners.erase(owner);
+  }
+}
+
+void columnstore_cache::max_memory(size_t max_memory) {
+  max_memory_ = max_memory;
+
+  for (size_t i = 0; i < num_shards_; ++i) {
+    auto& shard = shards_[i];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.max_memory = max_memory / num_shards_;
+    memory_ -= shard.shrink();
+  }
+}
+
+columnstore_cache::stats columnstore_cache::statistics() const {
+  stats result;
+  result.max_memory = max_memory_;
+
+  for (size_t i = 0; i < num_shards_; ++i) {
+    auto& shard = shards_[i];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result.hits += shard.hits;
+    result.misses += shard.misses;
+    result.evictions += shard.evictions;
+    result.size += shard.cache.size();
+    result.memory += shard.cache.memory();
+  }
+
+  return result;
+}
+
+void columnstore_cache::clear() {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    auto& shard = shards_[i];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    memory_ -= shard.cache.memory();
+    shard.cache.clear();
+    shard.owners.clear();
+    shard.hits = 0;
+    shard.misses = 0;
+    shard.evictions = 0;
+  }
+}
+
+void columnstore_cache::shard::forget(const key_t& key) noexcept {
+  const auto owner = owners.find(key.first);
+  assert(owner != owners.end());
+
+  owner->second.erase(key.second);
+
+  if (owner->second.empty()) {
+    owners.erase(owner);
+  }
+}
+
+size_t columnstore_cache::shard::pop() {
+  ++evictions;
+
+  return cache.pop([this](const key_t& key, const value_ptr&) noexcept {
+    forget(key);
+  });
+}
+
+size_t columnstore_cache::shard::shrink(size_t keep /*= 0*/) {
+  const size_t memory = cache.memory();
+
+  evictions += cache.shrink(
+    max_memory, keep,
+    [this](const key_t& key, const value_ptr&) noexcept {
+      forget(key);
+  });
+
+  return memory - cache.memory();
+}
+
+}
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLUMNSTORE_CACHE_H
+#define IRESEARCH_COLUMNSTORE_CACHE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include "shared.hpp"
+#include "utils/lru_cache.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class columnstore_cache
+/// @brief thread-safe LRU cache of decoded columnstore blocks shared by all
+///        readers of a columnstore, a block is identified by the columnstore
+///        it belongs to and its offset within the columnstore data
+/// @note the cache is split into a number of independently locked shards
+///       each getting an equal share of the memory limit and evicting its
+///       own least recently used blocks, a block exceeding the share is
+///       admitted against the whole limit evicting blocks of other shards
+/// @note a cached block is kept alive by its users after eviction
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API columnstore_cache : private util::noncopyable {
+ public:
+  using value_ptr = std::shared_ptr<const void>;
+
+  struct stats {
+    uint64_t hits{}; // number of block requests served from the cache
+    uint64_t misses{}; // number of block requests which caused block loading
+    uint64_t evictions{}; // number of blocks evicted due to the memory limit
+    size_t size{}; // number of cached blocks
+    size_t memory{}; // amount of memory consumed by cached blocks
+    size_t max_memory{}; // max amount of memory consumed by cached blocks
+  };
+
+  static constexpr size_t DEFAULT_MAX_MEMORY = 64*(size_t(1) << 20);
+  static constexpr size_t DEFAULT_SHARDS = 16;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide cache used by columnstore readers
+  ////////////////////////////////////////////////////////////////////////////
+  static columnstore_cache& global() noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide unique identifier of a columnstore
+  ////////////////////////////////////////////////////////////////////////////
+  static uint64_t next_id() noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @param max_memory max amount of memory consumed by cached blocks,
+  ///        0 disables caching
+  /// @param shards number of independently locked parts of the cache
+  ////////////////////////////////////////////////////////////////////////////
+  explicit columnstore_cache(
+    size_t max_memory = DEFAULT_MAX_MEMORY,
+    size_t shards = DEFAULT_SHARDS);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns block located at a specified offset of a specified columnstore
+  ///          if cached, nullptr otherwise
+  ////////////////////////////////////////////////////////////////////////////
+  value_ptr get(uint64_t id, uint64_t offset);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief caches a specified block consuming 'memory' bytes unless
+  ///        the block has already been cached concurrently
+  /// @returns cached block
+  ////////////////////////////////////////////////////////////////////////////
+  value_ptr put(uint64_t id, uint64_t offset, value_ptr value, size_t memory);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief drops all cached blocks of a specified columnstore
+  ////////////////////////////////////////////////////////////////////////////
+  void erase(uint64_t id);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets max amount of memory consumed by cached blocks, evicts
+  ///        least recently used blocks exceeding the limit
+  ////////////////////////////////////////////////////////////////////////////
+  void max_memory(size_t max_memory);
+
+  stats statistics() const;
+
+  void clear();
+
+ private:
+  using key_t = std::pair<uint64_t, uint64_t>; // columnstore id + block offset
+
+  struct shard {
+    // must be called under lock, returns amount of released memory
+    size_t pop();
+
+    // evicts least recently used entries until the shard fits 'max_memory'
+    // keeping at least 'keep' most recently used ones, must be called under
+    // lock, returns amount of released memory
+    size_t shrink(size_t keep = 0);
+
+    // drops the block from 'owners' right before its eviction
+    void forget(const key_t& key) noexcept;
+
+    mutable std::mutex mutex;
+    lru_cache<key_t, value_ptr> cache;
+    absl::flat_hash_map<uint64_t, absl::flat_hash_set<uint64_t>> owners; // columnstore id -> offsets of cached blocks
+    size_t max_memory{};
+    uint64_t hits{};
+    uint64_t misses{};
+    uint64_t evictions{};
+  }; // shard
+
+  shard& get_shard(const key_t& key) noexcept;
+
+  // evicts least recently used blocks of shards other than 'except'
+  // until the cache fits the memory limit
+  void reclaim(const shard& except);
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::unique_ptr<shard[]> shards_;
+  size_t num_shards_;
+  std::atomic<size_t> memory_{};
+  std::atomic<size_t> max_memory_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // columnstore_cache
+
+}
+
+#endif // IRESEARCH_COLUMNSTORE_CACHE_H
@@ -22,12 +22,15 @@
 
 #include "formats.hpp"
 
+#include <algorithm>
+
 // list of statically loaded formats via init()
 #ifndef IRESEARCH_DLL
   #include "formats_10.hpp"
 #endif
 
 #include "analysis/token_attributes.hpp"
+#include "utils/bytes_utils.hpp"
 #include "utils/hash_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/register.hpp"
@@ -81,6 +84,48 @@ namespace iresearch {
   return INVALID_COLUMN;
 }
 
+size_t postings_reader::decode(
+    const uint64_t* in,
+    const flags& features,
+    term_meta& state) {
+  byte_type buf[MAX_ENCODED_VALUES*bytes_io<uint64_t>::const_max_vsize];
+  auto* out = buf;
+  for (const auto* end = in + MAX_ENCODED_VALUES; in != end; ++in) {
+    vwrite(out, *in);
+  }
+
+  const auto size = decode(buf, features, state);
+  assert(size <= size_t(std::distance(buf, out)));
+
+  // count values occupying the first 'size' bytes
+  size_t count = 0;
+  for (const byte_type* p = buf, *end = buf + size; p < end; ++count) {
+    vskip<uint64_t>(p);
+  }
+
+  return count;
+}
+
+bool document_mask_reader::read(
+    const directory& dir,
+    const segment_meta& meta,
+    bitset& dense,
+    std::vector<doc_id_t>& sparse) {
+  document_mask docs_mask;
+
+  dense.reset(0);
+  sparse.clear();
+
+  if (!read(dir, meta, docs_mask)) {
+    return false;
+  }
+
+  sparse.assign(docs_mask.begin(), docs_mask.end());
+  std::sort(sparse.begin(), sparse.end());
+
+  return true;
+}
+
 /* static */void index_meta_writer::complete(index_meta& meta) noexcept {
   meta.last_gen_ = meta.gen_;
 }
@@ -38,6 +38,7 @@
 #include "utils/type_info.hpp"
 #include "utils/attribute_provider.hpp"
 #include "utils/automaton_decl.hpp"
+#include "utils/bitset.hpp"
 
 namespace iresearch {
 
@@ -73,6 +74,22 @@ struct IRESEARCH_API term_meta : attribute {
   uint32_t freq = 0; // FIXME check whether we can move freq to another place
 }; // term_meta
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class postings_origin
+/// @brief exposed by doc iterators whose documents are all taken from a
+///        single 'source' iterator with doc ids shifted by 'doc_base',
+///        e.g. while merging a segment without deleted documents, allows
+///        postings writer to copy encoded postings of a compatible format
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API postings_origin final : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "postings_origin";
+  }
+
+  const attribute_provider* source{}; // source postings
+  doc_id_t doc_base{}; // value to add to the source doc ids
+}; // postings_origin
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @struct postings_writer
 ////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +173,23 @@ struct IRESEARCH_API postings_reader {
     const flags& features,
     term_meta& state) = 0;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief populates "state" from the values of variable-size encoded input
+  ///        block "in" decoded in advance, e.g. by 'vread_bulk'
+  /// @note caller provides at least 'MAX_ENCODED_VALUES' initialized values,
+  ///       trailing ones might not belong to a block being decoded
+  /// @note default implementation encodes values back and delegates to
+  ///       'decode(const byte_type*, ...)'
+  /// @returns number of values read from in
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t decode(
+    const uint64_t* in,
+    const flags& features,
+    term_meta& state);
+
+  // max number of variable-size encoded values read per term
+  static constexpr size_t MAX_ENCODED_VALUES = 7;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @returns a document iterator for a specified 'cookie' and 'features'
   //////////////////////////////////////////////////////////////////////////////
@@ -260,6 +294,11 @@ struct IRESEARCH_API field_reader {
 
   virtual ~field_reader() = default;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @note 'mask' is valid only during the call
+  /// @note segment readers pass an empty mask, masked documents are filtered
+  ///       out by 'sub_reader::mask(...)'
+  //////////////////////////////////////////////////////////////////////////////
   virtual void prepare(
     const directory& dir,
     const segment_meta& meta,
@@ -291,6 +330,21 @@ struct IRESEARCH_API columnstore_writer {
   virtual column_t push_column(const column_info& info) = 0;
   virtual void rollback() noexcept = 0;
   virtual bool commit() = 0; // @return was anything actually flushed
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief appends all values of a column denoted by a column iterator 'src'
+  ///        to a column 'id' without decoding them, keys of the copied values
+  ///        are shifted by 'doc_base' and expected to be greater than any key
+  ///        written to the column so far
+  /// @returns false if values can't be copied as is, in this case nothing is
+  ///          written and a caller is expected to copy values one by one
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool copy(
+      field_id /*id*/,
+      const attribute_provider& /*src*/,
+      doc_id_t /*doc_base*/) {
+    return false;
+  }
 }; // columnstore_writer
 
 }
@@ -344,6 +398,10 @@ struct IRESEARCH_API columnstore_reader {
     virtual ~column_reader() = default;
 
     // returns corresponding column reader
+    // note that the returned reader is stateful, i.e. it's not thread-safe
+    // and a value it returns is valid only until the next call to the same
+    // reader or reader destruction, use separate readers to access a column
+    // concurrently or to keep several values at once
     virtual columnstore_reader::values_reader_f values() const = 0;
 
     // returns the corresponding column iterator
@@ -410,6 +468,20 @@ struct IRESEARCH_API document_mask_reader {
     const directory& dir,
     const segment_meta& meta,
     document_mask& docs_mask) = 0;
+
+  /// @brief reads masked documents in the form they are stored, i.e. either
+  ///        into 'dense' as a bitset or into 'sparse' as sorted document ids,
+  ///        the other one is left empty
+  /// @note default implementation reads a 'document_mask' and sorts it
+  /// @returns true if there are any deletes in a segment,
+  ///          false - otherwise
+  /// @throws io_error
+  /// @throws index_error
+  virtual bool read(
+    const directory& dir,
+    const segment_meta& meta,
+    bitset& dense,
+    std::vector<doc_id_t>& sparse);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -531,6 +603,7 @@ struct IRESEARCH_API flush_state {
   const flags* features; // segment features
   size_t doc_count;
   const doc_map* docmap;
+  double dense_postings_threshold{}; // @see index_writer::init_options
 };
 
 struct IRESEARCH_API reader_state {
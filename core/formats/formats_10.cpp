@@ -24,15 +24,20 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <deque>
 #include <list>
+#include <mutex>
 #include <numeric>
 
 #include "shared.hpp"
 
+#include <absl/container/flat_hash_map.h>
+
 #include "skip_list.hpp"
 
 #include "formats_10.hpp"
+#include "columnstore_cache.hpp"
 #include "formats_10_attributes.hpp"
 #include "formats_burst_trie.hpp"
 #include "format_utils.hpp"
@@ -44,9 +49,11 @@
 #include "index/index_reader.hpp"
 #include "index/index_meta.hpp"
 
+#include "search/bitset_doc_iterator.hpp"
 #include "search/cost.hpp"
 #include "search/score.hpp"
 
+#include "store/directory_attributes.hpp"
 #include "store/memory_directory.hpp"
 #include "store/store_utils.hpp"
 
@@ -54,6 +61,7 @@
 #include "utils/bit_utils.hpp"
 #include "utils/bitset.hpp"
 #include "utils/lz4compression.hpp"
+#include "utils/zstdcompression.hpp"
 #include "utils/encryption.hpp"
 #include "utils/frozen_attributes.hpp"
 #include "utils/compression.hpp"
@@ -98,8 +106,36 @@ struct format_traits {
   FORCE_INLINE static void skip_block(index_input& in) {
     encode::bitpack::skip_block32(in, BLOCK_SIZE);
   }
+
+  FORCE_INLINE static void write_doc_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    write_block(out, in, buf);
+  }
+
+  FORCE_INLINE static void read_doc_block(
+      index_input& in, uint32_t* buf,  uint32_t* out) {
+    read_block(in, buf, out);
+  }
 }; // format_traits
 
+//////////////////////////////////////////////////////////////////////////////
+/// @struct format_traits_elias_fano
+/// @brief document blocks are stored as partitions of partitioned Elias-Fano
+///        sequence which is noticeably more compact for long posting lists,
+///        frequencies and positions are bit packed
+//////////////////////////////////////////////////////////////////////////////
+struct format_traits_elias_fano : format_traits {
+  FORCE_INLINE static void write_doc_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    encode::elias_fano::write_block(out, in, buf);
+  }
+
+  FORCE_INLINE static void read_doc_block(
+      index_input& in, uint32_t* buf,  uint32_t* out) {
+    encode::elias_fano::read_block(in, buf, out);
+  }
+}; // format_traits_elias_fano
+
 bytes_ref DUMMY; // placeholder for visiting logic in columnstore
 
 class noop_compressor final : compression::compressor {
@@ -229,6 +265,63 @@ inline void prepare_input(
   format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
+inline index_input::ptr reopen_input(const index_input& in) {
+  auto clone = in.reopen(); // reopen thread-safe stream
+
+  if (!clone) {
+    // implementation returned wrong pointer
+    IR_FRMT_ERROR("Failed to reopen input in: %s", __FUNCTION__);
+
+    throw io_error("failed to reopen input");
+  }
+
+  return clone;
+}
+
+// copies 'size' bytes starting from the current position of 'in' to 'out'
+void copy_bytes(index_input& in, index_output& out, size_t size) {
+  const byte_type* data = in.read_buffer(size, BufferHint::NORMAL);
+
+  if (data) {
+    out.write_bytes(data, size);
+    return;
+  }
+
+  byte_type buf[1024];
+
+  while (size) {
+    const size_t to_read = std::min(size, sizeof buf);
+
+    if (to_read != in.read_bytes(buf, to_read)) {
+      throw io_error(string_utils::to_string(
+        "failed to copy " IR_SIZE_T_SPECIFIER " bytes",
+        size));
+    }
+
+    out.write_bytes(buf, to_read);
+    size -= to_read;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct encoded_postings
+/// @brief postings of a term as they are stored in a segment, exposed by
+///        'doc_iterator' in order to copy postings without decoding while
+///        merging segments
+//////////////////////////////////////////////////////////////////////////////
+struct encoded_postings final : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "encoded_postings";
+  }
+
+  const index_input* doc_in{};
+  const index_input* pos_in{};
+  const index_input* pay_in{};
+  const version10::term_meta* term_state{};
+  features field; // field features
+  int32_t version{}; // postings format version
+}; // encoded_postings
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                  postings_writer
 // ----------------------------------------------------------------------------
@@ -247,7 +340,10 @@ inline void prepare_input(
 class postings_writer_base : public irs::postings_writer {
  public:
   static constexpr int32_t TERMS_FORMAT_MIN = 0;
-  static constexpr int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MIN;
+  // postings of terms of a field without frequencies occurring in at least
+  // the specified number of documents are stored as a bitset
+  static constexpr int32_t TERMS_FORMAT_DENSE = TERMS_FORMAT_MIN + 1;
+  static constexpr int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_DENSE;
 
   static constexpr int32_t FORMAT_MIN = 0;
   // positions are stored one based (if first osition is 1 first offset is 0)
@@ -266,7 +362,9 @@ class postings_writer_base : public irs::postings_writer {
   static constexpr int32_t FORMAT_POSITIONS_ZEROBASED = FORMAT_SSE_POSITIONS_ONEBASED + 1;
   // positions are stored zero based, sse used
   static constexpr int32_t FORMAT_SSE_POSITIONS_ZEROBASED = FORMAT_POSITIONS_ZEROBASED + 1;
-  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_POSITIONS_ZEROBASED;
+  // positions are stored zero based, document blocks are Elias-Fano encoded
+  static constexpr int32_t FORMAT_ELIAS_FANO_POSITIONS_ZEROBASED = FORMAT_SSE_POSITIONS_ZEROBASED + 1;
+  static constexpr int32_t FORMAT_MAX = FORMAT_ELIAS_FANO_POSITIONS_ZEROBASED;
 
   static constexpr uint32_t MAX_SKIP_LEVELS = 10;
   static constexpr uint32_t BLOCK_SIZE = 128;
@@ -280,6 +378,12 @@ class postings_writer_base : public irs::postings_writer {
   static constexpr string_ref PAY_EXT = "pay";
   static constexpr string_ref TERMS_FORMAT_NAME = "iresearch_10_postings_terms";
 
+  // number of words in dense postings of a segment with 'docs_count' documents
+  static constexpr size_t dense_words(size_t docs_count) noexcept {
+    constexpr size_t BITS = bits_required<uint64_t>();
+    return (doc_limits::min() + docs_count + BITS - 1) / BITS;
+  }
+
  protected:
   postings_writer_base(int32_t postings_format_version, int32_t terms_format_version)
     : skip_(BLOCK_SIZE, SKIP_N),
@@ -419,6 +523,14 @@ class postings_writer_base : public irs::postings_writer {
     uint32_t last{};                        // last start offset
   }; // pay_stream
 
+  // state of positions and payloads streams at the end of a document block
+  struct block_state {
+    uint64_t pos_ptr{}; // relative to the beginning of term positions
+    uint64_t pay_ptr{}; // relative to the beginning of term payloads
+    uint32_t pend_pos{}; // positions of the last document in the next block
+    uint32_t pay_pos{}; // payload size of the last document in the next block
+  }; // block_state
+
   void begin_term();
   void end_term(version10::term_meta& meta, const uint32_t* tfreq);
 
@@ -428,8 +540,28 @@ class postings_writer_base : public irs::postings_writer {
   void add_position(uint32_t pos, const offset* offs, const payload* pay);
   void end_doc();
 
+  template<typename FormatTraits>
+  void copy_term(
+    const encoded_postings& src,
+    doc_id_t doc_base,
+    version10::term_meta& meta);
+  template<typename FormatTraits>
+  void copy_positions(const encoded_postings& src);
+  void read_block_states(const encoded_postings& src);
+
   void write_skip(size_t level, index_output& out);
 
+  // postings of a term with the specified number of documents are stored
+  // as a bitset
+  bool dense(uint32_t docs_count) const noexcept {
+    return dense_docs_min_ && !features_.freq() && docs_count >= dense_docs_min_;
+  }
+
+  void write_dense(
+    const doc_id_t* begin,
+    const doc_id_t* end,
+    version10::term_meta& meta);
+
   memory::memory_pool<> meta_pool_;
   memory::memory_pool_allocator<version10::term_meta, decltype(meta_pool_)> alloc_{ meta_pool_ };
   skip_writer skip_;
@@ -443,7 +575,11 @@ class postings_writer_base : public irs::postings_writer {
   doc_stream doc_;                  // document stream
   pos_stream::ptr pos_;             // proximity stream
   pay_stream::ptr pay_;             // payloads and offsets stream
+  std::vector<block_state> blocks_; // state of copied positions at block ends
+  const block_state* block_{};      // state of copied positions for skip data
+  std::vector<uint64_t> dense_;     // buffer for dense postings
   size_t docs_count_{};             // number of processed documents
+  uint32_t dense_docs_min_{};       // min number of documents in dense postings
   const int32_t postings_format_version_;
   const int32_t terms_format_version_;
   uint32_t pos_min_; // initial base value for writing positions offsets
@@ -492,6 +628,23 @@ void postings_writer_base::prepare(index_output& out, const irs::flush_state& st
   format_utils::write_header(out, TERMS_FORMAT_NAME, terms_format_version_); // write postings format name
   out.write_vint(BLOCK_SIZE); // write postings block size
 
+  dense_docs_min_ = 0;
+
+  if (terms_format_version_ >= TERMS_FORMAT_DENSE) {
+    if (state.dense_postings_threshold > 0.) {
+      // single document is always stored in term metadata
+      const double docs_min = std::ceil(state.dense_postings_threshold*double(state.doc_count));
+
+      dense_docs_min_ = docs_min < double(std::numeric_limits<uint32_t>::max())
+        ? std::max(uint32_t(2), uint32_t(docs_min))
+        : std::numeric_limits<uint32_t>::max();
+
+      dense_.resize(dense_words(state.doc_count));
+    }
+
+    out.write_vint(dense_docs_min_);
+  }
+
   // prepare documents bitset
   docs_.value.reset(doc_limits::min() + state.doc_count);
 }
@@ -553,9 +706,12 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
   if (features_.position()) {
     assert(pos_);
 
-    const uint64_t pos_ptr = pos_out_->file_pointer();
+    // positions of copied postings are written ahead of documents
+    const uint64_t pos_ptr = block_
+      ? pos_->start + block_->pos_ptr
+      : pos_out_->file_pointer();
 
-    out.write_vint(pos_->block_last);
+    out.write_vint(block_ ? block_->pend_pos : pos_->block_last);
     out.write_vlong(pos_ptr - pos_->skip_ptr[level]);
 
     pos_->skip_ptr[level] = pos_ptr;
@@ -564,10 +720,14 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
       assert(pay_ && pay_out_);
 
       if (features_.payload()) {
-        out.write_vint(static_cast<uint32_t>(pay_->block_last));
+        out.write_vint(block_
+          ? block_->pay_pos
+          : static_cast<uint32_t>(pay_->block_last));
       }
 
-      const uint64_t pay_ptr = pay_out_->file_pointer();
+      const uint64_t pay_ptr = block_
+        ? pay_->start + block_->pay_ptr
+        : pay_out_->file_pointer();
 
       out.write_vlong(pay_ptr - pay_->skip_ptr[level]);
       pay_->skip_ptr[level] = pay_ptr;
@@ -742,6 +902,36 @@ void postings_writer_base::end_term(version10::term_meta& meta, const uint32_t*
   }
 }
 
+void postings_writer_base::write_dense(
+    const doc_id_t* begin,
+    const doc_id_t* end,
+    version10::term_meta& meta) {
+  constexpr size_t BITS = bits_required<uint64_t>();
+  assert(dense(uint32_t(std::distance(begin, end))));
+  assert(!dense_.empty());
+
+  auto& out = *doc_out_;
+
+  std::memset(dense_.data(), 0, sizeof(uint64_t)*dense_.size());
+
+  for (; begin != end; ++begin) {
+    const doc_id_t doc = *begin;
+    assert(doc / BITS < dense_.size());
+
+    irs::set_bit(dense_[doc / BITS], doc % BITS);
+    docs_.value.set(doc);
+    ++meta.docs_count;
+  }
+
+  meta.doc_start = out.file_pointer();
+  meta.freq = std::numeric_limits<uint32_t>::max();
+  meta.e_skip_start = 0;
+
+  for (const auto word : dense_) {
+    out.write_long(int64_t(word));
+  }
+}
+
 template<typename FormatTraits>
 void postings_writer_base::begin_doc(doc_id_t id, const frequency* freq) {
   if (doc_limits::valid(doc_.block_last) && doc_.empty()) {
@@ -757,7 +947,7 @@ void postings_writer_base::begin_doc(doc_id_t id, const frequency* freq) {
   doc_.push(id, freq ? freq->value : 0);
 
   if (doc_.full()) {
-    FormatTraits::write_block(*doc_out_, doc_.deltas, buf_);
+    FormatTraits::write_doc_block(*doc_out_, doc_.deltas, buf_);
 
     if (freq) {
       FormatTraits::write_block(*doc_out_, doc_.freqs, buf_);
@@ -815,14 +1005,218 @@ void postings_writer_base::add_position(uint32_t pos, const offset* offs, const
   }
 }
 
+void postings_writer_base::read_block_states(const encoded_postings& src) {
+  const auto& src_meta = *src.term_state;
+
+  if (src_meta.docs_count <= BLOCK_SIZE) {
+    return; // no skip data
+  }
+
+  // skip data of the 0 level has an entry for each document block
+  // followed by at least one document
+  auto in = reopen_input(*src.doc_in);
+  in->seek(src_meta.doc_start + src_meta.e_skip_start);
+
+  // skip levels are stored from n downto 0
+  for (size_t levels = in->read_vint(); levels > 1; --levels) {
+    const uint64_t length = in->read_vlong();
+    in->seek(in->file_pointer() + length);
+  }
+  in->read_vlong(); // length of the 0 level
+
+  blocks_.resize((src_meta.docs_count - 1) / BLOCK_SIZE);
+
+  uint64_t pos_ptr = 0;
+  uint64_t pay_ptr = 0;
+  for (auto& block : blocks_) {
+    in->read_vint(); // last document in a block
+    in->read_vlong(); // document pointer
+
+    block.pend_pos = in->read_vint();
+    pos_ptr += in->read_vlong();
+    block.pos_ptr = pos_ptr;
+
+    if (features_.any(features::OFFS | features::PAY)) {
+      if (features_.payload()) {
+        block.pay_pos = in->read_vint();
+      }
+
+      pay_ptr += in->read_vlong();
+      block.pay_ptr = pay_ptr;
+    }
+  }
+}
+
+template<typename FormatTraits>
+void postings_writer_base::copy_positions(const encoded_postings& src) {
+  assert(features_.position() && pos_ && pos_out_);
+  const auto& src_meta = *src.term_state;
+  const uint32_t num_blocks = src_meta.freq / BLOCK_SIZE;
+
+  // find the end of positions, vInt encoded tail follows position blocks
+  auto pos_in = reopen_input(*src.pos_in);
+
+  if (src_meta.freq > BLOCK_SIZE) {
+    pos_in->seek(src_meta.pos_start + src_meta.pos_end);
+  } else {
+    pos_in->seek(src_meta.pos_start);
+
+    if (num_blocks) {
+      FormatTraits::skip_block(*pos_in);
+    }
+  }
+
+  uint32_t pay_size = 0;
+  for (uint32_t i = 0, tail = src_meta.freq % BLOCK_SIZE; i < tail; ++i) {
+    uint32_t delta;
+
+    if (features_.payload()) {
+      if (shift_unpack_32(pos_in->read_vint(), delta)) {
+        pay_size = pos_in->read_vint();
+      }
+      if (pay_size) {
+        pos_in->seek(pos_in->file_pointer() + pay_size);
+      }
+    } else {
+      pos_in->read_vint();
+    }
+
+    if (features_.offset()) {
+      if (shift_unpack_32(pos_in->read_vint(), delta)) {
+        pos_in->read_vint();
+      }
+    }
+  }
+
+  const size_t pos_length = pos_in->file_pointer() - src_meta.pos_start;
+  pos_in->seek(src_meta.pos_start);
+  copy_bytes(*pos_in, *pos_out_, pos_length);
+
+  if (!features_.any(features::OFFS | features::PAY)) {
+    return;
+  }
+
+  // payloads and offsets are stored for position blocks only
+  assert(src.pay_in && pay_ && pay_out_);
+  auto pay_in = reopen_input(*src.pay_in);
+  pay_in->seek(src_meta.pay_start);
+
+  for (uint32_t i = 0; i < num_blocks; ++i) {
+    if (features_.payload()) {
+      const size_t size = pay_in->read_vint();
+      if (size) {
+        FormatTraits::skip_block(*pay_in);
+        pay_in->seek(pay_in->file_pointer() + size);
+      }
+    }
+
+    if (features_.offset()) {
+      FormatTraits::skip_block(*pay_in);
+      FormatTraits::skip_block(*pay_in);
+    }
+  }
+
+  const size_t pay_length = pay_in->file_pointer() - src_meta.pay_start;
+  pay_in->seek(src_meta.pay_start);
+  copy_bytes(*pay_in, *pay_out_, pay_length);
+}
+
+template<typename FormatTraits>
+void postings_writer_base::copy_term(
+    const encoded_postings& src,
+    doc_id_t doc_base,
+    version10::term_meta& meta) {
+  assert(src.term_state && src.doc_in);
+  const auto& src_meta = *src.term_state;
+  const bool has_freq = features_.freq();
+
+  begin_term();
+  blocks_.clear();
+
+  // positions, payloads and offsets don't depend on document identifiers
+  // and are copied as is, skip data refers to them via 'blocks_'
+  if (features_.position()) {
+    copy_positions<FormatTraits>(src);
+    read_block_states(src);
+  }
+
+  auto reset_block = make_finally([this]() noexcept { block_ = nullptr; });
+
+  // document blocks are re-encoded since deltas of the first document
+  // and document identifiers in skip data have to be adjusted
+  frequency freq;
+  const frequency* pfreq = has_freq ? &freq : nullptr;
+  uint32_t deltas[BLOCK_SIZE];
+  uint32_t freqs[BLOCK_SIZE];
+  doc_id_t doc = doc_limits::min();
+  index_input::ptr doc_in;
+
+  if (1 == src_meta.docs_count) {
+    deltas[0] = src_meta.e_single_doc;
+    freqs[0] = src_meta.freq;
+  } else {
+    doc_in = reopen_input(*src.doc_in);
+    doc_in->seek(src_meta.doc_start);
+  }
+
+  for (uint32_t left = src_meta.docs_count; left; ) {
+    const uint32_t size = std::min(left, BLOCK_SIZE);
+
+    if (doc_in && BLOCK_SIZE == size) {
+      FormatTraits::read_doc_block(*doc_in, buf_, deltas);
+      if (has_freq) {
+        FormatTraits::read_block(*doc_in, buf_, freqs);
+      }
+    } else if (doc_in) {
+      for (uint32_t i = 0; i < size; ++i) {
+        if (!has_freq) {
+          deltas[i] = doc_in->read_vint();
+        } else if (shift_unpack_32(doc_in->read_vint(), deltas[i])) {
+          freqs[i] = 1;
+        } else {
+          freqs[i] = doc_in->read_vint();
+        }
+      }
+    }
+
+    for (uint32_t i = 0; i < size; ++i) {
+      if (!blocks_.empty() && docs_count_ && 0 == docs_count_ % BLOCK_SIZE) {
+        assert(docs_count_ / BLOCK_SIZE <= blocks_.size());
+        block_ = &blocks_[docs_count_ / BLOCK_SIZE - 1];
+      }
+
+      doc += deltas[i];
+      freq.value = freqs[i];
+
+      const doc_id_t did = doc + doc_base;
+      begin_doc<FormatTraits>(did, pfreq);
+      docs_.value.set(did);
+      end_doc();
+
+      ++meta.docs_count;
+      if (has_freq) {
+        meta.freq += freq.value;
+      }
+    }
+
+    left -= size;
+  }
+
+  end_term(meta, has_freq ? &meta.freq : nullptr);
+
+  if (features_.position()) {
+    meta.pos_end = src_meta.pos_end;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class postings_writer
 //////////////////////////////////////////////////////////////////////////////
 template<typename FormatTraits, bool VolatileAttributes>
 class postings_writer final: public postings_writer_base {
  public:
-  explicit postings_writer(int32_t version)
-    : postings_writer_base(version, TERMS_FORMAT_MAX) {
+  explicit postings_writer(int32_t version, int32_t terms_version = TERMS_FORMAT_MIN)
+    : postings_writer_base(version, terms_version) {
   }
 
   virtual irs::postings_writer::state write(irs::doc_iterator& docs) override;
@@ -844,6 +1238,7 @@ class postings_writer final: public postings_writer_base {
     }
   }
 
+  std::vector<doc_id_t> dense_docs_; // documents of a term of a field without frequencies
   const frequency* freq_{};
   irs::position* pos_{};
   const offset* offs_{};
@@ -862,6 +1257,22 @@ irs::postings_writer::state postings_writer<FormatTraits, VolatileAttributes>::w
   REGISTER_TIMER_DETAILED();
 
   if constexpr (VolatileAttributes) {
+    // postings of a compatible format may be copied without decoding
+    if (auto* origin = irs::get<postings_origin>(docs); origin) {
+      assert(origin->source);
+      auto* src = irs::get<encoded_postings>(*origin->source);
+
+      if (src
+          && src->version == postings_format_version_
+          && features::Mask(src->field) == features::Mask(features_)
+          && !dense(src->term_state->docs_count)) {
+        auto meta = memory::allocate_unique<version10::term_meta>(alloc_);
+        copy_term<FormatTraits>(*src, origin->doc_base, *meta);
+
+        return make_state(*meta.release());
+      }
+    }
+
     auto* subscription = irs::get<attribute_provider_change>(docs);
     assert(subscription);
 
@@ -874,6 +1285,35 @@ irs::postings_writer::state postings_writer<FormatTraits, VolatileAttributes>::w
 
   auto meta = memory::allocate_unique<version10::term_meta>(alloc_);
 
+  if (dense_docs_min_ && !features_.freq()) {
+    // number of documents is unknown in advance
+    dense_docs_.clear();
+    while (docs.next()) {
+      assert(doc_limits::valid(docs.value()));
+      dense_docs_.emplace_back(docs.value());
+    }
+
+    const auto* begin = dense_docs_.data();
+    const auto* end = begin + dense_docs_.size();
+
+    if (dense(uint32_t(dense_docs_.size()))) {
+      write_dense(begin, end, *meta);
+    } else {
+      begin_term();
+
+      for (; begin != end; ++begin) {
+        begin_doc<FormatTraits>(*begin, nullptr);
+        docs_.value.set(*begin);
+        ++meta->docs_count;
+        end_doc();
+      }
+
+      end_term(*meta, nullptr);
+    }
+
+    return make_state(*meta.release());
+  }
+
   begin_term();
 
   while (docs.next()) {
@@ -959,7 +1399,17 @@ struct position_impl<IteratorTraits, true, true>
   void prepare(const doc_state& state) {
     base::prepare(state);
 
-    pay_in_ = state.pay_in->reopen(); // reopen thread-safe stream
+    // payload stream is reopened lazily together with positions stream
+    pay_in_src_ = state.pay_in;
+    pay_in_.reset();
+    pay_ptr_ = state.term_state->pay_start;
+  }
+
+  void open() {
+    base::open();
+
+    assert(pay_in_src_);
+    pay_in_ = pay_in_src_->reopen(); // reopen thread-safe stream
 
     if (!pay_in_) {
       // implementation returned wrong pointer
@@ -968,13 +1418,16 @@ struct position_impl<IteratorTraits, true, true>
       throw io_error("failed to reopen payload input");
     }
 
-    pay_in_->seek(state.term_state->pay_start);
+    pay_in_->seek(pay_ptr_);
   }
 
   void prepare(const skip_state& state)  {
     base::prepare(state);
 
-    pay_in_->seek(state.pay_ptr);
+    pay_ptr_ = state.pay_ptr;
+    if (pay_in_) {
+      pay_in_->seek(pay_ptr_);
+    }
     pay_data_pos_ = state.pay_pos;
   }
 
@@ -1072,7 +1525,9 @@ struct position_impl<IteratorTraits, true, true>
     base::skip(count);
   }
 
-  index_input::ptr pay_in_;
+  const index_input* pay_in_src_{}; // source of the payload stream
+  index_input::ptr pay_in_; // nullptr until first access
+  uint64_t pay_ptr_{}; // where to seek payload stream once opened
   offset offs_;
   payload pay_;
   uint32_t offs_start_deltas_[postings_writer_base::BLOCK_SIZE]{}; // buffer to store offset starts
@@ -1097,7 +1552,17 @@ struct position_impl<IteratorTraits, false, true>
   void prepare(const doc_state& state) {
     base::prepare(state);
 
-    pay_in_ = state.pay_in->reopen(); // reopen thread-safe stream
+    // payload stream is reopened lazily together with positions stream
+    pay_in_src_ = state.pay_in;
+    pay_in_.reset();
+    pay_ptr_ = state.term_state->pay_start;
+  }
+
+  void open() {
+    base::open();
+
+    assert(pay_in_src_);
+    pay_in_ = pay_in_src_->reopen(); // reopen thread-safe stream
 
     if (!pay_in_) {
       // implementation returned wrong pointer
@@ -1106,13 +1571,16 @@ struct position_impl<IteratorTraits, false, true>
       throw io_error("failed to reopen payload input");
     }
 
-    pay_in_->seek(state.term_state->pay_start);
+    pay_in_->seek(pay_ptr_);
   }
 
   void prepare(const skip_state& state)  {
     base::prepare(state);
 
-    pay_in_->seek(state.pay_ptr);
+    pay_ptr_ = state.pay_ptr;
+    if (pay_in_) {
+      pay_in_->seek(pay_ptr_);
+    }
     pay_data_pos_ = state.pay_pos;
   }
 
@@ -1209,7 +1677,9 @@ struct position_impl<IteratorTraits, false, true>
     base::skip(count);
   }
 
-  index_input::ptr pay_in_;
+  const index_input* pay_in_src_{}; // source of the payload stream
+  index_input::ptr pay_in_; // nullptr until first access
+  uint64_t pay_ptr_{}; // where to seek payload stream once opened
   payload pay_;
   uint32_t pay_lengths_[postings_writer_base::BLOCK_SIZE]{}; // buffer to store payload lengths
   size_t pay_data_pos_{}; // current position in a payload buffer
@@ -1231,7 +1701,17 @@ struct position_impl<IteratorTraits, true, false>
   void prepare(const doc_state& state) {
     base::prepare(state);
 
-    pay_in_ = state.pay_in->reopen(); // reopen thread-safe stream
+    // payload stream is reopened lazily together with positions stream
+    pay_in_src_ = state.pay_in;
+    pay_in_.reset();
+    pay_ptr_ = state.term_state->pay_start;
+  }
+
+  void open() {
+    base::open();
+
+    assert(pay_in_src_);
+    pay_in_ = pay_in_src_->reopen(); // reopen thread-safe stream
 
     if (!pay_in_) {
       // implementation returned wrong pointer
@@ -1240,13 +1720,16 @@ struct position_impl<IteratorTraits, true, false>
       throw io_error("failed to reopen payload input");
     }
 
-    pay_in_->seek(state.term_state->pay_start);
+    pay_in_->seek(pay_ptr_);
   }
 
   void prepare(const skip_state& state) {
     base::prepare(state);
 
-    pay_in_->seek(state.pay_ptr);
+    pay_ptr_ = state.pay_ptr;
+    if (pay_in_) {
+      pay_in_->seek(pay_ptr_);
+    }
   }
 
   void read_attributes() noexcept {
@@ -1303,7 +1786,9 @@ struct position_impl<IteratorTraits, true, false>
     base::skip_offsets(*pay_in_);
   }
 
-  index_input::ptr pay_in_;
+  const index_input* pay_in_src_{}; // source of the payload stream
+  index_input::ptr pay_in_; // nullptr until first access
+  uint64_t pay_ptr_{}; // where to seek payload stream once opened
   offset offs_;
   uint32_t offs_start_deltas_[postings_writer_base::BLOCK_SIZE]{}; // buffer to store offset starts
   uint32_t offs_lengts_[postings_writer_base::BLOCK_SIZE]{}; // buffer to store offset lengths
@@ -1333,17 +1818,12 @@ struct position_impl<IteratorTraits, false, false> {
   }
 
   void prepare(const doc_state& state) {
-    pos_in_ = state.pos_in->reopen(); // reopen thread-safe stream
-
-    if (!pos_in_) {
-      // implementation returned wrong pointer
-      IR_FRMT_ERROR("Failed to reopen positions input in: %s", __FUNCTION__);
-
-      throw io_error("failed to reopen positions input");
-    }
-
+    // positions stream is reopened lazily on first access since
+    // positions of the most documents are never requested, e.g.
+    // when a phrase is rejected by the conjunction of its terms
+    pos_in_src_ = state.pos_in;
+    pos_in_.reset();
     cookie_.file_pointer_ = state.term_state->pos_start;
-    pos_in_->seek(state.term_state->pos_start);
     freq_ = state.freq;
     features_ = state.features;
     enc_buf_ = state.enc_buf;
@@ -1352,7 +1832,9 @@ struct position_impl<IteratorTraits, false, false> {
   }
 
   void prepare(const skip_state& state) {
-    pos_in_->seek(state.pos_ptr);
+    if (pos_in_) {
+      pos_in_->seek(state.pos_ptr);
+    }
     pend_pos_ = state.pend_pos;
     buf_pos_ = postings_writer_base::BLOCK_SIZE;
     cookie_.file_pointer_ = state.pos_ptr;
@@ -1363,8 +1845,25 @@ struct position_impl<IteratorTraits, false, false> {
     if (std::numeric_limits<size_t>::max() != cookie_.file_pointer_) {
       buf_pos_ = postings_writer_base::BLOCK_SIZE;
       pend_pos_ = cookie_.pend_pos_;
-      pos_in_->seek(cookie_.file_pointer_);
+      if (pos_in_) {
+        pos_in_->seek(cookie_.file_pointer_);
+      }
+    }
+  }
+
+  // reopen positions stream at the position denoted by the cookie
+  void open() {
+    assert(pos_in_src_);
+    pos_in_ = pos_in_src_->reopen(); // reopen thread-safe stream
+
+    if (!pos_in_) {
+      // implementation returned wrong pointer
+      IR_FRMT_ERROR("Failed to reopen positions input in: %s", __FUNCTION__);
+
+      throw io_error("failed to reopen positions input");
     }
+
+    pos_in_->seek(cookie_.file_pointer_);
   }
 
   void read_attributes() { }
@@ -1420,7 +1919,8 @@ struct position_impl<IteratorTraits, false, false> {
   size_t tail_length_; // number of positions in the last (vInt encoded) pos delta block
   uint32_t buf_pos_{ postings_writer_base::BLOCK_SIZE }; // current position in pos_deltas_ buffer
   cookie cookie_;
-  index_input::ptr pos_in_;
+  const index_input* pos_in_src_{}; // source of the positions stream
+  index_input::ptr pos_in_; // nullptr until first access
   features features_;
 }; // position_impl
 
@@ -1440,20 +1940,61 @@ class position final : public irs::position,
         skip(this->pend_pos_ - freq);
         this->pend_pos_ = freq;
     }
-    while (value_ < target && this->pend_pos_) {
-      if (this->buf_pos_ == postings_writer_base::BLOCK_SIZE) {
-        refill();
-        this->buf_pos_ = 0;
-      }
-      if constexpr (IteratorTraits::one_based_position_storage()) {
-        value_ += (uint32_t)(!pos_limits::valid(value_));
+    if constexpr (IteratorTraits::offset()) {
+      // offsets are delta encoded, have to visit every position
+      while (value_ < target && this->pend_pos_) {
+        if (this->buf_pos_ == postings_writer_base::BLOCK_SIZE) {
+          refill();
+          this->buf_pos_ = 0;
+        }
+        if constexpr (IteratorTraits::one_based_position_storage()) {
+          value_ += (uint32_t)(!pos_limits::valid(value_));
+        }
+        value_ += this->pos_deltas_[this->buf_pos_];
+        assert(irs::pos_limits::valid(value_));
+        this->read_attributes();
+
+        ++this->buf_pos_;
+        --this->pend_pos_;
       }
-      value_ += this->pos_deltas_[this->buf_pos_];
-      assert(irs::pos_limits::valid(value_));
-      this->read_attributes();
+    } else {
+      // scan decoded deltas and materialize attributes
+      // of the first position not less than target only
+      while (value_ < target && this->pend_pos_) {
+        if (this->buf_pos_ == postings_writer_base::BLOCK_SIZE) {
+          refill();
+          this->buf_pos_ = 0;
+        }
+
+        const uint32_t* begin = this->pos_deltas_ + this->buf_pos_;
+        const uint32_t* end = begin + std::min(
+          postings_writer_base::BLOCK_SIZE - this->buf_pos_, this->pend_pos_);
+        const uint32_t* it = begin;
+        auto value = value_;
+
+        for (; it != end; ++it) {
+          if constexpr (IteratorTraits::one_based_position_storage()) {
+            value += (uint32_t)(!pos_limits::valid(value));
+          }
+          value += *it;
+          assert(irs::pos_limits::valid(value));
 
-      ++this->buf_pos_;
-      --this->pend_pos_;
+          if (value >= target) {
+            break;
+          }
+        }
+
+        const auto count = uint32_t(it - begin);
+        impl::skip(count);
+        this->pend_pos_ -= count;
+        value_ = value;
+
+        if (it != end) {
+          this->read_attributes();
+          ++this->buf_pos_;
+          --this->pend_pos_;
+        }
+      }
     }
     if (0 == this->pend_pos_ && value_ < target) {
       value_ = pos_limits::eof();
@@ -1513,6 +2054,10 @@ class position final : public irs::position,
 
  private:
   void refill() {
+    if (!this->pos_in_) {
+      impl::open();
+    }
+
     if (this->pos_in_->file_pointer() == this->tail_start_) {
       this->read_tail_block();
     } else {
@@ -1524,6 +2069,9 @@ class position final : public irs::position,
     auto left = postings_writer_base::BLOCK_SIZE - this->buf_pos_;
     if (count >= left) {
       count -= left;
+      if (!this->pos_in_) {
+        impl::open();
+      }
       while (count >= postings_writer_base::BLOCK_SIZE) {
         this->skip_block();
         count -= postings_writer_base::BLOCK_SIZE;
@@ -1555,6 +2103,44 @@ struct position<IteratorTraits, false> : attribute {
   void clear() { }
 }; // position
 
+///////////////////////////////////////////////////////////////////////////////
+/// @struct skip_cache
+/// @brief level 2 of a term skip-list kept in memory and shared by all
+///        iterators over the postings of the term
+///////////////////////////////////////////////////////////////////////////////
+struct skip_cache {
+  using ptr = std::shared_ptr<const skip_cache>;
+
+  skip_reader::cache_t skips;
+  std::vector<skip_state> states; // states of the level 2 skips
+}; // skip_cache
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class skip_cache_registry
+/// @brief skip caches of a segment keyed by the offset of term postings,
+///        an entry is created on the first seek over the postings and lives as
+///        long as the postings reader, i.e. memory usage is bounded by
+///        1/8192 of the number of postings having at least 3 skip levels
+///////////////////////////////////////////////////////////////////////////////
+class skip_cache_registry : private util::noncopyable {
+ public:
+  skip_cache::ptr get(uint64_t key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : it->second;
+  }
+
+  // returns an entry registered concurrently for the same key, if any
+  skip_cache::ptr emplace(uint64_t key, skip_cache::ptr&& cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.try_emplace(key, std::move(cache)).first->second;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  absl::flat_hash_map<uint64_t, skip_cache::ptr> entries_;
+}; // skip_cache_registry
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class doc_iterator
 ///////////////////////////////////////////////////////////////////////////////
@@ -1585,9 +2171,12 @@ class doc_iterator final : public irs::doc_iterator {
       const features& field,
       const term_meta& meta,
       const index_input* doc_in,
-      [[maybe_unused]] const index_input* pos_in,
-      [[maybe_unused]] const index_input* pay_in) {
+      const index_input* pos_in,
+      const index_input* pay_in,
+      int32_t version,
+      skip_cache_registry* skip_caches = nullptr) {
     features_ = field; // set field features
+    skip_caches_ = skip_caches;
 
     assert(!IteratorTraits::frequency() || IteratorTraits::frequency() == features_.freq());
     assert(!IteratorTraits::position() || IteratorTraits::position() == features_.position());
@@ -1599,6 +2188,13 @@ class doc_iterator final : public irs::doc_iterator {
 
     term_state_ = static_cast<const version10::term_meta&>(meta);
 
+    encoded_.doc_in = doc_in;
+    encoded_.pos_in = pos_in;
+    encoded_.pay_in = pay_in;
+    encoded_.term_state = &term_state_;
+    encoded_.field = features_;
+    encoded_.version = version;
+
     // init document stream
     if (term_state_.docs_count > 1) {
       if (!doc_in_) {
@@ -1653,6 +2249,10 @@ class doc_iterator final : public irs::doc_iterator {
   }
 
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<encoded_postings>::id() == type) {
+      return &encoded_;
+    }
+
     return irs::get_mutable(attrs_, type);
   }
 
@@ -1817,7 +2417,7 @@ class doc_iterator final : public irs::doc_iterator {
 
     if (left >= postings_writer_base::BLOCK_SIZE) {
       // read doc deltas
-      IteratorTraits::read_block(
+      IteratorTraits::read_doc_block(
         *doc_in_,
         enc_buf_,
         docs_);
@@ -1847,7 +2447,13 @@ class doc_iterator final : public irs::doc_iterator {
     doc_freq_ = doc_freqs_;
   }
 
+  // minimum number of skip levels in a posting list making it worth keeping
+  // the level 2 of its skip-list in memory, i.e. at least 8192 documents
+  static constexpr size_t SKIP_CACHE_MIN_LEVELS = 3;
+
   std::vector<skip_state> skip_levels_;
+  skip_cache_registry* skip_caches_{}; // shared between iterators of a segment
+  skip_cache::ptr skip_cache_; // level 2 of the term skip-list
   skip_reader skip_;
   skip_context* skip_ctx_; // pointer to used skip context, will be used by skip reader
   uint32_t enc_buf_[postings_writer_base::BLOCK_SIZE]; // buffer for encoding
@@ -1861,6 +2467,7 @@ class doc_iterator final : public irs::doc_iterator {
   index_input::ptr doc_in_;
   version10::term_meta term_state_;
   features features_; // field features
+  encoded_postings encoded_;
   attributes attrs_;
 }; // doc_iterator
 
@@ -1918,6 +2525,38 @@ void doc_iterator<IteratorTraits>::seek_to_block(doc_id_t target) {
         top.doc_ptr = term_state_.doc_start;
         top.pos_ptr = term_state_.pos_start;
         top.pay_ptr = term_state_.pay_start;
+
+        if (skip_caches_ && num_levels >= SKIP_CACHE_MIN_LEVELS) {
+          // long posting list, take the level 2 from the cache shared by
+          // iterators of the term, levels 2, 1 and 0 are then read from the
+          // beginning rather than from the parent skip
+          skip_levels_[2] = skip_levels_[1] = skip_levels_[0] = top;
+
+          skip_cache_ = skip_caches_->get(term_state_.doc_start);
+
+          if (!skip_cache_) {
+            auto cache = std::make_shared<skip_cache>();
+
+            skip_.load_cache(cache->skips, [this, &cache](size_t skip) {
+              assert(skip == cache->states.size());
+              UNUSED(skip);
+              cache->states.emplace_back(skip_levels_[2]);
+              // loaded skip doesn't precede a target
+              skip_ctx_->level = 0;
+            });
+
+            skip_cache_ = skip_caches_->emplace(
+              term_state_.doc_start, std::move(cache));
+          }
+
+          skip_.cache(
+            skip_cache_->skips,
+            [this](size_t skip) {
+              assert(skip < skip_cache_->states.size());
+              static_cast<skip_state&>(*skip_ctx_) = skip_cache_->states[skip];
+              skip_ctx_->level = 2;
+          });
+        }
       }
     }
 
@@ -2368,7 +3007,18 @@ class document_mask_writer final: public irs::document_mask_writer {
   static constexpr string_ref FORMAT_EXT = "doc_mask";
 
   static constexpr int32_t FORMAT_MIN = 0;
-  static constexpr int32_t FORMAT_MAX = FORMAT_MIN;
+  static constexpr int32_t FORMAT_ENCODED = 1; // sparse/dense encoding
+  static constexpr int32_t FORMAT_MAX = FORMAT_ENCODED;
+
+  enum class encoding : byte_type {
+    SPARSE = 0, // delta encoded sorted document ids
+    DENSE = 1 // bitset of masked documents
+  };
+
+  explicit document_mask_writer(int32_t version) noexcept
+    : version_(version) {
+    assert(version_ >= FORMAT_MIN && version <= FORMAT_MAX);
+  }
 
   virtual ~document_mask_writer() = default;
 
@@ -2377,6 +3027,9 @@ class document_mask_writer final: public irs::document_mask_writer {
   virtual void write(directory& dir,
                      const segment_meta& meta,
                      const document_mask& docs_mask) override;
+
+ private:
+  int32_t version_;
 }; // document_mask_writer
 
 template<>
@@ -2405,11 +3058,51 @@ void document_mask_writer::write(
   assert(docs_mask.size() <= std::numeric_limits<uint32_t>::max());
   const auto count = static_cast<uint32_t>(docs_mask.size());
 
-  format_utils::write_header(*out, FORMAT_NAME, FORMAT_MAX);
+  format_utils::write_header(*out, FORMAT_NAME, version_);
   out->write_vint(count);
 
-  for (auto mask : docs_mask) {
-    out->write_vint(mask);
+  if (version_ < FORMAT_ENCODED) {
+    for (auto mask : docs_mask) {
+      out->write_vint(mask);
+    }
+
+    format_utils::write_footer(*out);
+    return;
+  }
+
+  std::vector<doc_id_t> docs(docs_mask.begin(), docs_mask.end());
+  std::sort(docs.begin(), docs.end());
+
+  // choose the most compact encoding
+  uint64_t sparse_size = 0;
+  doc_id_t prev = 0;
+  for (const auto doc : docs) {
+    sparse_size += bytes_io<uint32_t>::vsize(doc - prev);
+    prev = doc;
+  }
+
+  const size_t words = docs.empty()
+    ? 0
+    : bitset::bits_to_words(size_t(docs.back()) + 1);
+
+  if (words*sizeof(bitset::word_t) < sparse_size) {
+    bitset mask(size_t(docs.back()) + 1);
+    for (const auto doc : docs) {
+      mask.set(doc);
+    }
+
+    out->write_byte(static_cast<byte_type>(encoding::DENSE));
+    out->write_vint(static_cast<uint32_t>(words));
+    for (const auto word : mask) {
+      out->write_long(word);
+    }
+  } else {
+    out->write_byte(static_cast<byte_type>(encoding::SPARSE));
+    prev = 0;
+    for (const auto doc : docs) {
+      out->write_vint(doc - prev);
+      prev = doc;
+    }
   }
 
   format_utils::write_footer(*out);
@@ -2427,13 +3120,28 @@ class document_mask_reader final: public irs::document_mask_reader {
     const directory& dir,
     const segment_meta& meta,
     document_mask& docs_mask) override;
+
+  virtual bool read(
+    const directory& dir,
+    const segment_meta& meta,
+    bitset& dense,
+    std::vector<doc_id_t>& sparse) override;
+
+ private:
+  // calls 'visitor(in, count, version, encoding)' for the stream of the
+  // document mask positioned right after the encoding type
+  template<typename Visitor>
+  static bool read(
+    const directory& dir,
+    const segment_meta& meta,
+    Visitor&& visitor);
 }; // document_mask_reader
 
-bool document_mask_reader::read(
+template<typename Visitor>
+/*static*/ bool document_mask_reader::read(
     const directory& dir,
     const segment_meta& meta,
-    document_mask& docs_mask
-) {
+    Visitor&& visitor) {
   const auto in_name = file_name<irs::document_mask_writer>(meta);
 
   bool exists;
@@ -2460,21 +3168,40 @@ bool document_mask_reader::read(
 
   const auto checksum = format_utils::checksum(*in);
 
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *in,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX);
 
-  size_t count = in->read_vint();
-  docs_mask.reserve(count);
+  const size_t count = in->read_vint();
 
-  while (count--) {
-    static_assert(
-      sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
-      "sizeof(doc_id) != sizeof(decltype(id))");
+  static_assert(
+    sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
+    "sizeof(doc_id) != sizeof(decltype(id))");
+
+  // unordered documents
+  auto type = document_mask_writer::encoding::SPARSE;
+
+  if (version >= document_mask_writer::FORMAT_ENCODED) {
+    type = static_cast<document_mask_writer::encoding>(in->read_byte());
 
-    docs_mask.insert(in->read_vint());
+    switch (type) {
+      case document_mask_writer::encoding::SPARSE:
+      case document_mask_writer::encoding::DENSE:
+        break;
+      default:
+        throw index_error(string_utils::to_string(
+          "unknown document mask encoding '%d', path: %s",
+          static_cast<int>(type), in_name.c_str()));
+    }
+  }
+
+  if (const size_t actual = visitor(*in, count, version, type);
+      actual != count) {
+    throw index_error(string_utils::to_string(
+      "invalid document mask, expected '" IR_SIZE_T_SPECIFIER "' documents, got '" IR_SIZE_T_SPECIFIER "', path: %s",
+      count, actual, in_name.c_str()));
   }
 
   format_utils::check_footer(*in, checksum);
@@ -2482,6 +3209,92 @@ bool document_mask_reader::read(
   return true;
 }
 
+bool document_mask_reader::read(
+    const directory& dir,
+    const segment_meta& meta,
+    document_mask& docs_mask) {
+  return read(dir, meta, [&docs_mask](
+      index_input& in, size_t count, int32_t version,
+      document_mask_writer::encoding type) {
+    docs_mask.reserve(count);
+
+    if (version < document_mask_writer::FORMAT_ENCODED) {
+      while (count--) {
+        docs_mask.insert(in.read_vint());
+      }
+    } else if (document_mask_writer::encoding::SPARSE == type) {
+      doc_id_t doc = 0;
+      while (count--) {
+        doc += in.read_vint();
+        docs_mask.insert(doc);
+      }
+    } else {
+      const size_t words = in.read_vint();
+      for (size_t i = 0; i < words; ++i) {
+        auto word = static_cast<bitset::word_t>(in.read_long());
+        const auto base = bitset::bit_offset(i);
+
+        for (; word; word &= word - 1) {
+          docs_mask.insert(doc_id_t(base + math::math_traits<bitset::word_t>::ctz(word)));
+        }
+      }
+    }
+
+    return docs_mask.size();
+  });
+}
+
+bool document_mask_reader::read(
+    const directory& dir,
+    const segment_meta& meta,
+    bitset& dense,
+    std::vector<doc_id_t>& sparse) {
+  dense.reset(0);
+  sparse.clear();
+
+  return read(dir, meta, [&dense, &sparse, &meta](
+      index_input& in, size_t count, int32_t version,
+      document_mask_writer::encoding type) {
+    if (document_mask_writer::encoding::DENSE == type) {
+      const size_t words = in.read_vint();
+
+      // bits past the last document of a segment are never set
+      dense.reset(std::min(
+        bitset::bit_offset(words),
+        size_t(doc_limits::min() + meta.docs_count)));
+
+      if (dense.words() != words) {
+        return size_t(0); // document mask doesn't match the segment
+      }
+
+      auto* word = dense.data();
+      for (auto* end = word + words; word != end; ++word) {
+        *word = static_cast<bitset::word_t>(in.read_long());
+      }
+
+      return size_t(dense.count());
+    }
+
+    sparse.reserve(count);
+
+    if (version < document_mask_writer::FORMAT_ENCODED) {
+      for (size_t i = 0; i < count; ++i) {
+        sparse.emplace_back(in.read_vint());
+      }
+
+      std::sort(sparse.begin(), sparse.end());
+    } else {
+      doc_id_t doc = 0;
+      for (size_t i = 0; i < count; ++i) {
+        doc += in.read_vint();
+        sparse.emplace_back(doc);
+      }
+    }
+
+    return sparse.size();
+  });
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                      columnstore
 // ----------------------------------------------------------------------------
@@ -2721,7 +3534,8 @@ enum ColumnProperty : uint32_t {
   CP_FIXED = 1 << 1,           // fixed length colums
   CP_MASK = 1 << 2,            // column contains no data
   CP_COLUMN_DENSE = 1 << 3,    // column index is dense
-  CP_COLUMN_ENCRYPT = 1 << 4   // column contains encrypted data
+  CP_COLUMN_ENCRYPT = 1 << 4,  // column contains encrypted data
+  CP_COLUMN_COMPRESSION_DATA = 1 << 5 // column header contains compression dependent data
 }; // ColumnProperty
 
 ENABLE_BITMASK_ENUM(ColumnProperty);
@@ -2966,13 +3780,32 @@ class index_block {
   uint32_t flushed_{}; // number of flushed items
 }; // index_block
 
+class column;
+class context_provider;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct encoded_column
+/// @brief exposed by column iterators, provides access to encoded data blocks
+///        of the column
+//////////////////////////////////////////////////////////////////////////////
+struct encoded_column final : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "encoded_column";
+  }
+
+  const context_provider* ctxs{};
+  const columns::column* column{};
+}; // encoded_column
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class writer
 //////////////////////////////////////////////////////////////////////////////
 class writer final : public irs::columnstore_writer {
  public:
   static constexpr int32_t FORMAT_MIN = 0;
-  static constexpr int32_t FORMAT_MAX = 1;
+  static constexpr int32_t FORMAT_ENCRYPTION = 1; // encryption and custom compression
+  static constexpr int32_t FORMAT_COMPRESSION_DATA = 2; // optional compression dependent data
+  static constexpr int32_t FORMAT_MAX = FORMAT_COMPRESSION_DATA;
 
   static constexpr string_ref FORMAT_NAME = "iresearch_10_columnstore";
   static constexpr string_ref FORMAT_EXT = "cs";
@@ -2991,6 +3824,7 @@ class writer final : public irs::columnstore_writer {
   virtual column_t push_column(const column_info& info) override;
   virtual bool commit() override;
   virtual void rollback() noexcept override;
+  virtual bool copy(field_id id, const attribute_provider& src, doc_id_t doc_base) override;
 
  private:
   class column final : public irs::columnstore_writer::column_output {
@@ -3037,8 +3871,20 @@ class writer final : public irs::columnstore_writer {
       if (0 != (column_props_ & CP_DENSE)) { column_props |= CP_COLUMN_DENSE; }
       if (cipher_) { column_props |= CP_COLUMN_ENCRYPT; }
 
+      // collect compression dependent data, if any
+      auto& comp_data = ctx_->comp_data_;
+      comp_data.clear();
+      if (ctx_->version_ >= FORMAT_COMPRESSION_DATA) {
+        bytes_output comp_out(comp_data);
+        comp_->flush(comp_out);
+        if (!comp_data.empty()) { column_props |= CP_COLUMN_COMPRESSION_DATA; }
+      }
+
       write_enum(out, column_props);
-      if (ctx_->version_ > FORMAT_MIN) {
+      if (ctx_->version_ >= FORMAT_COMPRESSION_DATA) {
+        write_string(out, comp_type_.name());
+        out.write_bytes(comp_data.c_str(), comp_data.size());
+      } else if (ctx_->version_ > FORMAT_MIN) {
         write_string(out, comp_type_.name());
         comp_->flush(out); // flush compression dependent data
       }
@@ -3092,6 +3938,9 @@ class writer final : public irs::columnstore_writer {
       block_index_.pop_back();
     }
 
+    // appends encoded data blocks of the specified column
+    bool copy(const encoded_column& src, doc_id_t doc_base);
+
    private:
     void flush_block() {
       if (block_index_.empty()) {
@@ -3099,18 +3948,28 @@ class writer final : public irs::columnstore_writer {
         return;
       }
 
-      // refresh column properties
-      // column is dense IFF
-      // - all blocks are dense
-      // - there are no gaps between blocks
-      // - all data blocks have the same length
-      column_props_ &= ColumnProperty{
-        1 == (block_index_.min_key() - max_) &&
-        (!doc_limits::valid(max_) || prev_block_size_ == block_buf_.size())
-      };
+      auto& out = *ctx_->data_out_;
+      auto* buf = reinterpret_cast<uint64_t*>(&ctx_->buf_[0]);
 
-      // update max element
-      max_ = block_index_.max_key();
+      // write block index, compressed data and aggregate block properties
+      // note that order of calls is important here, since it is not defined
+      // which expression should be evaluated first in the following example:
+      //   const auto res = expr0() | expr1();
+      // otherwise it would violate format layout
+      const auto keys = begin_block();
+      auto block_props = block_index_.flush(out, buf);
+      block_props |= write_compact(out, ctx_->buf_, cipher_, *comp_, block_buf_);
+
+      end_block(keys, block_props, block_buf_.size());
+
+      // reset buffer stream after flush
+      block_buf_.clear();
+    }
+
+    // registers current block in the column index and writes its header,
+    // returns min and max keys of the block
+    std::pair<doc_id_t, doc_id_t> begin_block() {
+      assert(!block_index_.empty());
 
       auto& out = *ctx_->data_out_;
 
@@ -3124,26 +3983,36 @@ class writer final : public irs::columnstore_writer {
         column_index_.flush(blocks_index_.stream, buf);
       }
 
-      // flush current block
-
       // write total number of elements in the block
       out.write_vint(block_index_.size());
 
-      // write block index, compressed data and aggregate block properties
-      // note that order of calls is important here, since it is not defined
-      // which expression should be evaluated first in the following example:
-      //   const auto res = expr0() | expr1();
-      // otherwise it would violate format layout
-      auto block_props = block_index_.flush(out, buf);
-      block_props |= write_compact(out, ctx_->buf_, cipher_, *comp_, block_buf_);
+      return { block_index_.min_key(), block_index_.max_key() };
+    }
 
-      prev_block_size_ = block_buf_.size();
+    // refreshes column properties using the flushed block,
+    // 'size' denotes size of the uncompressed block data
+    void end_block(
+        const std::pair<doc_id_t, doc_id_t>& keys,
+        ColumnProperty block_props,
+        uint64_t size) {
+      // refresh column properties
+      // column is dense IFF
+      // - all blocks are dense
+      // - there are no gaps between blocks
+      // - all data blocks have the same length
+      column_props_ &= ColumnProperty{
+        1 == (keys.first - max_) &&
+        (!doc_limits::valid(max_) || prev_block_size_ == size)
+      };
+
+      // update max element
+      max_ = keys.second;
+
+      prev_block_size_ = size;
       length_ += prev_block_size_;
 
       // refresh blocks properties
       blocks_props_ &= block_props;
-      // reset buffer stream after flush
-      block_buf_.clear();
 
       // refresh column properties
       // column is dense IFF
@@ -3173,6 +4042,7 @@ class writer final : public irs::columnstore_writer {
   memory_allocator* alloc_{ &memory_allocator::global() };
   std::deque<column> columns_; // pointers remain valid
   bstring buf_; // reusable temporary buffer for packing/compression
+  bstring comp_data_; // reusable buffer for compression dependent data
   index_output::ptr data_out_;
   std::string filename_;
   directory* dir_;
@@ -3226,6 +4096,13 @@ columnstore_writer::column_t writer::push_column(const column_info& info) {
   if (version_ > FORMAT_MIN) {
     compression = info.compression();
     cipher = info.encryption() ? data_out_cipher_.get() : nullptr;
+
+    if (version_ < FORMAT_COMPRESSION_DATA
+        && compression == irs::type<compression::zstd>::get()) {
+      // zstd omits compression dependent data for self-contained blocks,
+      // while readers of older versions always expect it to be present
+      compression = type<compression::lz4>::get();
+    }
   } else {
     // we don't support encryption and custom
     // compression for 'FORMAT_MIN' version
@@ -3233,14 +4110,21 @@ columnstore_writer::column_t writer::push_column(const column_info& info) {
     cipher = nullptr;
   }
 
-  auto compressor = compression::get_compressor(compression, info.options());
+  auto options = info.options();
+
+  if (cipher) {
+    // trained dictionaries are stored unencrypted along with column metadata
+    options.dictionary = false;
+  }
+
+  auto compressor = compression::get_compressor(compression, options);
 
   if (!compressor) {
     compressor = noop_compressor::make();
   }
 
   const auto id = columns_.size();
-  columns_.emplace_back(*this, info.compression(), compressor, cipher);
+  columns_.emplace_back(*this, compression, compressor, cipher);
   auto& column = columns_.back();
 
   return std::make_pair(id, [&column] (doc_id_t doc) -> column_output& {
@@ -3302,35 +4186,6 @@ void writer::rollback() noexcept {
   columns_.clear(); // ensure next flush (without prepare(...)) will use the section without 'data_out_'
 }
 
-template<typename Block, typename Allocator>
-class block_cache : irs::util::noncopyable {
- public:
-  explicit block_cache(const Allocator& alloc = Allocator())
-    : cache_(alloc) {
-  }
-  block_cache(block_cache&&) = default;
-
-  template<typename... Args>
-  Block& emplace_back(Args&&... args) {
-    cache_.emplace_back(std::forward<Args>(args)...);
-    return cache_.back();
-  }
-
-  void pop_back() noexcept {
-    cache_.pop_back();
-  }
-
- private:
-  std::deque<Block, Allocator> cache_; // pointers remain valid
-}; // block_cache
-
-template<typename Block, typename Allocator>
-struct block_cache_traits {
-  typedef Block block_t;
-  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<block_t> allocator_t;
-  typedef block_cache<Block, allocator_t> cache_t;
-};
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            Blocks
 // -----------------------------------------------------------------------------
@@ -3476,6 +4331,11 @@ class sparse_block : util::noncopyable {
     return true;
   }
 
+  // amount of memory consumed by the block
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
   bool visit(const columnstore_reader::values_reader_f& visitor) const {
     bytes_ref value;
 
@@ -3650,6 +4510,10 @@ class dense_block : util::noncopyable {
     return true;
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
   bool visit(const columnstore_reader::values_reader_f& visitor) const {
     bytes_ref value;
 
@@ -3822,6 +4686,10 @@ class dense_fixed_offset_block : util::noncopyable {
     return true;
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
   bool visit(const columnstore_reader::values_reader_f& visitor) const {
     assert(size_);
 
@@ -3947,6 +4815,10 @@ class sparse_mask_block : util::noncopyable {
     return !(std::end(keys_) == it || *it > key);
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
   bool visit(const columnstore_reader::values_reader_f& reader) const {
     for (auto begin = std::begin(keys_), end = begin + size_; begin != end; ++begin) {
       if (!reader(*begin, DUMMY)) {
@@ -4060,6 +4932,10 @@ class dense_mask_block {
     return min_ <= key && key < max_;
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
   bool visit(const columnstore_reader::values_reader_f& visitor) const {
     for (auto doc = min_; doc < max_; ++doc) {
       if (!visitor(doc, DUMMY)) {
@@ -4075,13 +4951,7 @@ class dense_mask_block {
   doc_id_t max_;
 }; // dense_mask_block
 
-template<typename Allocator = std::allocator<sparse_block>>
-class read_context
-  : public block_cache_traits<sparse_block, Allocator>::cache_t,
-    public block_cache_traits<dense_block, Allocator>::cache_t,
-    public block_cache_traits<dense_fixed_offset_block, Allocator>::cache_t,
-    public block_cache_traits<sparse_mask_block, Allocator>::cache_t,
-    public block_cache_traits<dense_mask_block, Allocator>::cache_t {
+class read_context : private util::noncopyable {
  public:
   using ptr = std::shared_ptr<read_context>;
 
@@ -4098,63 +4968,34 @@ class read_context
     return memory::make_shared<read_context>(std::move(clone), cipher);
   }
 
-  read_context(
-      index_input::ptr&& in,
-      encryption::stream* cipher,
-      const Allocator& alloc = Allocator())
-    : block_cache_traits<sparse_block, Allocator>::cache_t(typename block_cache_traits<sparse_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_block, Allocator>::cache_t(typename block_cache_traits<dense_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_fixed_offset_block, Allocator>::cache_t(typename block_cache_traits<dense_fixed_offset_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<sparse_mask_block, Allocator>::cache_t(typename block_cache_traits<sparse_mask_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_mask_block, Allocator>::cache_t(typename block_cache_traits<dense_mask_block, Allocator>::allocator_t(alloc)),
-      buf_(INDEX_BLOCK_SIZE*sizeof(uint32_t), 0),
+  read_context(index_input::ptr&& in, encryption::stream* cipher)
+    : buf_(INDEX_BLOCK_SIZE*sizeof(uint32_t), 0),
       stream_(std::move(in)),
       cipher_(cipher) {
   }
 
-  template<typename Block, typename... Args>
-  Block& emplace_back(uint64_t offset, compression::decompressor* decomp, bool decrypt, Args&&... args) {
-    typename block_cache_traits<Block, Allocator>::cache_t& cache = *this;
-
-    // add cache entry
-    auto& block = cache.emplace_back(std::forward<Args>(args)...);
-
-    try {
-      load(block, decomp, decrypt, offset);
-    } catch (...) {
-      // failed to load block
-      pop_back<Block>();
-
-      throw;
-    }
-
-    return block;
-  }
-
   template<typename Block>
   void load(Block& block, compression::decompressor* decomp, bool decrypt, uint64_t offset) {
     stream_->seek(offset); // seek to the offset
     block.load(*stream_, decomp, decrypt ? cipher_ : nullptr, buf_);
   }
 
-  template<typename Block>
-  void pop_back() noexcept {
-    typename block_cache_traits<Block, Allocator>::cache_t& cache = *this;
-    cache.pop_back();
-  }
-
  private:
   bstring buf_; // temporary buffer for decoding/unpacking
   index_input::ptr stream_;
   encryption::stream* cipher_; // options cipher stream
 }; // read_context
 
-typedef read_context<> read_context_t;
-
 class context_provider: private util::noncopyable {
  public:
   explicit context_provider(size_t max_pool_size)
-    : pool_(std::max(size_t(1), max_pool_size)) {
+    : pool_(std::max(size_t(1), max_pool_size)),
+      id_(columnstore_cache::next_id()) {
+  }
+
+  ~context_provider() {
+    // blocks of the columnstore are not accessible anymore
+    columnstore_cache::global().erase(id_);
   }
 
   void prepare(index_input::ptr&& stream, encryption::stream::ptr&& cipher) noexcept {
@@ -4164,67 +5005,110 @@ class context_provider: private util::noncopyable {
     cipher_ = std::move(cipher);
   }
 
-  bounded_object_pool<read_context_t>::ptr get_context() const {
+  bounded_object_pool<read_context>::ptr get_context() const {
     return pool_.emplace(*stream_, cipher_.get());
   }
 
+  const index_input& stream() const noexcept {
+    assert(stream_);
+    return *stream_;
+  }
+
+  encryption::stream* cipher() const noexcept {
+    return cipher_.get();
+  }
+
+  // identifies blocks of the columnstore in 'columnstore_cache'
+  uint64_t id() const noexcept {
+    return id_;
+  }
+
  private:
-  mutable bounded_object_pool<read_context_t> pool_;
+  mutable bounded_object_pool<read_context> pool_;
   encryption::stream::ptr cipher_;
   index_input::ptr stream_;
+  uint64_t id_;
 }; // context_provider
 
-// in case of success caches block pointed
-// instance, nullptr otherwise
-template<typename BlockRef>
-const typename BlockRef::block_t& load_block(
+// block used by a column reader or an iterator, keeps the block alive
+// and values returned from it valid even if the block gets evicted
+// from 'columnstore_cache'
+template<typename Block>
+struct block_pin {
+  std::shared_ptr<const Block> block;
+  uint64_t offset{ type_limits<type_t::address_t>::invalid() };
+}; // block_pin
+
+// returns block located at the specified 'offset', the block is
+// either taken from or put into 'columnstore_cache'
+template<typename Block>
+std::shared_ptr<const Block> load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
-    BlockRef& ref) {
-  typedef typename BlockRef::block_t block_t;
-
-  const auto* cached = ref.pblock.load();
+    uint64_t offset) {
+  auto& cache = columnstore_cache::global();
+  auto cached = cache.get(ctxs.id(), offset);
 
   if (!cached) {
-    auto ctx = ctxs.get_context();
-    assert(ctx);
+    auto block = memory::make_shared<Block>();
 
-    // load block
-    const auto& block = ctx->template emplace_back<block_t>(ref.offset, decomp, decrypt);
+    {
+      auto ctx = ctxs.get_context();
+      assert(ctx);
 
-    // mark block as loaded
-    if (ref.pblock.compare_exchange_strong(cached, &block)) {
-      cached = &block;
-    } else {
-      // already cached by another thread
-      ctx->template pop_back<block_t>();
+      ctx->load(*block, decomp, decrypt, offset);
     }
+
+    const auto memory = block->memory();
+
+    // may return a block loaded concurrently by another thread
+    cached = cache.put(ctxs.id(), offset, std::move(block), memory);
   }
 
-  return *cached;
+  return std::static_pointer_cast<const Block>(cached);
 }
 
-// in case of success caches block pointed
-// by 'ref' in the specified 'block' and
-// retuns a pointer to cached instance,
-// nullptr otherwise
-template<typename BlockRef>
-const typename BlockRef::block_t& load_block(
+// returns block located at the specified 'offset' and
+// pins it in the specified 'pin', reuses pinned block
+// if possible
+template<typename Block>
+const Block& load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
-    const BlockRef& ref,
-    typename BlockRef::block_t& block) {
-  const auto* cached = ref.pblock.load();
+    uint64_t offset,
+    block_pin<Block>& pin) {
+  if (pin.offset != offset) {
+    pin.block = load_block<Block>(ctxs, decomp, decrypt, offset);
+    pin.offset = offset;
+  }
+
+  assert(pin.block);
+  return *pin.block;
+}
+
+// returns block located at the specified 'offset' if it's
+// cached, otherwise loads the block into the specified
+// 'block' without caching it
+template<typename Block>
+const Block& load_block(
+    const context_provider& ctxs,
+    compression::decompressor* decomp,
+    bool decrypt,
+    uint64_t offset,
+    Block& block,
+    std::shared_ptr<const Block>& cached) {
+  cached = std::static_pointer_cast<const Block>(
+    columnstore_cache::global().get(ctxs.id(), offset));
 
   if (!cached) {
     auto ctx = ctxs.get_context();
     assert(ctx);
 
-    ctx->load(block, decomp, decrypt, ref.offset);
+    ctx->load(block, decomp, decrypt, offset);
 
-    cached = &block;
+    return block;
   }
 
   return *cached;
@@ -4266,12 +5150,24 @@ class column
   ColumnProperty props() const noexcept { return props_; }
   compression::decompressor* decompressor() const noexcept { return decomp_.get(); }
 
+  // name of the compression used for data blocks, empty if blocks
+  // can't be decompressed without column specific compression data
+  const std::string& compression() const noexcept { return compression_; }
+  void compression(std::string&& name) noexcept { compression_ = std::move(name); }
+
+  // visits offsets of all data blocks of the column in ascending key order
+  // returns false if the column doesn't support access to its data blocks
+  virtual bool visit_blocks(const std::function<bool(uint64_t)>& /*visitor*/) const {
+    return false;
+  }
+
  protected:
   // same as size() but returns uint32_t to avoid type convertions
   uint32_t count() const noexcept { return count_; }
 
  private:
   compression::decompressor::ptr decomp_;
+  std::string compression_;
   doc_id_t max_{ doc_limits::eof() };
   uint32_t count_{};
   uint32_t avg_block_size_{};
@@ -4300,9 +5196,15 @@ class column_iterator final : public irs::doc_iterator {
       end_(end),
       column_(&column) {
     std::get<cost>(attrs_).reset(column.size());
+    encoded_.ctxs = column.ctxs_;
+    encoded_.column = &column;
   }
 
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<encoded_column>::id() == type) {
+      return &encoded_;
+    }
+
     return irs::get_mutable(attrs_, type);
   }
 
@@ -4356,7 +5258,7 @@ class column_iterator final : public irs::doc_iterator {
     }
 
     try {
-      const auto& cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(), *begin_);
+      const auto& cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(), begin_->offset, pin_);
 
       if (block_ != cached) {
         block_.reset(cached, payload);
@@ -4377,7 +5279,9 @@ class column_iterator final : public irs::doc_iterator {
   }
 
   block_iterator_t block_;
+  block_pin<block_t> pin_;
   attributes attrs_;
+  encoded_column encoded_;
   const typename column_t::block_ref* begin_;
   const typename column_t::block_ref* seek_origin_;
   const typename column_t::block_ref* end_;
@@ -4388,14 +5292,18 @@ class column_iterator final : public irs::doc_iterator {
 // --SECTION--                                                           Columns
 // -----------------------------------------------------------------------------
 
+// returned reader pins the block it has read the last value from, i.e. the
+// value stays valid until the next call even if the block gets evicted
+// from 'columnstore_cache', see 'column_reader::values()'
 template<typename Column>
 columnstore_reader::values_reader_f column_values(const Column& column) {
-if (column.empty()) {
+  if (column.empty()) {
     return columnstore_reader::empty_reader();
   }
 
-  return [&column](doc_id_t key, bytes_ref& value) {
-    return column.value(key, value);
+  return [&column, pin = block_pin<typename Column::block_t>()](
+      doc_id_t key, bytes_ref& value) mutable {
+    return column.value(key, value, pin);
   };
 }
 
@@ -4473,7 +5381,7 @@ class sparse_column final : public column {
     refs_ = std::move(refs);
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(doc_id_t key, bytes_ref& value, block_pin<block_t>& pin) const {
     // find the right block
     const auto rbegin = refs_.rbegin(); // upper bound
     const auto rend = refs_.rend();
@@ -4487,16 +5395,26 @@ class sparse_column final : public column {
       return false;
     }
 
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *it);
+    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), it->offset, pin);
 
     return cached.value(key, value);
   }
 
+  virtual bool visit_blocks(const std::function<bool(uint64_t)>& visitor) const override {
+    for (auto begin = refs_.begin(), end = refs_.end()-1; begin != end; ++begin) { // -1 for upper bound
+      if (!visitor(begin->offset)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   virtual bool visit(
       const columnstore_reader::values_visitor_f& visitor) const override {
     block_t block; // don't cache new blocks
+    std::shared_ptr<const block_t> pinned;
     for (auto begin = refs_.begin(), end = refs_.end()-1; begin != end; ++begin) { // -1 for upper bound
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block);
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), begin->offset, block, pinned);
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4525,19 +5443,9 @@ class sparse_column final : public column {
  private:
   friend class column_iterator<column_t>;
 
-  struct block_ref : util::noncopyable {
-    typedef typename column_t::block_t block_t;
-
-    block_ref() = default;
-
-    block_ref(block_ref&& other) noexcept
-      : key(std::move(other.key)), offset(std::move(other.offset)) {
-      pblock = other.pblock.exchange(nullptr); // no std::move(...) for std::atomic<...>
-    }
-
+  struct block_ref {
     doc_id_t key; // min key in a block
     uint64_t offset; // block offset
-    mutable std::atomic<const block_t*> pblock; // pointer to cached block
   }; // block_ref
 
   typedef std::vector<block_ref> refs_t;
@@ -4656,7 +5564,7 @@ class dense_fixed_offset_column final : public column {
     min_ = this->max() - this->count() + 1;
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(doc_id_t key, bytes_ref& value, block_pin<block_t>& pin) const {
     const auto base_key = key - min_;
 
     if (base_key >= this->count()) {
@@ -4666,17 +5574,25 @@ class dense_fixed_offset_column final : public column {
     const auto block_idx = base_key / this->avg_block_count();
     assert(block_idx < refs_.size());
 
-    auto& ref = const_cast<block_ref&>(refs_[block_idx]);
-
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref);
+    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), refs_[block_idx].offset, pin);
 
     return cached.value(key, value);
   }
 
+  virtual bool visit_blocks(const std::function<bool(uint64_t)>& visitor) const override {
+    for (auto& ref : refs_) {
+      if (!visitor(ref.offset)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   virtual bool visit(const columnstore_reader::values_visitor_f& visitor) const override {
     block_t block; // don't cache new blocks
+    std::shared_ptr<const block_t> pinned;
     for (auto& ref : refs_) {
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref, block);
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref.offset, block, pinned);
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4707,17 +5623,7 @@ class dense_fixed_offset_column final : public column {
   friend class column_iterator<column_t>;
 
   struct block_ref {
-    typedef typename column_t::block_t block_t;
-
-    block_ref() = default;
-
-    block_ref(block_ref&& other) noexcept
-      : offset(std::move(other.offset)) {
-      pblock = other.pblock.exchange(nullptr); // no std::move(...) for std::atomic<...>
-    }
-
     uint64_t offset; // need to store base offset since blocks may not be located sequentially
-    mutable std::atomic<const block_t*> pblock;
   }; // block_ref
 
   typedef std::vector<block_ref> refs_t;
@@ -4838,7 +5744,13 @@ class dense_fixed_offset_column<dense_mask_block> final : public column {
   virtual irs::doc_iterator::ptr iterator() const override;
 
   virtual columnstore_reader::values_reader_f values() const override {
-    return column_values<column_t>(*this);
+    if (empty()) {
+      return columnstore_reader::empty_reader();
+    }
+
+    return [this](doc_id_t key, bytes_ref& value) {
+      return this->value(key, value);
+    };
   }
 
  private:
@@ -5018,7 +5930,7 @@ bool reader::prepare(const directory& dir, const segment_meta& meta) {
   for (size_t i = 0, size = columns.capacity(); i < size; ++i) {
     // read column properties
     const auto props = read_enum<ColumnProperty>(*stream);
-    const auto factory_id = (props & (~CP_COLUMN_ENCRYPT));
+    const auto factory_id = (props & (~(CP_COLUMN_ENCRYPT | CP_COLUMN_COMPRESSION_DATA)));
 
     if (factory_id >= IRESEARCH_COUNTOF(COLUMN_FACTORIES)) {
       throw index_error(string_utils::to_string(
@@ -5049,7 +5961,7 @@ bool reader::prepare(const directory& dir, const segment_meta& meta) {
     compression::decompressor::ptr decomp;
 
     if (version > writer::FORMAT_MIN) {
-      const auto compression_id = read_string<std::string>(*stream);
+      auto compression_id = read_string<std::string>(*stream);
       decomp = compression::get_decompressor(compression_id);
 
       if (!decomp && !compression::exists(compression_id)) {
@@ -5058,16 +5970,36 @@ bool reader::prepare(const directory& dir, const segment_meta& meta) {
           compression_id.c_str(), i));
       }
 
-      if (decomp && !decomp->prepare(*stream)) {
-        throw index_error(string_utils::to_string(
-          "Failed to prepare compression '%s' for column id=" IR_SIZE_T_SPECIFIER,
-          compression_id.c_str(), i));
+      if (version >= writer::FORMAT_COMPRESSION_DATA) {
+        if (0 == (props & CP_COLUMN_COMPRESSION_DATA)) {
+          // data blocks are self-contained
+          column->compression(std::move(compression_id));
+        } else if (!decomp || !decomp->prepare(*stream)) {
+          throw index_error(string_utils::to_string(
+            "Failed to prepare compression '%s' for column id=" IR_SIZE_T_SPECIFIER,
+            compression_id.c_str(), i));
+        }
+      } else {
+        // compression dependent data is always present, possibly empty
+        const auto compression_data_ptr = stream->file_pointer();
+
+        if (decomp && !decomp->prepare(*stream)) {
+          throw index_error(string_utils::to_string(
+            "Failed to prepare compression '%s' for column id=" IR_SIZE_T_SPECIFIER,
+            compression_id.c_str(), i));
+        }
+
+        if (compression_data_ptr == stream->file_pointer()) {
+          // data blocks are self-contained
+          column->compression(std::move(compression_id));
+        }
       }
     } else {
       // we don't support encryption and custom
       // compression for 'FORMAT_MIN' version
       decomp = compression::get_decompressor(type<compression::lz4>::get());
       assert(decomp);
+      column->compression(static_cast<std::string>(type<compression::lz4>::get().name()));
     }
 
     try {
@@ -5095,6 +6027,142 @@ const reader::column_reader* reader::column(field_id field) const {
     : columns_[field].get();
 }
 
+// copies data of a block written by 'write_compact' as is, re-encrypting it
+// if necessary, returns size of the uncompressed data and block properties
+std::pair<uint64_t, ColumnProperty> copy_compact(
+    index_input& in,
+    encryption::stream* in_cipher,
+    index_output& out,
+    encryption::stream* out_cipher,
+    bstring& buf) {
+  const auto size = irs::read_zvint(in);
+
+  if (!size) {
+    out.write_byte(0); // zig_zag_encode32(0) == 0
+    return { 0, CP_MASK };
+  }
+
+  const size_t buf_size = std::abs(size);
+  uint64_t data_size = buf_size; // -ve to mark uncompressed
+  const auto data_ptr = in.file_pointer();
+
+  if (size > 0) {
+    // original size is stored after the compressed data
+    in.seek(data_ptr + buf_size);
+    data_size = irs::read_zvlong(in) + MAX_DATA_BLOCK_SIZE;
+    in.seek(data_ptr);
+  }
+
+  irs::write_zvint(out, size);
+
+  if (!in_cipher && !out_cipher) {
+    copy_bytes(in, out, buf_size);
+  } else {
+    irs::string_utils::oversize(buf, buf_size);
+    auto* data = const_cast<byte_type*>(buf.c_str());
+
+    if (buf_size != in.read_bytes(data, buf_size)) {
+      throw io_error(string_utils::to_string(
+        "failed to read " IR_SIZE_T_SPECIFIER " bytes of column data",
+        buf_size));
+    }
+
+    if (in_cipher) {
+      in_cipher->decrypt(data_ptr, data, buf_size);
+    }
+
+    if (out_cipher) {
+      out_cipher->encrypt(out.file_pointer(), data, buf_size);
+    }
+
+    out.write_bytes(data, buf_size);
+  }
+
+  if (size > 0) {
+    irs::write_zvlong(out, data_size - MAX_DATA_BLOCK_SIZE); // original size
+  }
+
+  return { data_size, CP_SPARSE };
+}
+
+bool writer::copy(field_id id, const attribute_provider& src, doc_id_t doc_base) {
+  auto* encoded = irs::get<encoded_column>(src);
+
+  if (!encoded || id >= columns_.size()) {
+    return false;
+  }
+
+  return columns_[id].copy(*encoded, doc_base);
+}
+
+bool writer::column::copy(const encoded_column& src, doc_id_t doc_base) {
+  assert(src.ctxs && src.column);
+  const auto& src_column = *src.column;
+
+  // compressed blocks are moved only between columns of the same compression
+  if (src_column.compression().empty()
+      || src_column.compression() != comp_type_.name()) {
+    return false;
+  }
+
+  auto in = reopen_input(src.ctxs->stream());
+  auto* in_cipher = src_column.encrypted() ? src.ctxs->cipher() : nullptr;
+  auto& out = *ctx_->data_out_;
+  doc_id_t keys[INDEX_BLOCK_SIZE];
+  bool flushed = false;
+
+  // nothing is written unless the column provides its data blocks
+  return src_column.visit_blocks([&](uint64_t offset) {
+    if (!flushed) {
+      // flush pending values, copied blocks follow them
+      flush_block();
+      flushed = true;
+    }
+
+    // buffer may be reallocated by 'copy_compact'
+    assert(ctx_->buf_.size() >= INDEX_BLOCK_SIZE*sizeof(uint64_t));
+    auto* buf = reinterpret_cast<uint64_t*>(&ctx_->buf_[0]);
+
+    in->seek(offset);
+
+    const uint32_t size = in->read_vint(); // total number of entries in a block
+
+    if (!size || size > INDEX_BLOCK_SIZE) {
+      throw index_error(string_utils::to_string(
+        "while copying column block, error: invalid number of entries %u",
+        size));
+    }
+
+    // read keys
+    auto* key = keys;
+    encode::avg::visit_block_packed_tail(
+      *in, size, reinterpret_cast<uint32_t*>(buf),
+      [&key, doc_base](uint32_t value) {
+        assert(doc_limits::valid(value + doc_base));
+        *key++ = value + doc_base;
+    });
+
+    // read offsets
+    key = keys;
+    encode::avg::visit_block_packed_tail(
+      *in, size, buf,
+      [this, &key](uint64_t offset) {
+        block_index_.push_back(*key++, offset);
+    });
+
+    assert(block_index_.min_key() > max_ || !doc_limits::valid(max_));
+
+    const auto block_keys = begin_block();
+    auto block_props = block_index_.flush(out, buf);
+    const auto data = copy_compact(*in, in_cipher, out, cipher_, ctx_->buf_);
+    block_props |= data.second;
+
+    end_block(block_keys, block_props, data.first);
+
+    return true;
+  });
+}
+
 } // columns
 
 // ----------------------------------------------------------------------------
@@ -5103,6 +6171,10 @@ const reader::column_reader* reader::column(field_id field) const {
 
 class postings_reader_base : public irs::postings_reader {
  public:
+  explicit postings_reader_base(int32_t version) noexcept
+    : version_(version) {
+  }
+
   virtual void prepare(
     index_input& in,
     const reader_state& state,
@@ -5113,10 +6185,26 @@ class postings_reader_base : public irs::postings_reader {
     const flags& field,
     irs::term_meta& state) final;
 
+  virtual size_t decode(
+    const uint64_t* in,
+    const flags& field,
+    irs::term_meta& state) final;
+
  protected:
+  // postings of a term are stored as a bitset
+  bool dense(const flags& field, const version10::term_meta& meta) const noexcept {
+    return dense_docs_min_
+      && meta.docs_count >= dense_docs_min_
+      && !field.check<frequency>();
+  }
+
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  size_t dense_bits_{}; // number of bits in dense postings
+  uint32_t dense_docs_min_{}; // min number of documents in dense postings
+  int32_t version_; // postings format version
+  mutable skip_cache_registry skip_caches_; // populated by iterators
 }; // postings_reader
 
 void postings_reader_base::prepare(
@@ -5175,7 +6263,7 @@ void postings_reader_base::prepare(
   }
 
   // check postings format
-  format_utils::check_header(in,
+  const auto terms_version = format_utils::check_header(in,
     postings_writer_base::TERMS_FORMAT_NAME,
     postings_writer_base::TERMS_FORMAT_MIN,
     postings_writer_base::TERMS_FORMAT_MAX);
@@ -5187,6 +6275,15 @@ void postings_reader_base::prepare(
       "while preparing postings_reader, error: invalid block size '" IR_UINT64_T_SPECIFIER "'",
       block_size));
   }
+
+  dense_docs_min_ = 0;
+
+  if (terms_version >= postings_writer_base::TERMS_FORMAT_DENSE) {
+    dense_docs_min_ = in.read_vint();
+  }
+
+  assert(state.meta);
+  dense_bits_ = doc_limits::min() + state.meta->docs_count;
 }
 
 size_t postings_reader_base::decode(
@@ -5224,6 +6321,150 @@ size_t postings_reader_base::decode(
   return size_t(std::distance(in, p));
 }
 
+static_assert(version10::term_meta::MAX_ENCODED_VALUES <= irs::postings_reader::MAX_ENCODED_VALUES);
+
+size_t postings_reader_base::decode(
+    const uint64_t* in,
+    const flags& meta,
+    irs::term_meta& state) {
+  auto& term_meta = static_cast<version10::term_meta&>(state);
+
+  const bool has_freq = meta.check<frequency>();
+  const auto* p = in;
+
+  term_meta.docs_count = static_cast<uint32_t>(*p++);
+  if (has_freq) {
+    term_meta.freq = term_meta.docs_count + static_cast<uint32_t>(*p++);
+  }
+
+  term_meta.doc_start += *p++;
+  if (has_freq && term_meta.freq && meta.check<irs::position>()) {
+    term_meta.pos_start += *p++;
+
+    term_meta.pos_end = term_meta.freq > postings_writer_base::BLOCK_SIZE
+        ? *p++
+        : type_limits<type_t::address_t>::invalid();
+
+    if (meta.check<payload>() || meta.check<offset>()) {
+      term_meta.pay_start += *p++;
+    }
+  }
+
+  if (1U == term_meta.docs_count || term_meta.docs_count > postings_writer_base::BLOCK_SIZE) {
+    term_meta.e_skip_start = *p++;
+  }
+
+  assert(size_t(std::distance(in, p)) <= version10::term_meta::MAX_ENCODED_VALUES);
+  return size_t(std::distance(in, p));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief positions 'in' at postings of 'meta' stored as a bitset of
+///        'bits' bits, throws if the bitset doesn't fit the stream
+/// @returns number of 64-bit words taken by the bitset
+//////////////////////////////////////////////////////////////////////////////
+size_t seek_dense(index_input& in, const version10::term_meta& meta, size_t bits) {
+  const size_t words = math::div_ceil64(bits, bits_required<uint64_t>());
+
+  if (meta.docs_count > bits
+      || meta.doc_start > in.length()
+      || sizeof(uint64_t)*words > in.length() - meta.doc_start) {
+    throw index_error(string_utils::to_string(
+      "invalid dense postings, got " IR_SIZE_T_SPECIFIER " words at offset " IR_UINT64_T_SPECIFIER ", stream length " IR_UINT64_T_SPECIFIER,
+      words, meta.doc_start, uint64_t(in.length())));
+  }
+
+  in.seek(meta.doc_start);
+  return words;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief reads postings stored as a bitset of 64-bit words, passes first
+///        'size' words of type 'T' to 'visitor'
+//////////////////////////////////////////////////////////////////////////////
+template<typename T, typename Visitor>
+void read_dense(data_input& in, size_t size, Visitor&& visitor) {
+  constexpr size_t N = sizeof(uint64_t) / sizeof(T);
+  static_assert(N && sizeof(uint64_t) == N*sizeof(T));
+
+  while (size) {
+    auto word = uint64_t(in.read_long());
+
+    for (size_t i = 0; i < N && size; ++i, --size) {
+      visitor(T(word));
+
+      if constexpr (N > 1) {
+        word >>= bits_required<T>();
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class dense_doc_iterator
+/// @brief iterator over postings stored as a bitset, the bitset is read lazily
+///        on the first access
+///////////////////////////////////////////////////////////////////////////////
+class dense_doc_iterator final : public bitset_doc_iterator {
+ public:
+  dense_doc_iterator(
+      const index_input& doc_in,
+      const version10::term_meta& meta,
+      size_t bits) noexcept
+    : bitset_doc_iterator(meta.docs_count),
+      doc_in_src_(&doc_in),
+      meta_(meta),
+      bits_(bits) {
+  }
+
+  virtual attribute* get_mutable(irs::type_info::type_id id) noexcept override {
+    return irs::type<score>::id() == id
+      ? &score_
+      : bitset_doc_iterator::get_mutable(id);
+  }
+
+ protected:
+  virtual bool refill(const word_t** begin, const word_t** end) override;
+
+ private:
+  score score_;
+  std::unique_ptr<word_t[]> buf_; // bitset
+  index_input::ptr doc_in_;
+  const index_input* doc_in_src_;
+  version10::term_meta meta_;
+  size_t bits_; // number of bits in a bitset
+}; // dense_doc_iterator
+
+bool dense_doc_iterator::refill(const word_t** begin, const word_t** end) {
+  if (!doc_in_src_) {
+    return false;
+  }
+
+  doc_in_ = doc_in_src_->reopen(); // reopen thread-safe stream
+  doc_in_src_ = nullptr;
+
+  if (!doc_in_) {
+    // implementation returned wrong pointer
+    IR_FRMT_ERROR("Failed to reopen document input in: %s", __FUNCTION__);
+
+    throw io_error("failed to reopen document input");
+  }
+
+  seek_dense(*doc_in_, meta_, bits_);
+
+  const size_t size = bitset::bits_to_words(bits_);
+  buf_ = memory::make_unique<word_t[]>(size);
+
+  auto* word = buf_.get();
+  read_dense<word_t>(*doc_in_, size, [&word](word_t value) noexcept {
+    *word++ = value;
+  });
+
+  *begin = buf_.get();
+  *end = *begin + size;
+  return true;
+}
+
 template<typename FormatTraits, bool OneBasedPositionStorage>
 class postings_reader final: public postings_reader_base {
  public:
@@ -5236,6 +6477,10 @@ class postings_reader final: public postings_reader_base {
     static constexpr bool one_based_position_storage() { return OneBasedPositionStorage; }
   };
 
+  explicit postings_reader(int32_t version) noexcept
+    : postings_reader_base(version) {
+  }
+
   virtual irs::doc_iterator::ptr iterator(
     const flags& field,
     const flags& features,
@@ -5259,7 +6504,9 @@ class postings_reader final: public postings_reader_base {
         features, meta,
         ctx.doc_in_.get(),
         ctx.pos_in_.get(),
-        ctx.pay_in_.get());
+        ctx.pay_in_.get(),
+        ctx.version_,
+        &ctx.skip_caches_);
 
       return it;
     }
@@ -5324,6 +6571,14 @@ irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage>::i
     const flags& field,
     const flags& req,
     const term_meta& meta) {
+  auto& term_state = static_cast<const version10::term_meta&>(meta);
+
+  if (dense(field, term_state)) {
+    assert(doc_in_);
+    return memory::make_managed<dense_doc_iterator>(
+      *doc_in_, term_state, dense_bits_);
+  }
+
   return iterator_impl<doc_iterator_maker>(field, req, meta);
 }
 
@@ -5337,7 +6592,7 @@ void bit_union(
 
   doc_id_t doc = doc_limits::min();
   while (num_blocks--) {
-    IteratorTraits::read_block(doc_in, enc_buf, docs);
+    IteratorTraits::read_doc_block(doc_in, enc_buf, docs);
     if constexpr (IteratorTraits::frequency()) {
       IteratorTraits::skip_block(doc_in);
     }
@@ -5366,6 +6621,19 @@ void bit_union(
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief merges postings stored as a bitset of 'bits' bits into 'set'
+//////////////////////////////////////////////////////////////////////////////
+void bit_union(
+    index_input& doc_in, const version10::term_meta& meta,
+    size_t bits, size_t* set) {
+  seek_dense(doc_in, meta, bits);
+
+  read_dense<size_t>(doc_in, bitset::bits_to_words(bits), [&set](size_t word) noexcept {
+    *set++ |= word;
+  });
+}
+
 template<typename FormatTraits, bool OneBasedPositionStorage>
 size_t postings_reader<FormatTraits, OneBasedPositionStorage>::bit_union(
     const flags& field,
@@ -5390,7 +6658,11 @@ size_t postings_reader<FormatTraits, OneBasedPositionStorage>::bit_union(
   while (const irs::term_meta* meta = provider()) {
     auto& term_state = static_cast<const version10::term_meta&>(*meta);
 
-    if (term_state.docs_count > 1) {
+    if (dense(field, term_state)) {
+      ::bit_union(*doc_in, term_state, dense_bits_, set);
+
+      count += term_state.docs_count;
+    } else if (term_state.docs_count > 1) {
       doc_in->seek(term_state.doc_start);
       assert(!doc_in->eof());
 
@@ -5434,7 +6706,7 @@ class format10 : public irs::version10::format {
   virtual segment_meta_writer::ptr get_segment_meta_writer() const override;
   virtual segment_meta_reader::ptr get_segment_meta_reader() const override final;
 
-  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
   virtual document_mask_reader::ptr get_document_mask_reader() const override final;
 
   virtual field_writer::ptr get_field_writer(bool volatile_state) const override;
@@ -5485,7 +6757,7 @@ segment_meta_reader::ptr format10::get_segment_meta_reader() const {
 
 document_mask_writer::ptr format10::get_document_mask_writer() const {
   // can reuse stateless writer
-  static ::document_mask_writer INSTANCE;
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MIN);
 
   return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
 }
@@ -5537,7 +6809,9 @@ irs::postings_writer::ptr format10::get_postings_writer(bool volatile_state) con
 }
 
 irs::postings_reader::ptr format10::get_postings_reader() const {
-  return memory::make_unique<::postings_reader<format_traits, true>>();
+  constexpr const auto VERSION = postings_writer_base::FORMAT_MIN;
+
+  return memory::make_unique<::postings_reader<format_traits, true>>(VERSION);
 }
 
 /*static*/ irs::format::ptr format10::make() {
@@ -5622,7 +6896,7 @@ class format12 : public format11 {
 
   format12() noexcept : format11(irs::type<format12>::get()) { }
 
-  virtual columnstore_writer::ptr get_columnstore_writer() const override final;
+  virtual columnstore_writer::ptr get_columnstore_writer() const override;
 
  protected:
   explicit format12(const irs::type_info& type) noexcept
@@ -5634,7 +6908,7 @@ const ::format12 FORMAT12_INSTANCE;
 
 columnstore_writer::ptr format12::get_columnstore_writer() const {
   return memory::make_unique<columns::writer>(
-    int32_t(columns::writer::FORMAT_MAX));
+    int32_t(columns::writer::FORMAT_ENCRYPTION));
 }
 
 /*static*/ irs::format::ptr format12::make() {
@@ -5680,7 +6954,9 @@ irs::postings_writer::ptr format13::get_postings_writer(bool volatile_state) con
 }
 
 irs::postings_reader::ptr format13::get_postings_reader() const {
-  return memory::make_unique<::postings_reader<format_traits, false>>();
+  constexpr const auto VERSION = postings_writer_base::FORMAT_POSITIONS_ZEROBASED;
+
+  return memory::make_unique<::postings_reader<format_traits, false>>(VERSION);
 }
 
 /*static*/ irs::format::ptr format13::make() {
@@ -5730,6 +7006,96 @@ irs::field_writer::ptr format14::get_field_writer(bool volatile_state) const {
 
 REGISTER_FORMAT_MODULE(::format14, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format15
+// ----------------------------------------------------------------------------
+
+class format15 : public format14 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5";
+  }
+
+  DECLARE_FACTORY();
+
+  format15() noexcept : format14(irs::type<format15>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual columnstore_writer::ptr get_columnstore_writer() const override final;
+
+ protected:
+  explicit format15(const irs::type_info& type) noexcept
+    : format14(type) {
+  }
+};
+
+const ::format15 FORMAT15_INSTANCE;
+
+document_mask_writer::ptr format15::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MAX);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+columnstore_writer::ptr format15::get_columnstore_writer() const {
+  return memory::make_unique<columns::writer>(
+    int32_t(columns::writer::FORMAT_COMPRESSION_DATA));
+}
+
+/*static*/ irs::format::ptr format15::make() {
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                       format15ef
+// ----------------------------------------------------------------------------
+
+class format15ef final : public format15 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5ef";
+  }
+
+  DECLARE_FACTORY();
+
+  format15ef() noexcept : format15(irs::type<format15ef>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+}; // format15ef
+
+const ::format15ef FORMAT15EF_INSTANCE;
+
+irs::postings_writer::ptr format15ef::get_postings_writer(bool volatile_state) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_ELIAS_FANO_POSITIONS_ZEROBASED;
+  constexpr const auto TERMS_VERSION = postings_writer_base::TERMS_FORMAT_DENSE;
+
+  if (volatile_state) {
+    return memory::make_unique<::postings_writer<format_traits_elias_fano, true>>(
+      VERSION, TERMS_VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_elias_fano, false>>(
+    VERSION, TERMS_VERSION);
+}
+
+irs::postings_reader::ptr format15ef::get_postings_reader() const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_ELIAS_FANO_POSITIONS_ZEROBASED;
+
+  return memory::make_unique<::postings_reader<format_traits_elias_fano, false>>(VERSION);
+}
+
+/*static*/ irs::format::ptr format15ef::make() {
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15EF_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15ef, MODULE_NAME);
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                      format12sse
 // ----------------------------------------------------------------------------
@@ -5752,6 +7118,16 @@ struct format_traits_simd {
   FORCE_INLINE static void skip_block(index_input& in) {
     encode::bitpack::skip_block32(in, BLOCK_SIZE);
   }
+
+  FORCE_INLINE static void write_doc_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    write_block(out, in, buf);
+  }
+
+  FORCE_INLINE static void read_doc_block(
+      index_input& in, uint32_t* buf, uint32_t* out) {
+    read_block(in, buf, out);
+  }
 }; // format_traits_simd
 
 class format12simd final : public format12 {
@@ -5781,7 +7157,9 @@ irs::postings_writer::ptr format12simd::get_postings_writer(bool volatile_state)
 }
 
 irs::postings_reader::ptr format12simd::get_postings_reader() const {
-  return memory::make_unique<::postings_reader<format_traits_simd, true>>();
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_POSITIONS_ONEBASED;
+
+  return memory::make_unique<::postings_reader<format_traits_simd, true>>(VERSION);
 }
 
 /*static*/ irs::format::ptr format12simd::make() {
@@ -5828,7 +7206,9 @@ irs::postings_writer::ptr format13simd::get_postings_writer(bool volatile_state)
 }
 
 irs::postings_reader::ptr format13simd::get_postings_reader() const {
-  return memory::make_unique<::postings_reader<format_traits_simd, false>>();
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_POSITIONS_ZEROBASED;
+
+  return memory::make_unique<::postings_reader<format_traits_simd, false>>(VERSION);
 }
 
 /*static*/ irs::format::ptr format13simd::make() {
@@ -5876,6 +7256,50 @@ irs::field_writer::ptr format14simd::get_field_writer(bool volatile_state) const
 
 REGISTER_FORMAT_MODULE(::format14simd, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      format15sse
+// ----------------------------------------------------------------------------
+
+class format15simd : public format14simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5simd";
+  }
+
+  DECLARE_FACTORY();
+
+  format15simd() noexcept : format14simd(irs::type<format15simd>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual columnstore_writer::ptr get_columnstore_writer() const override final;
+
+ protected:
+  explicit format15simd(const irs::type_info& type) noexcept
+    : format14simd(type) {
+  }
+};
+
+const ::format15simd FORMAT15SIMD_INSTANCE;
+
+document_mask_writer::ptr format15simd::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MAX);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+columnstore_writer::ptr format15simd::get_columnstore_writer() const {
+  return memory::make_unique<columns::writer>(
+    int32_t(columns::writer::FORMAT_COMPRESSION_DATA));
+}
+
+/*static*/ irs::format::ptr format15simd::make() {
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15simd, MODULE_NAME);
+
 #endif // IRESEARCH_SSE2
 
 }
@@ -5890,10 +7314,13 @@ void init() {
   REGISTER_FORMAT(::format12);
   REGISTER_FORMAT(::format13);
   REGISTER_FORMAT(::format14);
+  REGISTER_FORMAT(::format15);
+  REGISTER_FORMAT(::format15ef);
 #ifdef IRESEARCH_SSE2
   REGISTER_FORMAT(::format12simd);
   REGISTER_FORMAT(::format13simd);
   REGISTER_FORMAT(::format14simd);
+  REGISTER_FORMAT(::format15simd);
 #endif // IRESEARCH_SSE2
 #endif // IRESEARCH_DLL
 }
@@ -5906,6 +7333,7 @@ format::format(const irs::type_info& type) noexcept
   : irs::format(type) {
 }
 
+
 } // version10
 
 // use base irs::position type for ancestors
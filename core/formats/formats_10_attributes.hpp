@@ -45,6 +45,9 @@ struct documents final : attribute {
 }; // documents
 
 struct term_meta : irs::term_meta {
+  // max number of variable-size encoded values written per term
+  static constexpr size_t MAX_ENCODED_VALUES = 7;
+
   term_meta() noexcept : e_skip_start(0) {} // GCC 4.9 does not initialize unions properly
 
   void clear() noexcept {
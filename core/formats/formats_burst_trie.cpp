@@ -1439,9 +1439,21 @@ class block_iterator : util::noncopyable {
   template<typename Reader>
   SeekResult scan_leaf(Reader&& reader);
 
+  // decode next values of the stats block into the window
+  void fill_stats() noexcept;
+
+  // max number of decoded stats values kept at once
+  static constexpr size_t STATS_WINDOW = 2*postings_reader::MAX_ENCODED_VALUES + 2;
+
   data_block header_; // suffix block header
   data_block suffix_; // suffix data block
   data_block stats_; // stats data block
+  // decoded stats values, zero-initialized since a postings reader may look
+  // at 'MAX_ENCODED_VALUES' values even if fewer are left in a block
+  uint64_t stats_values_[STATS_WINDOW]{};
+  uint64_t stats_left_{}; // number of not yet decoded bytes in stats block
+  uint32_t stats_pos_{}; // current position in decoded stats values
+  uint32_t stats_size_{}; // number of decoded stats values
   version10::term_meta state_;
   size_t suffix_length_{}; // last matched suffix length
   const byte_type* suffix_begin_{};
@@ -1536,6 +1548,8 @@ void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
   stats_.end = stats_.begin + block_size;
 #endif // IRESEARCH_DEBUG
   stats_.assert_block_boundaries();
+  stats_left_ = block_size;
+  stats_pos_ = stats_size_ = 0;
 
   cur_end_ = in.file_pointer();
   cur_ent_ = 0;
@@ -1831,13 +1845,31 @@ void block_iterator::load_data(const field_meta& meta,
   }
 
   for (; cur_stats_ent_ < term_count_; ++cur_stats_ent_) {
-    stats_.begin += pr.decode(stats_.begin, meta.features, state);
-    stats_.assert_block_boundaries();
+    if (stats_size_ - stats_pos_ < postings_reader::MAX_ENCODED_VALUES) {
+      fill_stats();
+    }
+
+    stats_pos_ += uint32_t(pr.decode(stats_values_ + stats_pos_, meta.features, state));
+    assert(stats_pos_ <= stats_size_);
   }
 
   state_ = state;
 }
 
+void block_iterator::fill_stats() noexcept {
+  // move remaining values to the beginning of the window
+  std::copy(stats_values_ + stats_pos_, stats_values_ + stats_size_, stats_values_);
+  stats_size_ -= stats_pos_;
+  stats_pos_ = 0;
+
+  const auto* begin = stats_.begin;
+  stats_size_ += uint32_t(vread_bulk(
+    stats_.begin, begin + stats_left_,
+    stats_values_ + stats_size_, STATS_WINDOW - stats_size_));
+  stats_left_ -= size_t(std::distance(begin, stats_.begin));
+  stats_.assert_block_boundaries();
+}
+
 void block_iterator::reset() {
   if (sub_count_ != UNDEFINED_COUNT) {
     sub_count_ = 0;
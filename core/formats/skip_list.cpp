@@ -45,6 +45,39 @@ inline size_t max_levels(size_t skip_0, size_t skip_n, size_t count) {
 
 const size_t UNDEFINED = std::numeric_limits<size_t>::max();
 
+// returns position of the first key not less than the specified target in
+// the sorted array of keys terminated by eof, since targets of consecutive
+// seeks tend to be close, the range is found by galloping forward from the
+// position of the previous seek and then narrowed by a binary search which
+// compiles into conditional moves rather than unpredictable branches
+size_t lower_bound(
+    const irs::doc_id_t* keys,
+    size_t size,
+    size_t hint,
+    irs::doc_id_t target) noexcept {
+  assert(size && irs::doc_limits::eof(keys[size - 1]));
+
+  // all keys before 'lo' are less than target
+  size_t lo = hint < size && hint && keys[hint - 1] < target ? hint : 0;
+  size_t hi = lo;
+
+  for (size_t step = 1; hi < size && keys[hi] < target; step <<= 1) {
+    lo = hi + 1;
+    hi = lo + step;
+  }
+
+  const auto* base = keys + lo;
+  size_t count = std::min(hi, size) - lo;
+
+  while (count > 1) {
+    const size_t half = count / 2;
+    base = base[half] < target ? base + half : base;
+    count -= half;
+  }
+
+  return size_t(base - keys) + size_t(count && *base < target);
+}
+
 } // LOCAL
 
 namespace iresearch {
@@ -292,6 +325,10 @@ skip_reader::levels_t::iterator skip_reader::find_level(doc_id_t target) {
 size_t skip_reader::seek(doc_id_t target) {
   assert(!levels_.empty());
 
+  if (cached()) {
+    return seek_cached(target);
+  }
+
   auto level = find_level(target); // the highest level for the specified target
   uint64_t child = 0; // pointer to child skip
   size_t skipped = 0; // number of skipped documents
@@ -319,7 +356,91 @@ size_t skip_reader::seek(doc_id_t target) {
   return skipped ? skipped - skip_0_ : 0;
 }
 
+bool skip_reader::load_cache(cache_t& cache, const cache_f& save) {
+  assert(save);
+
+  if (levels_.size() < 3) {
+    return false;
+  }
+
+  auto& level = levels_[levels_.size() - 3]; // level 2
+
+  // read the whole level from the beginning
+  level.stream->seek(level.begin);
+  level.child = 0;
+  level.skipped = 0;
+
+  cache.keys.clear();
+  cache.ptrs.clear();
+
+  // don't let 'read_' see the exhausted stream, the last call for the
+  // level 2 is then always followed by a 'save' call
+  while (!level.eof()) {
+    read_skip(level);
+
+    if (doc_limits::eof(level.doc)) {
+      break;
+    }
+
+    cache.keys.emplace_back(level.doc);
+    cache.ptrs.emplace_back(level.child);
+    save(cache.ptrs.size() - 1);
+  }
+
+  cache.keys.emplace_back(doc_limits::eof());
+
+  return true;
+}
+
+size_t skip_reader::seek_cached(doc_id_t target) {
+  auto& level_0 = levels_.back();
+
+  if (level_0.doc < target) {
+    auto& level_1 = levels_[levels_.size() - 2];
+
+    if (level_1.doc < target) {
+      cache_pos_ = lower_bound(
+        cache_->keys.data(), cache_->keys.size(), cache_pos_, target);
+
+      if (cache_pos_) {
+        // last skip of the level 2 preceding the target
+        const size_t skip = cache_pos_ - 1;
+        const auto ptr = cache_->ptrs[skip];
+
+        if (level_1.begin + ptr > level_1.stream->file_pointer()) {
+          load_(skip);
+          seek_skip(level_1, ptr, cache_pos_ * levels_[levels_.size() - 3].step);
+        }
+      }
+
+      // descend through the level 1 the same way as 'seek' does
+      uint64_t child = level_1.child;
+      for (read_skip(level_1); level_1.doc < target; read_skip(level_1)) {
+        child = level_1.child;
+      }
+
+      seek_skip(level_0, child, level_1.skipped - level_1.step);
+    }
+
+    for (read_skip(level_0); level_0.doc < target; read_skip(level_0)) { }
+  }
+
+  const size_t skipped = level_0.skipped;
+  return skipped ? skipped - skip_0_ : 0;
+}
+
+void skip_reader::cache(const cache_t& cache, const cache_f& load) {
+  assert(load);
+  assert(!cache.keys.empty() && doc_limits::eof(cache.keys.back()));
+  assert(cache.keys.size() == cache.ptrs.size() + 1);
+  cache_ = &cache;
+  load_ = load;
+  cache_pos_ = 0;
+}
+
 void skip_reader::reset() {
+  cache_pos_ = 0;
+
   static auto reset = [](skip_reader::level& level) {
     level.stream->seek(level.begin);
     if (level.child != UNDEFINED) {
@@ -378,6 +499,8 @@ void skip_reader::prepare(index_input::ptr&& in, const read_f& read /* = nop */)
   }
 
   read_ = read;
+  cache_ = nullptr;
+  cache_pos_ = 0;
 }
 
 }
@@ -142,6 +142,21 @@ class IRESEARCH_API skip_reader: util::noncopyable {
   //////////////////////////////////////////////////////////////////////////////
   typedef std::function<doc_id_t(size_t, index_input&)> read_f;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief function will be called with an index of a skip of the level 2
+  ///        kept in memory (@see load_cache(...), cache(...))
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::function<void(size_t)> cache_f;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief in-memory copy of the level 2 of a skip-list, it's immutable once
+  ///        loaded and might be shared between readers of the same skip-list
+  //////////////////////////////////////////////////////////////////////////////
+  struct cache_t {
+    std::vector<doc_id_t> keys; // keys of the level 2 followed by eof
+    std::vector<uint64_t> ptrs; // pointers to the level 1 from the level 2
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief constructor
   /// @param skip_0 skip interval for level 0
@@ -182,6 +197,45 @@ class IRESEARCH_API skip_reader: util::noncopyable {
   //////////////////////////////////////////////////////////////////////////////
   size_t seek(doc_id_t target);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads all skips of the level 2 into the specified cache
+  /// @param save function called right after the skip of the level 2 with
+  ///        the specified index has been loaded, allowing users to keep a
+  ///        copy of the state produced by 'read_f' for this skip
+  /// @note the level 2 is read from its beginning rather than descending
+  ///       from the parent skip, the state passed to 'read_f' has to be
+  ///       initialized accordingly
+  /// @note the reader is supposed to be switched to the cached mode then
+  /// @returns false if a skip-list has less than 3 levels
+  //////////////////////////////////////////////////////////////////////////////
+  bool load_cache(cache_t& cache, const cache_f& save);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief switches skip_reader to the mode when the levels above 1 are never
+  ///        read, the target skip of the level 2 is found in the specified
+  ///        cache via exponential search started from the position of the
+  ///        previous seek followed by a branchless binary search, only the
+  ///        levels 1 and 0 are read from the stream
+  /// @param cache copy of the level 2 loaded by any reader of the same
+  ///        skip-list, must outlive the reader
+  /// @param load function called to restore the copy of the state kept for
+  ///        the skip with the specified index as if the skip has just been
+  ///        read from the level 2 and is the last one preceding the target,
+  ///        the subsequent 'read_f' call is then made for the level 1
+  /// @note levels 1 and 0 are read from their beginning rather than
+  ///       descending from the parent skip, the state passed to 'read_f'
+  ///       has to be initialized accordingly
+  /// @note has no effect for skip-lists having less than 3 levels
+  //////////////////////////////////////////////////////////////////////////////
+  void cache(const cache_t& cache, const cache_f& load);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if the level 2 is taken from a cache
+  //////////////////////////////////////////////////////////////////////////////
+  bool cached() const noexcept {
+    return cache_ && levels_.size() > 2;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief resets skip reader internal state
   //////////////////////////////////////////////////////////////////////////////
@@ -239,10 +293,14 @@ class IRESEARCH_API skip_reader: util::noncopyable {
 
   void read_skip(skip_reader::level& level);
   levels_t::iterator find_level(doc_id_t);
+  size_t seek_cached(doc_id_t target);
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   read_f read_;
+  cache_f load_;
   levels_t levels_; // input streams for skip-list levels
+  const cache_t* cache_{}; // in-memory copy of the level 2
+  size_t cache_pos_{}; // position found by the previous seek in 'cache_->keys'
   size_t skip_0_; // skip interval for 0 level
   size_t skip_n_; // skip interval for 1..n levels
   IRESEARCH_API_PRIVATE_VARIABLES_END
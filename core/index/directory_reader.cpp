@@ -23,15 +23,20 @@
 
 #include "directory_reader.hpp"
 
+#include <atomic>
+#include <future>
+
 #include <absl/container/flat_hash_map.h>
 
 #include "index/segment_reader.hpp"
 #include "index/composite_reader_impl.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/singleton.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/hash_utils.hpp"
+#include "utils/misc.hpp"
 
 
 namespace {
@@ -183,10 +188,12 @@ class directory_reader_impl :
   // open a new directory reader
   // if codec == nullptr then use the latest file for all known codecs
   // if cached != nullptr then try to reuse its segments
+  // if pool != nullptr then open segments concurrently
   static index_reader::ptr open(
     const directory& dir,
     const format* codec = nullptr,
-    const index_reader::ptr& cached = nullptr
+    const index_reader::ptr& cached = nullptr,
+    async_utils::thread_pool* pool = nullptr
   );
 
  private:
@@ -241,12 +248,14 @@ const directory_meta& directory_reader::meta() const {
 
 /*static*/ directory_reader directory_reader::open(
     const directory& dir,
-    format::ptr codec /*= nullptr*/) {
-  return directory_reader_impl::open(dir, codec.get());
+    format::ptr codec /*= nullptr*/,
+    async_utils::thread_pool* pool /*= nullptr*/) {
+  return directory_reader_impl::open(dir, codec.get(), nullptr, pool);
 }
 
 directory_reader directory_reader::reopen(
-    format::ptr codec /*= nullptr*/) const {
+    format::ptr codec /*= nullptr*/,
+    async_utils::thread_pool* pool /*= nullptr*/) const {
   // make a copy
   impl_ptr impl = atomic_utils::atomic_load(&impl_);
 
@@ -257,7 +266,7 @@ directory_reader directory_reader::reopen(
 #endif
 
   return directory_reader_impl::open(
-    reader_impl.dir(), codec.get(), impl
+    reader_impl.dir(), codec.get(), impl, pool
   );
 }
 
@@ -281,7 +290,8 @@ directory_reader_impl::directory_reader_impl(
 /*static*/ index_reader::ptr directory_reader_impl::open(
     const directory& dir,
     const format* codec /*= nullptr*/,
-    const index_reader::ptr& cached /*= nullptr*/) {
+    const index_reader::ptr& cached /*= nullptr*/,
+    async_utils::thread_pool* pool /*= nullptr*/) {
   index_meta meta;
   index_file_refs::ref_t meta_file_ref = load_newest_index_meta(meta, dir, codec);
 
@@ -315,30 +325,31 @@ directory_reader_impl::directory_reader_impl(
     }
   }
 
-  readers_t readers(meta.size());
-  uint64_t docs_max = 0; // overall number of documents (with deleted)
-  uint64_t docs_count = 0; // number of live documents
-  reader_file_refs_t file_refs(readers.size() + 1); // +1 for index_meta file refs
-  segment_file_refs_t tmp_file_refs;
-  auto visitor = [&tmp_file_refs](index_file_refs::ref_t&& ref)->bool {
-    tmp_file_refs.emplace(std::move(ref));
-    return true;
-  };
+  const size_t size = meta.size();
+  std::vector<size_t> reuse(size, INVALID_CANDIDATE); // old segment id to reopen
 
-  for (size_t i = 0, size = meta.size(); i < size; ++i) {
-    auto& reader = readers[i];
+  // resolve reusable segments upfront since reuse candidates aren't
+  // safe for concurrent access
+  for (size_t i = 0; i < size; ++i) {
     auto& segment = meta.segment(i).meta;
-    auto& segment_file_refs = file_refs[i];
     auto itr = reuse_candidates.find(segment.name);
 
     if (itr != reuse_candidates.end()
         && itr->second != INVALID_CANDIDATE
         && segment == cached_impl->meta_.meta.segment(itr->second).meta) {
-      reader = (*cached_impl)[itr->second].reopen(segment);
+      reuse[i] = itr->second;
       reuse_candidates.erase(itr);
-    } else {
-      reader = segment_reader::open(dir, segment);
     }
+  }
+
+  readers_t readers(size);
+  auto open_segment = [&](size_t i) {
+    auto& segment = meta.segment(i).meta;
+    auto& reader = readers[i];
+
+    reader = INVALID_CANDIDATE == reuse[i]
+      ? segment_reader::open(dir, segment)
+      : (*cached_impl)[reuse[i]].reopen(segment);
 
     if (!reader) {
       throw index_error(string_utils::to_string(
@@ -346,11 +357,85 @@ directory_reader_impl::directory_reader_impl(
         segment.name.c_str()
       ));
     }
+  };
+
+  if (pool && size > 1) {
+    // a task is executed either by the pool or by the current thread,
+    // whichever claims it first, hence we never wait for a task which
+    // hasn't been started yet, e.g. the one stuck in the queue of a
+    // saturated pool or dropped by the pool
+    struct task {
+      void operator()() {
+        if (!claimed.exchange(true)) {
+          impl();
+        }
+      }
+
+      std::atomic<bool> claimed{ false };
+      std::packaged_task<void()> impl;
+    };
+
+    // tasks might outlive this scope in the pool queue
+    auto tasks = std::make_shared<std::vector<task>>(size);
+    std::vector<std::future<void>> results;
+    results.reserve(size);
+
+    // each task writes to its own slot in 'readers',
+    // so segment order doesn't depend on completion order
+    for (size_t i = 0; i < size; ++i) {
+      auto& impl = (*tasks)[i].impl;
+      impl = std::packaged_task<void()>([&open_segment, i]() { open_segment(i); });
+      results.emplace_back(impl.get_future());
+    }
+
+    // ensure no task refers to local state once we leave the scope
+    auto wait_all = make_finally([&results]() noexcept {
+      for (auto& result : results) {
+        if (result.valid()) {
+          result.wait();
+        }
+      }
+    });
+
+    try {
+      for (size_t i = 0; i < size; ++i) {
+        if (!pool->run([tasks, i]() { (*tasks)[i](); })) {
+          break; // pool isn't running
+        }
+      }
+    } catch (...) {
+      // failed to schedule a task, open the rest sequentially
+    }
+
+    for (auto& task : *tasks) {
+      task(); // open segments not yet picked up by the pool
+    }
+
+    for (auto& result : results) {
+      result.get(); // rethrow the first failure in segment order
+    }
+  } else {
+    for (size_t i = 0; i < size; ++i) {
+      open_segment(i);
+    }
+  }
+
+  uint64_t docs_max = 0; // overall number of documents (with deleted)
+  uint64_t docs_count = 0; // number of live documents
+  reader_file_refs_t file_refs(size + 1); // +1 for index_meta file refs
+  segment_file_refs_t tmp_file_refs;
+  auto visitor = [&tmp_file_refs](index_file_refs::ref_t&& ref)->bool {
+    tmp_file_refs.emplace(std::move(ref));
+    return true;
+  };
+
+  for (size_t i = 0; i < size; ++i) {
+    auto& reader = readers[i];
 
     docs_max += reader.docs_count();
     docs_count += reader.live_docs_count();
-    directory_utils::reference(const_cast<directory&>(dir), segment, visitor, true);
-    segment_file_refs.swap(tmp_file_refs);
+    directory_utils::reference(const_cast<directory&>(dir), meta.segment(i).meta, visitor, true);
+    file_refs[i].swap(tmp_file_refs);
   }
 
   directory_utils::reference(const_cast<directory&>(dir), meta, visitor, true);
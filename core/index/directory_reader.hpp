@@ -29,6 +29,9 @@
 #include "utils/object_pool.hpp"
 
 namespace iresearch {
+namespace async_utils {
+class thread_pool;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief representation of the metadata of a directory_reader
@@ -102,19 +105,27 @@ class IRESEARCH_API directory_reader final
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief create an index reader over the specified directory
   ///        if codec == nullptr then use the latest file for all known codecs
+  ///        if pool != nullptr then segments are opened concurrently on it,
+  ///        segment order of the resulting reader matches the index meta
+  /// @note the calling thread opens segments not yet picked up by the pool
+  ///       itself, so it's safe to call from a thread of a saturated 'pool'
   ////////////////////////////////////////////////////////////////////////////////
   static directory_reader open(
     const directory& dir,
-    format::ptr codec = nullptr
+    format::ptr codec = nullptr,
+    async_utils::thread_pool* pool = nullptr
   );
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief open a new instance based on the latest file for the specified codec
   ///        this call will atempt to reuse segments from the existing reader
   ///        if codec == nullptr then use the latest file for all known codecs
+  ///        if pool != nullptr then changed segments are opened concurrently,
+  ///        see open(...) for details
   ////////////////////////////////////////////////////////////////////////////////
   virtual directory_reader reopen(
-    format::ptr codec = nullptr
+    format::ptr codec = nullptr,
+    async_utils::thread_pool* pool = nullptr
   ) const;
 
   void reset() noexcept {
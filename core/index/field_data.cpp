@@ -49,6 +49,7 @@
 #include <set>
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
 namespace {
 
@@ -1031,6 +1032,65 @@ void field_data::add_term_random_access(
   }
 }
 
+FORCE_INLINE bool field_data::add_token(
+    const bytes_ref& term,
+    uint32_t inc,
+    doc_id_t id,
+    const payload* pay,
+    const offset* offs) {
+  pos_ += inc;
+
+  if (pos_ < last_pos_) {
+    IR_FRMT_ERROR("invalid position %u < %u in field '%s'", pos_, last_pos_, meta_.name.c_str());
+    return false;
+  }
+
+  if (pos_ >= pos_limits::eof()) {
+    IR_FRMT_ERROR("invalid position %u >= %u in field '%s'", pos_, pos_limits::eof(), meta_.name.c_str());
+    return false;
+  }
+
+  if (0 == inc) {
+    ++num_overlap_;
+  }
+
+  if (offs) {
+    const uint32_t start_offset = offs_ + offs->start;
+    const uint32_t end_offset = offs_ + offs->end;
+
+    if (start_offset < last_start_offs_ || end_offset < start_offset) {
+      IR_FRMT_ERROR("invalid offset start=%u end=%u in field '%s'", start_offset, end_offset, meta_.name.c_str());
+      return false;
+    }
+
+    last_start_offs_ = start_offset;
+  }
+
+  const auto res = terms_.emplace(term);
+
+  if (nullptr == res.first) {
+    IR_FRMT_ERROR("field '%s' has invalid term of size '" IR_SIZE_T_SPECIFIER "'",
+                  meta_.name.c_str(), term.size());
+    IR_FRMT_TRACE("field '%s' has invalid term '%s'",
+                  meta_.name.c_str(), ref_cast<char>(term).c_str());
+    return true; // skip term
+  }
+
+  (this->*proc_table_[size_t(res.second)])(*res.first, id, pay, offs);
+
+  if (0 == ++len_) {
+    IR_FRMT_ERROR(
+      "too many tokens in field '%s', document '" IR_UINT32_T_SPECIFIER "'",
+       meta_.name.c_str(), id
+    );
+    return false;
+  }
+
+  last_pos_ = pos_;
+
+  return true;
+}
+
 bool field_data::invert(
     token_stream& stream, 
     const flags& features, 
@@ -1071,56 +1131,32 @@ bool field_data::invert(
 
   reset(id); // initialize field_data for the supplied doc_id
 
-  while (stream.next()) {
-    pos_ += inc->value;
-
-    if (pos_ < last_pos_) {
-      IR_FRMT_ERROR("invalid position %u < %u in field '%s'", pos_, last_pos_, meta_.name.c_str());
-      return false;
-    }
-
-    if (pos_ >= pos_limits::eof()) {
-      IR_FRMT_ERROR("invalid position %u >= %u in field '%s'", pos_, pos_limits::eof(), meta_.name.c_str());
-      return false;
-    }
-
-    if (0 == inc->value) {
-      ++num_overlap_;
+  if (stream.batched()) {
+    // tokens produced in bulk, attributes are copied only to be passed
+    // to term processing routines
+    token tokens[64];
+    offset token_offs;
+    payload token_pay;
+    const payload* batch_pay = pay ? &token_pay : nullptr;
+    const offset* batch_offs = offs ? &token_offs : nullptr;
+
+    for (size_t count; (count = stream.next_batch(tokens, std::size(tokens))); ) {
+      for (const auto* it = tokens, *end = tokens + count; it != end; ++it) {
+        token_offs.start = it->start;
+        token_offs.end = it->end;
+        token_pay.value = it->payload;
+
+        if (!add_token(it->term, it->increment, id, batch_pay, batch_offs)) {
+          return false;
+        }
+      }
     }
-
-    if (offs) {
-      const uint32_t start_offset = offs_ + offs->start;
-      const uint32_t end_offset = offs_ + offs->end;
-
-      if (start_offset < last_start_offs_ || end_offset < start_offset) {
-        IR_FRMT_ERROR("invalid offset start=%u end=%u in field '%s'", start_offset, end_offset, meta_.name.c_str());
+  } else {
+    while (stream.next()) {
+      if (!add_token(term->value, inc->value, id, pay, offs)) {
         return false;
       }
-
-      last_start_offs_ = start_offset;
     }
-
-    const auto res = terms_.emplace(term->value);
-
-    if (nullptr == res.first) {
-      IR_FRMT_ERROR("field '%s' has invalid term of size '" IR_SIZE_T_SPECIFIER "'",
-                    meta_.name.c_str(), term->value.size());
-      IR_FRMT_TRACE("field '%s' has invalid term '%s'",
-                    meta_.name.c_str(), ref_cast<char>(term->value).c_str());
-      continue;
-    }
-
-    (this->*proc_table_[size_t(res.second)])(*res.first, id, pay, offs);
-
-    if (0 == ++len_) {
-      IR_FRMT_ERROR(
-        "too many tokens in field '%s', document '" IR_UINT32_T_SPECIFIER "'",
-         meta_.name.c_str(), id
-      );
-      return false;
-    }
-
-    last_pos_ = pos_;
   }
 
   if (offs) {
@@ -98,6 +98,10 @@ class IRESEARCH_API field_data : util::noncopyable {
 
   void reset(doc_id_t doc_id);
 
+  // returns false on error
+  bool add_token(const bytes_ref& term, uint32_t inc, doc_id_t id,
+                 const payload* pay, const offset* offs);
+
   void new_term(posting& p, doc_id_t did, const payload* pay, const offset* offs);
   void add_term(posting& p, doc_id_t did, const payload* pay, const offset* offs);
 
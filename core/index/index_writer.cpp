@@ -25,6 +25,7 @@
 #include "file_names.hpp"
 #include "merge_writer.hpp"
 #include "comparer.hpp"
+#include "composite_reader_impl.hpp"
 #include "formats/format_utils.hpp"
 #include "search/exclusion.hpp"
 #include "utils/bitvector.hpp"
@@ -529,6 +530,26 @@ std::string to_string(const irs::index_writer::consolidation_t& consolidation) {
   return ss.str();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reader over the flushed state of an index_writer
+/// @note holds the state to keep its files referenced
+////////////////////////////////////////////////////////////////////////////////
+template<typename State>
+class flushed_reader final : public irs::composite_reader<irs::segment_reader> {
+ public:
+  flushed_reader(
+      State&& state,
+      readers_t&& readers,
+      uint64_t docs_count,
+      uint64_t docs_max) noexcept
+    : composite_reader(std::move(readers), docs_count, docs_max),
+      state_(std::move(state)) {
+  }
+
+ private:
+  State state_;
+}; // flushed_reader
+
 } // NS_LOCAL
 
 namespace iresearch {
@@ -1040,7 +1061,8 @@ index_writer::segment_context::segment_context(
     directory& dir,
     segment_meta_generator_t&& meta_generator,
     const column_info_provider_t& column_info,
-    const comparer* comparator)
+    const comparer* comparator,
+    double dense_postings_threshold)
   : active_count_(0),
     buffered_docs_(0),
     dirty_(false),
@@ -1049,7 +1071,7 @@ index_writer::segment_context::segment_context(
     uncomitted_doc_id_begin_(doc_limits::min()),
     uncomitted_generation_offset_(0),
     uncomitted_modification_queries_(0),
-    writer_(segment_writer::make(dir_, column_info, comparator)) {
+    writer_(segment_writer::make(dir_, column_info, comparator, dense_postings_threshold)) {
   assert(meta_generator_);
 }
 
@@ -1098,8 +1120,10 @@ index_writer::segment_context::ptr index_writer::segment_context::make(
     directory& dir,
     segment_meta_generator_t&& meta_generator,
     const column_info_provider_t& column_info,
-    const comparer* comparator) {
-  return memory::make_shared<segment_context>(dir, std::move(meta_generator), column_info, comparator);
+    const comparer* comparator,
+    double dense_postings_threshold) {
+  return memory::make_shared<segment_context>(
+    dir, std::move(meta_generator), column_info, comparator, dense_postings_threshold);
 }
 
 segment_writer::update_context index_writer::segment_context::make_update_context() {
@@ -1215,11 +1239,15 @@ index_writer::index_writer(
     const comparer* comparator,
     const column_info_provider_t& column_info,
     const payload_provider_t& meta_payload_provider,
+    async_utils::thread_pool* merge_pool,
+    double dense_postings_threshold,
     index_meta&& meta,
     committed_state_t&& committed_state)
   : column_info_(column_info),
     meta_payload_provider_(meta_payload_provider),
     comparator_(comparator),
+    merge_pool_(merge_pool),
+    dense_postings_threshold_(dense_postings_threshold),
     cached_readers_(dir),
     codec_(codec),
     committed_state_(std::move(committed_state)),
@@ -1302,6 +1330,9 @@ void index_writer::clear(uint64_t tick) {
 
   meta_.segments_.clear(); // noexcept op (clear after finish(), to match reset of pending_state_ inside finish(), allows recovery on clear() failure)
   cached_readers_.clear(); // original readers no longer required
+  flushed_state_.reset(); // segments flushed by nrt_reader() are dropped
+  unsynced_segments_.clear();
+  flushed_tick_ = 0;
 
   // clear consolidating segments
   auto lock = make_lock_guard(consolidation_lock_);
@@ -1376,6 +1407,8 @@ index_writer::ptr index_writer::make(
     opts.comparator,
     opts.column_info ? opts.column_info : DEFAULT_COLUMN_INFO,
     opts.meta_payload_provider,
+    opts.merge_pool,
+    opts.dense_postings_threshold,
     std::move(meta),
     std::move(comitted_state)
   );
@@ -1531,7 +1564,8 @@ index_writer::consolidation_result index_writer::consolidate(
   consolidation_segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
 
   ref_tracking_directory dir(dir_); // track references for new segment
-  merge_writer merger(dir, column_info_, comparator_);
+  merge_writer merger(
+    dir, column_info_, comparator_, merge_pool_, dense_postings_threshold_);
   merger.reserve(result.size);
 
   // add consolidated segments to the merge_writer
@@ -1557,7 +1591,9 @@ index_writer::consolidation_result index_writer::consolidate(
   {
     // ensure committed_state_ segments are not modified by concurrent consolidate()/commit()
     auto lock = make_unique_lock(commit_lock_);
-    const auto current_committed_meta = committed_state_->first;
+    // segments flushed by nrt_reader() may already contain removals which
+    // the consolidated segment doesn't, treat them as a finished commit
+    const auto current_committed_meta = (flushed_state_ ? flushed_state_ : committed_state_)->first;
     assert(current_committed_meta);
 
     auto cleanup_cached_readers = [&current_committed_meta, &candidates, this]() {
@@ -1780,7 +1816,8 @@ bool index_writer::import(
   segment.meta.name = file_name(meta_.increment());
   segment.meta.codec = codec;
 
-  merge_writer merger(dir, column_info_, comparator_);
+  merge_writer merger(
+    dir, column_info_, comparator_, merge_pool_, dense_postings_threshold_);
   merger.reserve(reader.size());
 
   for (auto& segment : reader) {
@@ -1906,14 +1943,15 @@ index_writer::active_segment_context index_writer::get_segment_context(
   };
   auto segment_ctx = segment_writer_pool_.emplace(
     dir_, std::move(meta_generator),
-    column_info_, comparator_
+    column_info_, comparator_, dense_postings_threshold_
   ).release();
   auto segment_memory_max = segment_limits_.segment_memory_max.load();
 
   // recreate writer if it reserved more memory than allowed by current limits
   if (segment_memory_max &&
       segment_memory_max < segment_ctx->writer_->memory_reserved()) {
-    segment_ctx->writer_ = segment_writer::make(segment_ctx->dir_, column_info_, comparator_);
+    segment_ctx->writer_ = segment_writer::make(
+      segment_ctx->dir_, column_info_, comparator_, dense_postings_threshold_);
   }
 
   return active_segment_context(segment_ctx, segments_active_);
@@ -1958,7 +1996,7 @@ index_writer::pending_context_t index_writer::flush_all() {
   /// are properly tracked in 'modification_queries_'
   //////////////////////////////////////////////////////////////////////////////
 
-  uint64_t max_tick = 0;
+  uint64_t max_tick = flushed_tick_; // account for transactions flushed by nrt_reader()
 
   for (auto& entry : ctx->pending_segment_contexts_) {
     // mark the 'segment_context' as dirty so that it will not be reused if this
@@ -2373,6 +2411,7 @@ index_writer::pending_context_t index_writer::flush_all() {
   pending_meta->update_generation(meta_); // clone index metadata generation
 
   modified |= !to_sync.empty();
+  modified |= !unsynced_segments_.empty(); // segments flushed by nrt_reader() are pending commit
 
   // only flush a new index version upon a new index or a metadata change
   if (!modified) {
@@ -2394,10 +2433,99 @@ index_writer::pending_context_t index_writer::flush_all() {
   pending_context.ctx = std::move(ctx); // retain flush context reference
   pending_context.meta = std::move(pending_meta); // retain meta pending flush
   pending_context.to_sync = std::move(to_sync);
+  pending_context.tick = max_tick;
 
   return pending_context;
 }
 
+bool index_writer::flush() {
+  assert(!commit_lock_.try_lock()); // already locked
+
+  REGISTER_TIMER_DETAILED();
+
+  auto to_flush = flush_all();
+
+  if (!to_flush) {
+    // nothing to flush
+    return false;
+  }
+
+  auto& dir = *to_flush.ctx->dir_;
+  auto& flushed_meta = *to_flush.meta;
+
+  // track all refs, flushed segments must survive until the next commit
+  file_refs_t flushed_refs;
+  append_segments_refs(flushed_refs, dir, flushed_meta);
+
+  // segments to be synced by the next commit
+  auto unsynced_segments = unsynced_segments_;
+
+  for (auto& entry : to_flush.to_sync.segments) {
+    unsynced_segments.emplace(flushed_meta[entry.first].meta.name);
+  }
+
+  auto flushed_state = memory::make_shared<committed_state_t::element_type>(
+    std::piecewise_construct,
+    std::forward_as_tuple(std::move(to_flush.meta)),
+    std::forward_as_tuple(std::move(flushed_refs))
+  );
+
+  meta_.segments_ = flushed_state->first->segments_; // create copy
+
+  // ...........................................................................
+  // only noexcept operations below
+  // ...........................................................................
+
+  unsynced_segments_ = std::move(unsynced_segments);
+  flushed_state_ = std::move(flushed_state);
+  flushed_tick_ = to_flush.tick;
+  cached_readers_.purge(to_flush.ctx->segment_mask_); // release cached readers
+
+  return true;
+}
+
+index_reader::ptr index_writer::nrt_reader() {
+  REGISTER_TIMER_DETAILED();
+
+  auto lock = make_lock_guard(commit_lock_);
+
+  committed_state_t state;
+
+  if (pending_state_) {
+    // begin() has been already called, use its flushed state
+    state = pending_state_.commit;
+  } else {
+    flush();
+    state = flushed_state_ ? flushed_state_ : committed_state_;
+  }
+
+  assert(state && state->first);
+  auto& meta = *state->first;
+
+  flushed_reader<committed_state_t>::readers_t readers;
+  readers.reserve(meta.size());
+  uint64_t docs_max = 0; // overall number of documents (with deleted)
+  uint64_t docs_count = 0; // number of live documents
+
+  for (auto& segment : meta) {
+    auto reader = cached_readers_.emplace(segment.meta);
+
+    if (!reader) {
+      throw index_error(string_utils::to_string(
+        "while opening reader for segment '%s', error: failed to open reader",
+        segment.meta.name.c_str()
+      ));
+    }
+
+    docs_max += reader.docs_count();
+    docs_count += reader.live_docs_count();
+    readers.emplace_back(std::move(reader));
+  }
+
+  return memory::make_shared<flushed_reader<committed_state_t>>(
+    std::move(state), std::move(readers), docs_count, docs_max);
+}
+
 bool index_writer::start() {
   assert(!commit_lock_.try_lock()); // already locked
 
@@ -2419,6 +2547,24 @@ bool index_writer::start() {
   auto& dir = *to_commit.ctx->dir_;
   auto& pending_meta = *to_commit.meta;
 
+  // segments flushed by nrt_reader() have never been synced
+  if (!unsynced_segments_.empty()) {
+    absl::flat_hash_set<size_t> synced; // segments already fully synced
+
+    for (auto& entry : to_commit.to_sync.segments) {
+      if (!entry.second) {
+        synced.emplace(entry.first);
+      }
+    }
+
+    for (size_t i = 0, size = pending_meta.size(); i < size; ++i) {
+      if (!synced.contains(i)
+          && unsynced_segments_.contains(pending_meta[i].meta.name)) {
+        to_commit.to_sync.register_full_sync(i);
+      }
+    }
+  }
+
   // write 1st phase of index_meta transaction
   if (!writer_->prepare(dir, pending_meta)) {
     throw illegal_state();
@@ -2472,6 +2618,11 @@ bool index_writer::start() {
   cached_readers_.purge(to_commit.ctx->segment_mask_); // release cached readers
   pending_state_.ctx = std::move(to_commit.ctx);
 
+  // flushed state is now a part of the pending commit
+  flushed_state_.reset();
+  unsynced_segments_.clear();
+  flushed_tick_ = 0;
+
   return true;
 }
 
@@ -2520,8 +2671,8 @@ void index_writer::finish() {
 void index_writer::abort() {
   assert(!commit_lock_.try_lock()); // already locked
 
-  if (!pending_state_) {
-    // there is no open transaction
+  if (!pending_state_ && !flushed_state_) {
+    // there is no open transaction and nothing flushed by nrt_reader()
     return;
   }
 
@@ -2529,9 +2680,16 @@ void index_writer::abort() {
   // all functions below are noexcept
   // ...........................................................................
 
-  // guarded by commit_lock_
-  writer_->rollback();
-  pending_state_.reset();
+  if (pending_state_) {
+    // guarded by commit_lock_
+    writer_->rollback();
+    pending_state_.reset();
+  }
+
+  // segments flushed by nrt_reader() are discarded as well
+  flushed_state_.reset();
+  unsynced_segments_.clear();
+  flushed_tick_ = 0;
 
   // reset actual meta, note that here we don't change
   // segment counters since it can be changed from insert function
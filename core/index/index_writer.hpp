@@ -457,6 +457,21 @@ class IRESEARCH_API index_writer
     ////////////////////////////////////////////////////////////////////////////
     const comparer* comparator{nullptr};
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief thread pool used by consolidation to write columns and field
+    ///        term data of a merged segment concurrently, must outlive writer
+    ///        nullptr == write merged segment sequentially
+    ////////////////////////////////////////////////////////////////////////////
+    async_utils::thread_pool* merge_pool{nullptr};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief postings of a term of a field without frequencies occurring in
+    ///        at least this fraction of segment documents are stored as a
+    ///        bitset if supported by the codec, e.g. "1_5ef"
+    ///        0 == never store postings as a bitset
+    ////////////////////////////////////////////////////////////////////////////
+    double dense_postings_threshold{0};
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief number of memory blocks to cache by the internal memory pool
     ///        0 == use default from memory_allocator::global()
@@ -692,6 +707,17 @@ class IRESEARCH_API index_writer
     return modified;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief make all buffered changes visible for the returned reader without
+  ///        committing them, i.e. near-real-time reader
+  /// @return reader over flushed but not yet committed segments
+  ///
+  /// @note flushed changes become durable only upon the next commit(),
+  ///       rollback() discards them along with the other uncommitted changes
+  /// @note segment readers are shared with the writer's reader cache
+  ////////////////////////////////////////////////////////////////////////////
+  index_reader::ptr nrt_reader();
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief clears index writer's reader cache
   ////////////////////////////////////////////////////////////////////////////
@@ -858,8 +884,8 @@ class IRESEARCH_API index_writer
     segment_writer::ptr writer_;
     index_meta::index_segment_t writer_meta_; // the segment_meta this writer was initialized with
 
-    DECLARE_FACTORY(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator);
-    segment_context(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator);
+    DECLARE_FACTORY(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator, double dense_postings_threshold);
+    segment_context(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator, double dense_postings_threshold);
 
     ////////////////////////////////////////////////////////////////////////////
     /// @brief flush current writer state into a materialized segment
@@ -1042,6 +1068,7 @@ class IRESEARCH_API index_writer
     flush_context_ptr ctx{ nullptr, nullptr }; // reference to flush context held until end of commit
     index_meta::ptr meta; // index meta of next commit
     sync_context to_sync; // file names and segments to be synced during next commit
+    uint64_t tick{ 0 }; // tick of last flushed transaction
 
     operator bool() const noexcept { return ctx && meta; }
   }; // pending_context_t
@@ -1074,6 +1101,8 @@ class IRESEARCH_API index_writer
     const comparer* comparator,
     const column_info_provider_t& column_info,
     const payload_provider_t& meta_payload_provider,
+    async_utils::thread_pool* merge_pool,
+    double dense_postings_threshold,
     index_meta&& meta,
     committed_state_t&& committed_state
   );
@@ -1083,6 +1112,7 @@ class IRESEARCH_API index_writer
   flush_context_ptr get_flush_context(bool shared = true);
   active_segment_context get_segment_context(flush_context& ctx); // return a usable segment or a nullptr segment if retry is required (e.g. no free segments available)
 
+  bool flush(); // flushes buffered changes without syncing them
   bool start(); // starts transaction
   void finish(); // finishes transaction
   void abort(); // aborts transaction
@@ -1091,6 +1121,8 @@ class IRESEARCH_API index_writer
   column_info_provider_t column_info_;
   payload_provider_t meta_payload_provider_; // provides payload for new segments
   const comparer* comparator_;
+  async_utils::thread_pool* merge_pool_; // pool for concurrent consolidation (if any)
+  double dense_postings_threshold_; // @see init_options::dense_postings_threshold
   readers_cache cached_readers_; // readers by segment name
   format::ptr codec_;
   std::mutex commit_lock_; // guard for cached_segment_readers_, commit_pool_, meta_ (modification during commit()/defragment()), paylaod_buf_
@@ -1102,6 +1134,9 @@ class IRESEARCH_API index_writer
   std::atomic<flush_context*> flush_context_; // currently active context accumulating data to be processed during the next flush
   index_meta meta_; // latest/active state of index metadata
   pending_state_t pending_state_; // current state awaiting commit completion
+  committed_state_t flushed_state_; // state flushed by nrt_reader() since last commit, guarded by commit_lock_
+  absl::flat_hash_set<std::string> unsynced_segments_; // names of segments flushed by nrt_reader() to be synced by next commit, guarded by commit_lock_
+  uint64_t flushed_tick_{ 0 }; // tick of last transaction flushed by nrt_reader(), guarded by commit_lock_
   segment_limits segment_limits_; // limits for use with respect to segments
   segment_pool_t segment_writer_pool_; // a cache of segments available for reuse
   std::atomic<size_t> segments_active_; // number of segments currently in use by the writer
@@ -32,6 +32,7 @@
 #include "index/segment_reader.hpp"
 #include "index/heap_iterator.hpp"
 #include "index/comparer.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/lz4compression.hpp"
@@ -41,6 +42,8 @@
 #include "store/store_utils.hpp"
 
 #include <array>
+#include <future>
+#include <thread>
 
 #include <boost/iterator/filter_iterator.hpp>
 
@@ -193,6 +196,7 @@ struct compound_doc_iterator : public irs::doc_iterator {
 
     current_id = irs::doc_limits::invalid();
     current_itr = 0;
+    origin.source = nullptr;
 
     return true;
   }
@@ -202,6 +206,10 @@ struct compound_doc_iterator : public irs::doc_iterator {
   }
 
   virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<irs::postings_origin>::id() == type) {
+      return origin.source ? &origin : nullptr;
+    }
+
     return irs::type<irs::attribute_provider_change>::id() == type
       ? &attribute_change
       : nullptr;
@@ -219,6 +227,7 @@ struct compound_doc_iterator : public irs::doc_iterator {
   }
 
   irs::attribute_provider_change attribute_change;
+  irs::postings_origin origin; // set if all docs come from a single iterator
   std::vector<doc_iterator_t> iterators;
   irs::doc_id_t current_id{ irs::doc_limits::invalid() };
   size_t current_itr{ 0 };
@@ -267,6 +276,19 @@ bool compound_doc_iterator::next() {
   return false;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @struct merged_doc_order
+/// @brief order of documents in a merged sorted segment, i.e. index of the
+///        source segment for each document of the merged segment
+//////////////////////////////////////////////////////////////////////////////
+struct merged_doc_order {
+  // compact representation limits the number of merged segments
+  static constexpr size_t MAX_SEGMENTS = size_t(1) + std::numeric_limits<uint16_t>::max();
+
+  std::vector<uint16_t> segments; // source segment for each merged document
+  size_t count{}; // number of merged segments, 0 if order is not available
+}; // merged_doc_order
+
 //////////////////////////////////////////////////////////////////////////////
 /// @struct sorting_compound_doc_iterator
 /// @brief iterator over sorted doc_ids for a term over all readers
@@ -274,19 +296,31 @@ bool compound_doc_iterator::next() {
 class sorting_compound_doc_iterator : public irs::doc_iterator {
  public:
   explicit sorting_compound_doc_iterator(
-      compound_doc_iterator& doc_it
-  ) noexcept
+      compound_doc_iterator& doc_it,
+      const merged_doc_order* order = nullptr) noexcept
     : doc_it_(&doc_it),
-      heap_it_(min_heap_context(doc_it.iterators)) {
+      order_(order),
+      heap_it_(min_heap_context(doc_it.iterators, ids_)) {
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param dense if set, denotes (once 'func' is executed) that every iterator
+  ///        covers all documents of its segment, documents are then emitted in
+  ///        the merged order without maintaining a heap
+  //////////////////////////////////////////////////////////////////////////////
   template<typename Func>
-  bool reset(Func func) {
+  bool reset(Func func, const bool* dense = nullptr) {
     if (!doc_it_->reset(func)) {
       return false;
     }
 
-    heap_it_.reset(doc_it_->iterators.size());
+    // merged order is applicable only if all of the segments are visited
+    ordered_ = dense && *dense
+      && order_ && order_->count
+      && doc_it_->iterators.size() == order_->count;
+
+    ids_.assign(doc_it_->iterators.size(), irs::doc_limits::invalid());
+    heap_it_.reset(ordered_ ? 0 : doc_it_->iterators.size());
     lead_ = nullptr;
 
     return true;
@@ -310,41 +344,53 @@ class sorting_compound_doc_iterator : public irs::doc_iterator {
  private:
   class min_heap_context {
    public:
-    explicit min_heap_context(compound_doc_iterator::iterators_t& itrs) noexcept
-      : itrs_(itrs) {
+    explicit min_heap_context(
+        compound_doc_iterator::iterators_t& itrs,
+        std::vector<irs::doc_id_t>& ids) noexcept
+      : itrs_(&itrs), ids_(&ids) {
     }
 
     // advance
     bool operator()(const size_t i) const {
-      assert(i < itrs_.get().size());
-      auto& doc_it = itrs_.get()[i];
-      auto const& map = *doc_it.second;
-      while (doc_it.first->next()) {
-        if (!irs::doc_limits::eof(map(doc_it.first->value()))) {
-          return true;
-        }
-      }
-      return false;
+      assert(i < itrs_->size());
+      assert(i < ids_->size());
+      return advance((*itrs_)[i], (*ids_)[i]);
     }
 
     // compare
     bool operator()(const size_t lhs, const size_t rhs) const {
-      return remap(lhs) > remap(rhs);
+      // mapped doc ids are cached to avoid 'doc_map' calls on each comparison
+      return (*ids_)[lhs] > (*ids_)[rhs];
     }
 
    private:
-    irs::doc_id_t remap(const size_t i) const {
-      assert(i < itrs_.get().size());
-      auto& doc_it = itrs_.get()[i];
-      return (*doc_it.second)(doc_it.first->value());
+    compound_doc_iterator::iterators_t* itrs_;
+    std::vector<irs::doc_id_t>* ids_;
+  }; // min_heap_context
+
+  // advances a specified iterator to the next live document
+  static bool advance(compound_doc_iterator::doc_iterator_t& doc_it, irs::doc_id_t& id) {
+    auto const& map = *doc_it.second;
+    while (doc_it.first->next()) {
+      id = map(doc_it.first->value());
+
+      if (!irs::doc_limits::eof(id)) {
+        return true;
+      }
     }
 
-    std::reference_wrapper<compound_doc_iterator::iterators_t> itrs_;
-  }; // min_heap_context
+    id = irs::doc_limits::eof();
+    return false;
+  }
+
+  bool next_ordered();
 
   compound_doc_iterator* doc_it_;
+  const merged_doc_order* order_;
+  std::vector<irs::doc_id_t> ids_; // current mapped doc id of each iterator
   irs::external_heap_iterator<min_heap_context> heap_it_;
   compound_doc_iterator::doc_iterator_t* lead_{};
+  bool ordered_{ false }; // use 'order_' instead of 'heap_it_'
 }; // sorting_compound_doc_iterator
 
 bool sorting_compound_doc_iterator::next() {
@@ -359,22 +405,22 @@ bool sorting_compound_doc_iterator::next() {
     return false;
   }
 
-  while (heap_it_.next()) {
-    auto& new_lead = iterators[heap_it_.value()];
-    auto& it = new_lead.first;
-    auto& doc_map = *new_lead.second;
+  if (ordered_) {
+    return next_ordered();
+  }
+
+  if (heap_it_.next()) {
+    const auto i = heap_it_.value();
+    auto& new_lead = iterators[i];
 
     if (&new_lead != lead_) {
       // update attributes
-      doc_it_->attribute_change(*it);
+      doc_it_->attribute_change(*new_lead.first);
       lead_ = &new_lead;
     }
 
-    current_id = doc_map(it->value());
-
-    if (irs::doc_limits::eof(current_id)) {
-      continue;
-    }
+    current_id = ids_[i];
+    assert(!irs::doc_limits::eof(current_id));
 
     return true;
   }
@@ -384,6 +430,46 @@ bool sorting_compound_doc_iterator::next() {
   return false;
 }
 
+bool sorting_compound_doc_iterator::next_ordered() {
+  auto& iterators = doc_it_->iterators;
+  auto& current_id = doc_it_->current_id;
+  const auto& segments = order_->segments;
+
+  const size_t pos = irs::doc_limits::valid(current_id)
+    ? current_id - irs::doc_limits::min() + 1
+    : 0;
+
+  if (pos >= segments.size()) {
+    current_id = irs::doc_limits::eof();
+    return false;
+  }
+
+  const auto i = segments[pos];
+  assert(i < iterators.size());
+  auto& new_lead = iterators[i];
+
+  if (!advance(new_lead, ids_[i])
+      || ids_[i] != irs::doc_id_t(pos + irs::doc_limits::min())) {
+    // must not happen for a dense iterator
+    IR_FRMT_ERROR(
+      "Unexpected document order while merging segment " IR_SIZE_T_SPECIFIER,
+      size_t(i));
+
+    current_id = irs::doc_limits::eof();
+    return false;
+  }
+
+  if (&new_lead != lead_) {
+    // update attributes
+    doc_it_->attribute_change(*new_lead.first);
+    lead_ = &new_lead;
+  }
+
+  current_id = ids_[i];
+
+  return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @struct compound_iterator
 //////////////////////////////////////////////////////////////////////////////
@@ -395,9 +481,10 @@ class compound_iterator {
   size_t size() const { return iterators_.size(); }
 
   void add(const irs::sub_reader& reader,
-           const doc_map_f& doc_map) {
+           const doc_map_f& doc_map,
+           irs::doc_id_t doc_base = irs::doc_limits::eof()) {
     iterator_mask_.emplace_back(iterators_.size());
-    iterators_.emplace_back(reader.columns(), reader, doc_map);
+    iterators_.emplace_back(reader.columns(), reader, doc_map, doc_base);
   }
 
   // visit matched iterators
@@ -405,7 +492,7 @@ class compound_iterator {
   bool visit(const Visitor& visitor) const {
     for (auto id : iterator_mask_) {
       auto& it = iterators_[id];
-      if (!visitor(*it.reader, *it.doc_map, it.it->value())) {
+      if (!visitor(*it.reader, *it.doc_map, it.it->value(), it.doc_base)) {
         return false;
       }
     }
@@ -466,10 +553,12 @@ class compound_iterator {
     iterator_t(
         Iterator&& it,
         const irs::sub_reader& reader,
-        const doc_map_f& doc_map)
+        const doc_map_f& doc_map,
+        irs::doc_id_t doc_base)
       : it(std::move(it)),
         reader(&reader), 
-        doc_map(&doc_map) {
+        doc_map(&doc_map),
+        doc_base(doc_base) {
       }
 
     iterator_t(iterator_t&&) = default;
@@ -478,6 +567,7 @@ class compound_iterator {
     Iterator it;
     const irs::sub_reader* reader;
     const doc_map_f* doc_map;
+    irs::doc_id_t doc_base; // offset of doc_ids if 'doc_map' is a shift, eof() otherwise
   };
 
   static_assert(std::is_nothrow_move_constructible_v<iterator_t>);
@@ -516,7 +606,10 @@ class compound_term_iterator : public irs::term_iterator {
   }
 
   const irs::field_meta& meta() const noexcept { return *meta_; }
-  void add(const irs::term_reader& reader, const doc_map_f& doc_map);
+  void add(
+    const irs::term_reader& reader,
+    const doc_map_f& doc_map,
+    irs::doc_id_t doc_base);
   virtual irs::attribute* get_mutable(irs::type_info::type_id) noexcept override {
     // no way to merge attributes for the same term spread over multiple iterators
     // would require API change for attributes
@@ -539,11 +632,13 @@ class compound_term_iterator : public irs::term_iterator {
   struct term_iterator_t {
     irs::seek_term_iterator::ptr first;
     const doc_map_f* second;
+    irs::doc_id_t doc_base; // see 'merge_writer::reader_ctx::doc_base'
 
     term_iterator_t(
         irs::seek_term_iterator::ptr&& term_itr,
-        const doc_map_f* doc_map)
-      : first(std::move(term_itr)), second(doc_map) {
+        const doc_map_f* doc_map,
+        irs::doc_id_t doc_base)
+      : first(std::move(term_itr)), second(doc_map), doc_base(doc_base) {
     }
 
     // GCC 8.1.0/8.2.0 optimized code requires an *explicit* noexcept non-inlined
@@ -551,7 +646,9 @@ class compound_term_iterator : public irs::term_iterator {
     // optimized out (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=87665)
     GCC8_12_OPTIMIZED_WORKAROUND(__attribute__((noinline)))
     term_iterator_t(term_iterator_t&& other) noexcept
-      : first(std::move(other.first)), second(std::move(other.second)) {
+      : first(std::move(other.first)),
+        second(std::move(other.second)),
+        doc_base(other.doc_base) {
     }
   };
 
@@ -570,9 +667,10 @@ class compound_term_iterator : public irs::term_iterator {
 
 void compound_term_iterator::add(
     const irs::term_reader& reader,
-    const doc_map_f& doc_id_map) {
+    const doc_map_f& doc_id_map,
+    irs::doc_id_t doc_base) {
   term_iterator_mask_.emplace_back(term_iterators_.size()); // mark as used to trigger next()
-  term_iterators_.emplace_back(reader.iterator(), &doc_id_map);
+  term_iterators_.emplace_back(reader.iterator(), &doc_id_map, doc_base);
 }
 
 bool compound_term_iterator::next() {
@@ -643,6 +741,18 @@ irs::doc_iterator::ptr compound_term_iterator::postings(const irs::flags& /*feat
     }
   } else {
     doc_itr_.reset(add_iterators);
+
+    // postings of a term from a single segment without deleted documents
+    // may be copied by a postings writer without decoding
+    if (1 == term_iterator_mask_.size()) {
+      const auto& term_itr = term_iterators_[term_iterator_mask_.front()];
+
+      if (!irs::doc_limits::eof(term_itr.doc_base)
+          && doc_itr_.iterators.front().first) {
+        doc_itr_.origin.source = doc_itr_.iterators.front().first.get();
+        doc_itr_.origin.doc_base = term_itr.doc_base;
+      }
+    }
   }
 
   return irs::memory::to_managed<irs::doc_iterator, false>(doc_itr);
@@ -663,7 +773,10 @@ class compound_field_iterator : public irs::basic_term_reader {
       progress_(progress, PROGRESS_STEP_FIELDS) {
   }
 
-  void add(const irs::sub_reader& reader, const doc_map_f& doc_id_map);
+  void add(
+    const irs::sub_reader& reader,
+    const doc_map_f& doc_id_map,
+    irs::doc_id_t doc_base = irs::doc_limits::eof());
   bool next();
   size_t size() const { return field_iterators_.size(); }
 
@@ -672,7 +785,7 @@ class compound_field_iterator : public irs::basic_term_reader {
   bool visit(const Visitor& visitor) const {
     for (auto& entry : field_iterator_mask_) {
       auto& itr = field_iterators_[entry.itr_id];
-      if (!visitor(*itr.reader, *itr.doc_map, *entry.meta)) {
+      if (!visitor(*itr.reader, *itr.doc_map, *entry.meta, itr.doc_base)) {
         return false;
       }
     }
@@ -707,10 +820,12 @@ class compound_field_iterator : public irs::basic_term_reader {
     field_iterator_t(
         irs::field_iterator::ptr&& itr,
         const irs::sub_reader& reader,
-        const doc_map_f& doc_map)
+        const doc_map_f& doc_map,
+        irs::doc_id_t doc_base)
       : itr(std::move(itr)),
         reader(&reader),
-        doc_map(&doc_map) {
+        doc_map(&doc_map),
+        doc_base(doc_base) {
     }
 
     field_iterator_t(field_iterator_t&&) = default;
@@ -719,6 +834,7 @@ class compound_field_iterator : public irs::basic_term_reader {
     irs::field_iterator::ptr itr;
     const irs::sub_reader* reader;
     const doc_map_f* doc_map;
+    irs::doc_id_t doc_base;
   };
 
   static_assert(std::is_nothrow_move_constructible_v<field_iterator_t>);
@@ -743,7 +859,8 @@ typedef compound_iterator<irs::column_iterator::ptr> compound_column_meta_iterat
 
 void compound_field_iterator::add(
     const irs::sub_reader& reader,
-    const doc_map_f& doc_id_map) {
+    const doc_map_f& doc_id_map,
+    irs::doc_id_t doc_base /*= irs::doc_limits::eof()*/) {
   field_iterator_mask_.emplace_back(term_iterator_t{
     field_iterators_.size(),
     nullptr,
@@ -752,8 +869,9 @@ void compound_field_iterator::add(
 
   field_iterators_.emplace_back(
     reader.fields(),
-    reader, 
-    doc_id_map
+    reader,
+    doc_id_map,
+    doc_base
   );
 }
 
@@ -824,7 +942,9 @@ irs::term_iterator::ptr compound_field_iterator::iterator() const {
   term_itr_.reset(meta());
 
   for (auto& segment : field_iterator_mask_) {
-    term_itr_.add(*(segment.reader), *(field_iterators_[segment.itr_id].doc_map));
+    auto& field_itr = field_iterators_[segment.itr_id];
+
+    term_itr_.add(*(segment.reader), *field_itr.doc_map, field_itr.doc_base);
   }
 
   return irs::memory::to_managed<irs::term_iterator, false>(&term_itr_);
@@ -886,11 +1006,13 @@ class columnstore {
     writer_ = std::move(writer);
   }
 
-  // inserts live values from the specified 'column' and 'reader' into column
+  // inserts live values from the specified 'column' and 'reader' into column,
+  // encoded values are copied as is if 'doc_map' is a shift by 'doc_base'
   bool insert(
       const irs::sub_reader& reader,
       irs::field_id column,
-      const doc_map_f& doc_map) {
+      const doc_map_f& doc_map,
+      irs::doc_id_t doc_base = irs::doc_limits::eof()) {
     const auto* column_reader = reader.column_reader(column);
 
     if (!column_reader) {
@@ -898,6 +1020,21 @@ class columnstore {
       return true;
     }
 
+    if (!irs::doc_limits::eof(doc_base) && column_reader->size()) {
+      if (!progress_()) {
+        // stop was requsted
+        return false;
+      }
+
+      auto it = column_reader->iterator();
+      assert(it);
+
+      if (writer_->copy(column_.first, *it, doc_base)) {
+        empty_ = false;
+        return true;
+      }
+    }
+
     return column_reader->visit(
       [this, &doc_map](irs::doc_id_t doc, const irs::bytes_ref& in) {
         if (!progress_()) {
@@ -1077,21 +1214,26 @@ bool write_columns(
   assert(cs);
   assert(progress);
 
-  auto add_iterators = [&column_meta_itr](compound_doc_iterator::iterators_t& itrs) {
-    auto add_iterators = [&itrs](
+  bool dense = false; // every visited column has all segment documents
+
+  auto add_iterators = [&column_meta_itr, &dense](compound_doc_iterator::iterators_t& itrs) {
+    auto add_iterators = [&itrs, &dense](
         const irs::sub_reader& segment,
         const doc_map_f& doc_map,
-        const irs::column_meta& column) {
+        const irs::column_meta& column,
+        irs::doc_id_t /*doc_base*/) {
       auto* reader = segment.column_reader(column.id);
 
       if (!reader) {
         return false;
       }
 
+      dense &= (reader->size() == segment.docs_count());
       itrs.emplace_back(reader->iterator(), &doc_map);
       return true;
     };
 
+    dense = true;
     itrs.clear();
     return column_meta_itr.visit(add_iterators);
   };
@@ -1105,7 +1247,7 @@ bool write_columns(
 
     // visit matched columns from merging segments and
     // write all survived values to the new segment
-    if (!progress() || !columns.reset(add_iterators)) {
+    if (!progress() || !columns.reset(add_iterators, &dense)) {
       return false; // failed to visit all values
     }
 
@@ -1140,8 +1282,9 @@ bool write_columns(
   auto visitor = [&cs](
       const irs::sub_reader& segment,
       const doc_map_f& doc_map,
-      const irs::column_meta& column) {
-    return cs.insert(segment, column.id, doc_map);
+      const irs::column_meta& column,
+      irs::doc_id_t doc_base) {
+    return cs.insert(segment, column.id, doc_map, doc_base);
   };
 
   auto cmw = meta.codec->get_column_meta_writer();
@@ -1168,6 +1311,34 @@ bool write_columns(
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief merge norms of the field currently pointed by 'field_itr' into
+///        a new column of the specified columnstore
+//////////////////////////////////////////////////////////////////////////////
+bool write_norms(
+    columnstore& cs,
+    compound_field_iterator& field_itr,
+    const irs::merge_writer::flush_progress_t& progress) {
+  auto merge_norms = [&cs] (
+      const irs::sub_reader& segment,
+      const doc_map_f& doc_map,
+      const irs::field_meta& field,
+      irs::doc_id_t doc_base) {
+    // merge field norms if present
+    if (irs::field_limits::valid(field.norm)
+        && !cs.insert(segment, field.norm, doc_map, doc_base)) {
+      return false;
+    }
+
+    return true;
+  };
+
+  cs.reset(NORM_COLUMN); // FIXME encoder for norms???
+
+  // remap merge norms
+  return progress() && field_itr.visit(merge_norms);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief write field term data
 //////////////////////////////////////////////////////////////////////////////
@@ -1177,6 +1348,7 @@ bool write_fields(
     const irs::segment_meta& meta,
     compound_field_iterator& field_itr,
     const irs::flags& fields_features,
+    double dense_postings_threshold,
     const irs::merge_writer::flush_progress_t& progress
 ) {
   REGISTER_TIMER_DETAILED();
@@ -1187,31 +1359,16 @@ bool write_fields(
   flush_state.doc_count = meta.docs_count;
   flush_state.features = &fields_features;
   flush_state.name = meta.name;
+  flush_state.dense_postings_threshold = dense_postings_threshold;
 
   auto field_writer = meta.codec->get_field_writer(true);
   field_writer->prepare(flush_state);
 
-  auto merge_norms = [&cs] (
-      const irs::sub_reader& segment,
-      const doc_map_f& doc_map,
-      const irs::field_meta& field) {
-    // merge field norms if present
-    if (irs::field_limits::valid(field.norm)
-        && !cs.insert(segment, field.norm, doc_map)) {
-      return false;
-    }
-
-    return true;
-  };
-
   while (field_itr.next()) {
-    cs.reset(NORM_COLUMN); // FIXME encoder for norms???
-
     auto& field_meta = field_itr.meta();
     auto& field_features = field_meta.features;
 
-    // remap merge norms
-    if (!progress() || !field_itr.visit(merge_norms)) {
+    if (!write_norms(cs, field_itr, progress)) {
       return false;
     }
 
@@ -1243,6 +1400,7 @@ bool write_fields(
     const irs::segment_meta& meta,
     compound_field_iterator& field_itr,
     const irs::flags& fields_features,
+    double dense_postings_threshold,
     const irs::merge_writer::flush_progress_t& progress
 ) {
   REGISTER_TIMER_DETAILED();
@@ -1253,15 +1411,19 @@ bool write_fields(
   flush_state.doc_count = meta.docs_count;
   flush_state.features = &fields_features;
   flush_state.name = meta.name;
+  flush_state.dense_postings_threshold = dense_postings_threshold;
 
   auto field_writer = meta.codec->get_field_writer(true);
   field_writer->prepare(flush_state);
 
-  auto add_iterators = [&field_itr](compound_doc_iterator::iterators_t& itrs) {
-    auto add_iterators = [&itrs](
+  bool dense = false; // every visited norm column has all segment documents
+
+  auto add_iterators = [&field_itr, &dense](compound_doc_iterator::iterators_t& itrs) {
+    auto add_iterators = [&itrs, &dense](
         const irs::sub_reader& segment,
         const doc_map_f& doc_map,
-        const irs::field_meta& field) {
+        const irs::field_meta& field,
+        irs::doc_id_t /*doc_base*/) {
       if (!irs::field_limits::valid(field.norm)) {
         // field has no norms
         return true;
@@ -1273,22 +1435,24 @@ bool write_fields(
         return false;
       }
 
+      dense &= (reader->size() == segment.docs_count());
       itrs.emplace_back(reader->iterator(), &doc_map);
       return true;
     };
 
+    dense = true;
     itrs.clear();
     return field_itr.visit(add_iterators);
   };
 
   while (field_itr.next()) {
-    cs.reset(NORM_COLUMN); // FIXME encoder for norms???
+    cs.reset(NORM_COLUMN); // see write_norms(...)
 
     auto& field_meta = field_itr.meta();
     auto& field_features = field_meta.features;
 
     // remap merge norms
-    if (!progress() || !norms.reset(add_iterators)) {
+    if (!progress() || !norms.reset(add_iterators, &dense)) {
       return false;
     }
 
@@ -1313,6 +1477,218 @@ bool write_fields(
   return !field_itr.aborted();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class concurrent_progress
+/// @brief progress callback shared by concurrently running merge tasks, the
+///        user callback is called only by the thread which created the
+///        instance while other threads observe the termination it requested,
+///        termination requested via one of the tasks is observed by all of
+///        them
+//////////////////////////////////////////////////////////////////////////////
+class concurrent_progress : irs::util::noncopyable {
+ public:
+  explicit concurrent_progress(
+      const irs::merge_writer::flush_progress_t& progress) noexcept
+    : progress_(&progress),
+      owner_(std::this_thread::get_id()) {
+    assert(progress);
+  }
+
+  bool operator()() {
+    if (aborted_.load()) {
+      return false;
+    }
+
+    if (std::this_thread::get_id() == owner_ && !(*progress_)()) {
+      aborted_.store(true);
+    }
+
+    return !aborted_.load();
+  }
+
+  void abort() noexcept {
+    aborted_.store(true);
+  }
+
+ private:
+  const irs::merge_writer::flush_progress_t* progress_;
+  const std::thread::id owner_;
+  std::atomic<bool> aborted_{ false };
+}; // concurrent_progress
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write field norms, ahead of field term data
+/// @param norms[out] norm column identifier for every merged field
+//////////////////////////////////////////////////////////////////////////////
+bool write_norms(
+    columnstore& cs,
+    compound_field_iterator& field_itr,
+    std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress) {
+  REGISTER_TIMER_DETAILED();
+  assert(cs);
+
+  while (field_itr.next()) {
+    if (!write_norms(cs, field_itr, progress)) {
+      return false;
+    }
+
+    norms.emplace_back(cs.empty() ? irs::field_limits::invalid() : cs.id());
+  }
+
+  return !field_itr.aborted();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write field term data using norms computed by 'write_norms'
+/// @note 'field_writer' is expected to be prepared already, so no files are
+///       created by the function and it may be run concurrently with
+///       other writers of the same segment
+//////////////////////////////////////////////////////////////////////////////
+bool write_terms(
+    irs::field_writer& field_writer,
+    compound_field_iterator& field_itr,
+    const std::vector<irs::field_id>& norms) {
+  REGISTER_TIMER_DETAILED();
+
+  size_t i = 0;
+
+  while (field_itr.next()) {
+    if (i >= norms.size()) {
+      return false; // fields mismatch, must not happen
+    }
+
+    auto& field_meta = field_itr.meta();
+
+    // write field terms
+    auto terms = field_itr.iterator();
+
+    field_writer.write(field_meta.name, norms[i++], field_meta.features, *terms);
+  }
+
+  field_writer.end();
+
+  return !field_itr.aborted() && i == norms.size();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write merged segment data, columns and field term data are written
+///        concurrently to their own outputs, columns by the calling thread and
+///        field term data by a task submitted to the specified 'pool', the
+///        calling thread writes field term data itself once it's done with
+///        columns unless the pool has already started the task
+//////////////////////////////////////////////////////////////////////////////
+bool write_concurrent(
+    irs::async_utils::thread_pool& pool,
+    irs::directory& dir,
+    const irs::column_info_provider_t& column_info,
+    irs::segment_meta& meta,
+    const std::vector<irs::merge_writer::reader_ctx>& readers,
+    const irs::flags& fields_features,
+    double dense_postings_threshold,
+    compound_column_meta_iterator_t& columns_meta_itr,
+    const irs::merge_writer::flush_progress_t& progress) {
+  REGISTER_TIMER_DETAILED();
+
+  concurrent_progress shared_progress(progress);
+  const irs::merge_writer::flush_progress_t progress_callback = [&shared_progress]() {
+    return shared_progress();
+  };
+
+  // norms and term data are written in separate passes over fields
+  compound_field_iterator norms_itr(progress_callback);
+  compound_field_iterator terms_itr(progress_callback);
+
+  for (auto& reader_ctx : readers) {
+    norms_itr.add(*reader_ctx.reader, reader_ctx.doc_map, reader_ctx.doc_base);
+    terms_itr.add(*reader_ctx.reader, reader_ctx.doc_map, reader_ctx.doc_base);
+  }
+
+  columnstore cs(dir, meta, progress_callback);
+
+  if (!cs) {
+    return false; // flush failure
+  }
+
+  // norm identifiers are stored along with field term data,
+  // so write norms first
+  std::vector<irs::field_id> norms;
+
+  if (!write_norms(cs, norms_itr, norms, progress_callback)) {
+    return false; // flush failure
+  }
+
+  // all files are created by the calling thread, tracking directory
+  // isn't thread-safe
+  irs::flush_state flush_state;
+  flush_state.dir = &dir;
+  flush_state.doc_count = meta.docs_count;
+  flush_state.features = &fields_features;
+  flush_state.name = meta.name;
+  flush_state.dense_postings_threshold = dense_postings_threshold;
+
+  auto field_writer = meta.codec->get_field_writer(true);
+  field_writer->prepare(flush_state);
+
+  // the task is executed either by the pool or by the calling thread,
+  // whichever claims it first, so the calling thread never waits for
+  // a task stuck in the queue of a saturated pool, e.g. the one running
+  // the merge itself
+  struct terms_task {
+    void operator()() {
+      if (!claimed.exchange(true)) {
+        impl();
+      }
+    }
+
+    std::atomic<bool> claimed{ false };
+    std::packaged_task<bool()> impl;
+  };
+
+  // task might outlive this scope in the pool queue
+  auto task = std::make_shared<terms_task>();
+  task->impl = std::packaged_task<bool()>([&field_writer, &terms_itr, &norms]() {
+    return write_terms(*field_writer, terms_itr, norms);
+  });
+  auto terms_written = task->impl.get_future();
+
+  if (!pool.run([task]() { (*task)(); })) {
+    (*task)(); // pool isn't running, write sequentially
+  }
+
+  // ensure task is finished before leaving the scope
+  auto wait_terms = irs::make_finally([&shared_progress, &task, &terms_written]() noexcept {
+    if (terms_written.valid()) {
+      shared_progress.abort();
+      (*task)(); // terminates immediately if not started yet
+      terms_written.wait();
+    }
+  });
+
+  const bool columns_written = write_columns(
+    cs, dir, column_info, meta, columns_meta_itr, progress_callback);
+
+  if (!columns_written) {
+    shared_progress.abort(); // notify term writer
+  }
+
+  (*task)(); // write terms unless already picked up by the pool
+
+  if (!terms_written.get() || !columns_written) {
+    return false; // flush failure
+  }
+
+  field_writer.reset();
+
+  if (!progress_callback()) {
+    return false; // progress callback requested termination
+  }
+
+  meta.column_store = cs.flush();
+
+  return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief computes doc_id_map and docs_count
 //////////////////////////////////////////////////////////////////////////////
@@ -1364,7 +1740,9 @@ merge_writer::reader_ctx::reader_ctx(irs::sub_reader::ptr reader) noexcept
 merge_writer::merge_writer() noexcept
   : dir_(noop_directory::instance()),
     column_info_(nullptr),
-    comparator_(nullptr) {
+    comparator_(nullptr),
+    pool_(nullptr),
+    dense_postings_threshold_(0) {
 }
 
 merge_writer::operator bool() const noexcept {
@@ -1399,9 +1777,11 @@ bool merge_writer::flush(
       reader_ctx.doc_map = [reader_base](doc_id_t doc) noexcept {
         return reader_base + doc;
       };
+      reader_ctx.doc_base = reader_base;
     } else { // segment has some deleted docs
       auto& doc_id_map = reader_ctx.doc_id_map;
       base_id = compute_doc_ids(doc_id_map , reader, base_id);
+      reader_ctx.doc_base = irs::doc_limits::eof();
 
       reader_ctx.doc_map = [&doc_id_map](doc_id_t doc) noexcept {
         return doc >= doc_id_map.size()
@@ -1418,8 +1798,8 @@ bool merge_writer::flush(
       return false;
     }
 
-    fields_itr.add(reader, reader_ctx.doc_map);
-    columns_meta_itr.add(reader, reader_ctx.doc_map);
+    fields_itr.add(reader, reader_ctx.doc_map, reader_ctx.doc_base);
+    columns_meta_itr.add(reader, reader_ctx.doc_map, reader_ctx.doc_base);
   }
 
   segment.meta.docs_count = base_id - irs::doc_limits::min(); // total number of doc_ids
@@ -1429,6 +1809,13 @@ bool merge_writer::flush(
     return false; // progress callback requested termination
   }
 
+  if (pool_) {
+    return write_concurrent(
+      *pool_, dir, *column_info_, segment.meta,
+      readers_, fields_features, dense_postings_threshold_,
+      columns_meta_itr, progress);
+  }
+
   //...........................................................................
   // write merged segment data
   //...........................................................................
@@ -1453,7 +1840,8 @@ bool merge_writer::flush(
   }
 
   // write field meta and field term data
-  if (!write_fields(cs, dir, segment.meta, fields_itr, fields_features, progress)) {
+  if (!write_fields(cs, dir, segment.meta, fields_itr, fields_features,
+                    dense_postings_threshold_, progress)) {
     return false; // flush failure
   }
 
@@ -1565,6 +1953,15 @@ bool merge_writer::flush_sorted(
   const auto info = (*column_info_)(string_ref::NIL);
   auto column = writer->push_column(info);
 
+  // source segment of each merged document, allows to merge dense
+  // columns without maintaining a heap of per-segment iterators
+  merged_doc_order order;
+
+  if (readers_.size() <= merged_doc_order::MAX_SEGMENTS) {
+    order.count = readers_.size();
+    order.segments.reserve(segment.meta.docs_count);
+  }
+
   irs::doc_id_t next_id = irs::doc_limits::min();
   while (columns_it.next()) {
     const auto value = columns_it.value();
@@ -1576,6 +1973,10 @@ bool merge_writer::flush_sorted(
     // fill doc id map
     readers_[value.first].doc_id_map[it.first->value()] = next_id;
 
+    if (order.count) {
+      order.segments.emplace_back(static_cast<uint16_t>(value.first));
+    }
+
     // write value into new column
     auto& stream = column.second(next_id);
     stream.write_bytes(payload.c_str(), payload.size());
@@ -1609,7 +2010,7 @@ bool merge_writer::flush_sorted(
 
   columnstore cs(std::move(writer), progress);
   compound_doc_iterator doc_it(progress); // reuse iterator
-  sorting_compound_doc_iterator sorting_doc_it(doc_it); // reuse iterator
+  sorting_compound_doc_iterator sorting_doc_it(doc_it, &order); // reuse iterator
 
   if (!cs) {
     return false; // flush failure
@@ -1629,7 +2030,8 @@ bool merge_writer::flush_sorted(
   }
 
   // write field meta and field term data
-  if (!write_fields(cs, sorting_doc_it, dir, segment.meta, fields_itr, fields_features, progress)) {
+  if (!write_fields(cs, sorting_doc_it, dir, segment.meta, fields_itr,
+                    fields_features, dense_postings_threshold_, progress)) {
     return false; // flush failure
   }
 
@@ -31,8 +31,12 @@
 #include "utils/memory.hpp"
 #include "utils/noncopyable.hpp"
 #include "utils/string.hpp"
+#include "utils/type_limits.hpp"
 
 namespace iresearch {
+namespace async_utils {
+class thread_pool;
+}
 
 struct directory;
 struct tracking_directory;
@@ -50,17 +54,30 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
     sub_reader_ptr reader; // segment reader
     std::vector<doc_id_t> doc_id_map; // FIXME use bitpacking vector
     std::function<doc_id_t(doc_id_t)> doc_map; // mapping function
+    doc_id_t doc_base{ doc_limits::eof() }; // offset of doc_ids if 'doc_map' is a shift, eof() otherwise
   }; // reader_ctx
 
   merge_writer() noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param pool if specified, columns and postings of an unsorted segment
+  ///        are written concurrently using one additional task of the pool,
+  ///        the merging thread writes postings itself if the task hasn't
+  ///        been started by the pool yet, so the pool may be the one
+  ///        running the merge
+  /// @param dense_postings_threshold @see index_writer::init_options
+  //////////////////////////////////////////////////////////////////////////////
   explicit merge_writer(
       directory& dir,
       const column_info_provider_t& column_info,
-      const comparer* comparator = nullptr) noexcept
+      const comparer* comparator = nullptr,
+      async_utils::thread_pool* pool = nullptr,
+      double dense_postings_threshold = 0) noexcept
     : dir_(dir),
       column_info_(&column_info),
-      comparator_(comparator) {
+      comparator_(comparator),
+      pool_(pool),
+      dense_postings_threshold_(dense_postings_threshold) {
     assert(column_info);
   }
 
@@ -85,6 +102,10 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
   /// @brief flush all of the added readers into a single segment
   /// @param segment the segment that was flushed
   /// @param progress report flush progress (abort if 'progress' returns false)
+  /// @note 'progress' is called only by the thread calling 'flush(...)', even
+  ///       if a part of the segment is written by a task of the pool, such
+  ///       a task observes the termination requested by 'progress' and is
+  ///       awaited before returning
   /// @return merge successful
   //////////////////////////////////////////////////////////////////////////////
   bool flush(
@@ -120,6 +141,8 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
   std::vector<reader_ctx> readers_;
   const column_info_provider_t* column_info_;
   const comparer* comparator_;
+  async_utils::thread_pool* pool_;
+  double dense_postings_threshold_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // merge_writer
 
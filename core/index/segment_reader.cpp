@@ -21,6 +21,8 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "shared.hpp"
 #include "segment_reader.hpp"
 
@@ -29,6 +31,7 @@
 #include "index/index_meta.hpp"
 
 #include "formats/format_utils.hpp"
+#include "utils/bitset.hpp"
 #include "utils/hash_set_utils.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/singleton.hpp"
@@ -89,11 +92,64 @@ class all_iterator final : public doc_iterator {
   doc_id_t max_doc_; // largest valid doc_id
 }; // all_iterator
 
+// a sparse document mask is stored as a sorted list of masked documents
+// while a dense one as a bitset, the latter is smaller once more than
+// 1/DENSE_MASK_RATIO of documents are masked
+constexpr size_t DENSE_MASK_RATIO = bits_required<doc_id_t>();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief probes a sorted list of masked documents with non-decreasing ids
+////////////////////////////////////////////////////////////////////////////////
+class sparse_mask {
+ public:
+  explicit sparse_mask(const std::vector<doc_id_t>& mask) noexcept
+    : begin_(mask.data()),
+      next_(begin_),
+      end_(begin_ + mask.size()) {
+  }
+
+  bool contains(doc_id_t doc) noexcept {
+    if (next_ != end_ && *next_ < doc) {
+      next_ = std::lower_bound(next_ + 1, end_, doc);
+    }
+
+    return next_ != end_ && *next_ == doc;
+  }
+
+  void reset() noexcept {
+    next_ = begin_;
+  }
+
+ private:
+  const doc_id_t* begin_;
+  const doc_id_t* next_;
+  const doc_id_t* end_;
+}; // sparse_mask
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief probes a bitset of masked documents
+////////////////////////////////////////////////////////////////////////////////
+class dense_mask {
+ public:
+  explicit dense_mask(const bitset& mask) noexcept
+    : mask_(&mask) {
+  }
+
+  bool contains(doc_id_t doc) const noexcept {
+    return doc < mask_->size() && mask_->test(doc);
+  }
+
+ private:
+  const bitset* mask_;
+}; // dense_mask
+
+template<typename Mask>
 class mask_doc_iterator final : public doc_iterator {
  public:
-  explicit mask_doc_iterator(
+  template<typename MaskData>
+  mask_doc_iterator(
       doc_iterator::ptr&& it,
-      const document_mask& mask) noexcept
+      const MaskData& mask) noexcept
     : mask_(mask), it_(std::move(it))  {
   }
 
@@ -128,10 +184,13 @@ class mask_doc_iterator final : public doc_iterator {
   }
 
  private:
-  const document_mask& mask_; // excluded document ids
+  Mask mask_; // excluded document ids
   doc_iterator::ptr it_;
 }; // mask_doc_iterator
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief iterates over live documents of a segment with a sparse mask
+////////////////////////////////////////////////////////////////////////////////
 class masked_docs_iterator 
     : public doc_iterator,
       private util::noncopyable {
@@ -139,7 +198,7 @@ class masked_docs_iterator
   masked_docs_iterator(
     doc_id_t begin,
     doc_id_t end,
-    const document_mask& docs_mask)
+    const std::vector<doc_id_t>& docs_mask)
   : docs_mask_(docs_mask),
     end_(end),
     next_(begin) {
@@ -160,6 +219,10 @@ class masked_docs_iterator
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
+    if (target < next_) {
+      docs_mask_.reset();
+    }
+
     next_ = target;
     next();
 
@@ -176,10 +239,89 @@ class masked_docs_iterator
 
  private:
   document current_;
-  const document_mask& docs_mask_;
+  sparse_mask docs_mask_;
   const doc_id_t end_; // past last valid doc_id
   doc_id_t next_;
-};
+}; // masked_docs_iterator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief iterates over live documents of a segment with a dense mask,
+///        i.e. over bits of the inverted mask word by word
+////////////////////////////////////////////////////////////////////////////////
+class dense_masked_docs_iterator
+    : public doc_iterator,
+      private util::noncopyable {
+ public:
+  dense_masked_docs_iterator(doc_id_t end, const bitset& docs_mask) noexcept
+    : docs_mask_(docs_mask),
+      end_(end) {
+    assert(docs_mask_.size() <= end_);
+  }
+
+  virtual bool next() override {
+    if (doc_limits::eof(current_.value)) {
+      return false;
+    }
+
+    return !doc_limits::eof(seek(current_.value + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    current_.value = doc_limits::eof();
+
+    if (target >= end_) {
+      return current_.value;
+    }
+
+    auto i = bitset::word(target);
+
+    if (i >= docs_mask_.words()) {
+      // past the last masked document
+      current_.value = target;
+      return current_.value;
+    }
+
+    // live documents not less than target
+    auto word = ~docs_mask_[i] & (~bitset::word_t(0) << bitset::bit(target));
+
+    while (!word) {
+      if (++i >= docs_mask_.words()) {
+        // past the last masked document
+        const auto doc = bitset::bit_offset(i);
+
+        if (doc < end_) {
+          current_.value = doc_id_t(doc);
+        }
+
+        return current_.value;
+      }
+
+      word = ~docs_mask_[i];
+    }
+
+    const auto doc = bitset::bit_offset(i)
+      + math::math_traits<bitset::word_t>::ctz(word);
+
+    if (doc < end_) {
+      current_.value = doc_id_t(doc);
+    }
+
+    return current_.value;
+  }
+
+  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::type<document>::id() == type ? &current_ : nullptr;
+  }
+
+  virtual doc_id_t value() const override {
+    return current_.value;
+  }
+
+ private:
+  document current_;
+  const bitset& docs_mask_;
+  const doc_id_t end_; // past last valid doc_id
+}; // dense_masked_docs_iterator
 
 bool read_columns_meta(
     const format& codec,
@@ -277,11 +419,17 @@ class segment_reader_impl : public sub_reader {
       return nullptr;
     }
 
-    if (docs_mask_.empty()) {
+    if (!docs_mask_size_) {
       return std::move(it);
     }
 
-    return memory::make_managed<mask_doc_iterator>(std::move(it), docs_mask_);
+    if (dense_docs_mask_.size()) {
+      return memory::make_managed<mask_doc_iterator<dense_mask>>(
+        std::move(it), dense_docs_mask_);
+    }
+
+    return memory::make_managed<mask_doc_iterator<sparse_mask>>(
+      std::move(it), sparse_docs_mask_);
   }
 
   virtual const term_reader* field(const string_ref& name) const override {
@@ -293,7 +441,7 @@ class segment_reader_impl : public sub_reader {
   }
 
   virtual uint64_t live_docs_count() const noexcept override {
-    return docs_count_ - docs_mask_.size();
+    return docs_count_ - docs_mask_size_;
   }
 
   uint64_t meta_version() const noexcept {
@@ -324,7 +472,9 @@ class segment_reader_impl : public sub_reader {
   const columnstore_reader::column_reader* sort_{};
   const directory& dir_;
   uint64_t docs_count_;
-  document_mask docs_mask_;
+  size_t docs_mask_size_{}; // number of masked documents
+  bitset dense_docs_mask_; // masked documents if mask is dense
+  std::vector<doc_id_t> sparse_docs_mask_; // sorted masked documents if mask is sparse
   field_reader::ptr field_reader_;
   std::vector<column_meta*> id_to_column_;
   uint64_t meta_version_;
@@ -332,8 +482,9 @@ class segment_reader_impl : public sub_reader {
 
   segment_reader_impl(
     const directory& dir,
-    uint64_t meta_version,
-    uint64_t docs_count);
+    const segment_meta& meta);
+
+  void prepare_docs_mask(bitset&& dense, std::vector<doc_id_t>&& sparse);
 };
 
 segment_reader::segment_reader(impl_ptr&& impl) noexcept
@@ -397,11 +548,10 @@ segment_reader segment_reader::reopen(const segment_meta& meta) const {
 
 segment_reader_impl::segment_reader_impl(
     const directory& dir,
-    uint64_t meta_version,
-    uint64_t docs_count)
+    const segment_meta& meta)
   : dir_(dir),
-    docs_count_(docs_count),
-    meta_version_(meta_version) {
+    docs_count_(meta.docs_count),
+    meta_version_(meta.version) {
 }
 
 const column_meta* segment_reader_impl::column(
@@ -428,30 +578,69 @@ column_iterator::ptr segment_reader_impl::columns() const {
 }
 
 doc_iterator::ptr segment_reader_impl::docs_iterator() const {
-  if (docs_mask_.empty()) {
+  if (!docs_mask_size_) {
     return memory::make_managed<::all_iterator>(docs_count_);
   }
 
+  const auto end = doc_id_t(doc_limits::min() + docs_count_);
+
+  if (dense_docs_mask_.size()) {
+    return memory::make_managed<dense_masked_docs_iterator>(
+      end, dense_docs_mask_);
+  }
+
   // the implementation generates doc_ids sequentially
   return memory::make_managed<masked_docs_iterator>(
-    doc_limits::min(),
-    doc_id_t(doc_limits::min() + docs_count_),
-    docs_mask_);
+    doc_limits::min(), end, sparse_docs_mask_);
+}
+
+void segment_reader_impl::prepare_docs_mask(
+    bitset&& dense,
+    std::vector<doc_id_t>&& sparse) {
+  assert(std::is_sorted(sparse.begin(), sparse.end()));
+
+  if (dense.size()) {
+    assert(sparse.empty());
+    docs_mask_size_ = dense.count();
+    dense_docs_mask_ = std::move(dense);
+    return;
+  }
+
+  docs_mask_size_ = sparse.size();
+
+  if (sparse.empty()) {
+    return;
+  }
+
+  if (sparse.size()*DENSE_MASK_RATIO >= docs_count_) {
+    dense_docs_mask_.reset(size_t(sparse.back()) + 1);
+    for (const auto doc : sparse) {
+      dense_docs_mask_.set(doc);
+    }
+  } else {
+    sparse_docs_mask_ = std::move(sparse);
+  }
 }
 
 /*static*/ sub_reader::ptr segment_reader_impl::open(
     const directory& dir, const segment_meta& meta) {
   auto& codec = *meta.codec;
 
-  PTR_NAMED(segment_reader_impl, reader, dir, meta.version, meta.docs_count);
+  PTR_NAMED(segment_reader_impl, reader, dir, meta);
 
-  // read document mask
-  index_utils::read_document_mask(reader->docs_mask_, dir, meta);
+  // read document mask in its compact form
+  {
+    bitset dense;
+    std::vector<doc_id_t> sparse;
+    index_utils::read_document_mask(dense, sparse, dir, meta);
+    reader->prepare_docs_mask(std::move(dense), std::move(sparse));
+  }
 
-  // initialize mandatory field reader
+  // initialize mandatory field reader, masked documents are filtered out
+  // by 'mask(...)'
   auto& field_reader = reader->field_reader_;
   field_reader = codec.get_field_reader();
-  field_reader->prepare(dir, meta, reader->docs_mask_);
+  field_reader->prepare(dir, meta, document_mask());
 
   // initialize optional columnstore
   if (segment_reader::has<irs::columnstore_reader>(meta)) {
@@ -81,8 +81,10 @@ doc_id_t segment_writer::begin(
 segment_writer::ptr segment_writer::make(
     directory& dir,
     const column_info_provider_t& column_info,
-    const comparer* comparator) {
-  return memory::maker<segment_writer>::make(dir, column_info, comparator);
+    const comparer* comparator,
+    double dense_postings_threshold /*= 0*/) {
+  return memory::maker<segment_writer>::make(
+    dir, column_info, comparator, dense_postings_threshold);
 }
 
 size_t segment_writer::memory_active() const noexcept {
@@ -135,11 +137,13 @@ bool segment_writer::remove(doc_id_t doc_id) {
 segment_writer::segment_writer(
     directory& dir,
     const column_info_provider_t& column_info,
-    const comparer* comparator) noexcept
+    const comparer* comparator,
+    double dense_postings_threshold) noexcept
   : sort_(column_info),
     fields_(comparator),
     column_info_(&column_info),
     dir_(dir),
+    dense_postings_threshold_(dense_postings_threshold),
     initialized_(false) {
 }
 
@@ -237,6 +241,7 @@ void segment_writer::flush_fields(const doc_map& docmap) {
   state.doc_count = docs_cached();
   state.name = seg_name_;
   state.docmap = fields_.comparator() && !docmap.empty() ? &docmap : nullptr;
+  state.dense_postings_threshold = dense_postings_threshold_;
 
   try {
     fields_.flush(*field_writer_, state);
@@ -160,7 +160,8 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   static ptr make(
     directory& dir,
     const column_info_provider_t& column_info,
-    const comparer* comparator);
+    const comparer* comparator,
+    double dense_postings_threshold = 0);
 
   struct update_context {
     size_t generation;
@@ -292,7 +293,8 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   segment_writer(
     directory& dir,
     const column_info_provider_t& column_info,
-    const comparer* comparator) noexcept;
+    const comparer* comparator,
+    double dense_postings_threshold) noexcept;
 
   bool index(
     const hashed_string_ref& name,
@@ -427,6 +429,7 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   column_meta_writer::ptr col_meta_writer_;
   columnstore_writer::ptr col_writer_;
   tracking_directory dir_;
+  double dense_postings_threshold_;
   uint64_t tick_{0};
   bool initialized_;
   bool valid_{ true }; // current state
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "filter_cache.hpp"
+
+#include "index/segment_reader.hpp"
+#include "search/bitset_doc_iterator.hpp"
+#include "utils/bitset.hpp"
+#include "utils/hash_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct doc_set
+/// @brief documents matched by a filter, stored either as a bitset or as
+///        a sorted list of ids depending on what is more compact
+////////////////////////////////////////////////////////////////////////////////
+struct doc_set {
+  using word_t = bitset_doc_iterator::word_t;
+
+  size_t memory() const noexcept {
+    return sizeof(doc_set)
+      + words.capacity()*sizeof(word_t)
+      + docs.capacity()*sizeof(doc_id_t);
+  }
+
+  std::vector<word_t> words; // bitset of matched documents
+  std::vector<doc_id_t> docs; // sorted ids of matched documents
+  bool dense{ false }; // 'words' are used
+}; // doc_set
+
+using doc_set_ptr = std::shared_ptr<const doc_set>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_bitset_iterator
+/// @brief iterator over documents of a dense cached set
+////////////////////////////////////////////////////////////////////////////////
+class cached_bitset_iterator final : public bitset_doc_iterator {
+ public:
+  explicit cached_bitset_iterator(doc_set_ptr&& docs) noexcept
+    : bitset_doc_iterator(
+        docs->words.data(),
+        docs->words.data() + docs->words.size()),
+      docs_(std::move(docs)) {
+  }
+
+ private:
+  doc_set_ptr docs_;
+}; // cached_bitset_iterator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_docs_iterator
+/// @brief iterator over documents of a sparse cached set
+////////////////////////////////////////////////////////////////////////////////
+class cached_docs_iterator final : public doc_iterator {
+ public:
+  explicit cached_docs_iterator(doc_set_ptr&& docs) noexcept
+    : docs_(std::move(docs)),
+      begin_(docs_->docs.data()),
+      end_(begin_ + docs_->docs.size()),
+      cost_(docs_->docs.size()) {
+    assert(std::is_sorted(begin_, end_));
+  }
+
+  virtual attribute* get_mutable(type_info::type_id id) noexcept override {
+    if (type<document>::id() == id) {
+      return &doc_;
+    }
+
+    return type<cost>::id() == id ? &cost_ : nullptr;
+  }
+
+  virtual bool next() noexcept override {
+    if (begin_ == end_) {
+      doc_.value = doc_limits::eof();
+      return false;
+    }
+
+    doc_.value = *begin_++;
+    return true;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) noexcept override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    begin_ = std::lower_bound(begin_, end_, target);
+    next();
+
+    return doc_.value;
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return doc_.value;
+  }
+
+ private:
+  doc_set_ptr docs_;
+  const doc_id_t* begin_;
+  const doc_id_t* end_;
+  document doc_;
+  cost cost_;
+}; // cached_docs_iterator
+
+doc_iterator::ptr make_iterator(doc_set_ptr docs) {
+  assert(docs);
+
+  if (docs->dense) {
+    return memory::make_managed<cached_bitset_iterator>(std::move(docs));
+  }
+
+  return memory::make_managed<cached_docs_iterator>(std::move(docs));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads all documents of a specified iterator into a compact set
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<doc_set> make_doc_set(
+    doc_iterator& it,
+    const sub_reader& segment) {
+  auto docs = std::make_shared<doc_set>();
+  auto* doc = irs::get<document>(it);
+
+  if (!doc) {
+    return nullptr;
+  }
+
+  for (auto& ids = docs->docs; it.next(); ) {
+    ids.push_back(doc->value);
+  }
+
+  using word_t = doc_set::word_t;
+  const size_t num_docs = doc_limits::min() + segment.docs_count();
+  const size_t num_words = bitset::bits_to_words(num_docs);
+
+  if (num_words*sizeof(word_t) < docs->docs.size()*sizeof(doc_id_t)) {
+    // bitset is more compact
+    auto& words = docs->words;
+    words.resize(num_words, 0);
+
+    for (const auto id : docs->docs) {
+      assert(id < num_docs);
+      set_bit(words[id / bits_required<word_t>()], id % bits_required<word_t>());
+    }
+
+    docs->dense = true;
+    std::vector<doc_id_t>().swap(docs->docs);
+  } else {
+    docs->docs.shrink_to_fit();
+  }
+
+  return docs;
+}
+
+}
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       filter_cache implementation
+// -----------------------------------------------------------------------------
+
+struct filter_cache::entry {
+  // tracks lifetime of the segment reader, its address might be
+  // reused by another reader once the former is destroyed
+  std::weak_ptr<const sub_reader> segment_ref;
+  std::shared_ptr<const irs::filter> filter; // referred by the key
+  doc_set_ptr docs;
+}; // entry
+
+size_t filter_cache::key_hash::operator()(const key& value) const noexcept {
+  return hash_combine(
+    std::hash<const sub_reader*>()(value.segment),
+    value.filter_hash);
+}
+
+bool filter_cache::key_equal::operator()(
+    const key& lhs, const key& rhs) const noexcept {
+  assert(lhs.filter && rhs.filter);
+
+  return lhs.filter_hash == rhs.filter_hash
+    && lhs.segment == rhs.segment
+    && (lhs.filter == rhs.filter || *lhs.filter == *rhs.filter);
+}
+
+filter_cache::filter_cache()
+  : filter_cache(options()) {
+}
+
+filter_cache::filter_cache(const options& opts)
+  : opts_(opts),
+    history_(opts.history_size, 0) {
+}
+
+filter_cache::~filter_cache() = default;
+
+bool filter_cache::track(const irs::filter& filter) {
+  if (opts_.min_frequency <= 1 || history_.empty()) {
+    return true;
+  }
+
+  const size_t hash = filter.hash();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const size_t frequency = 1 + size_t(std::count(history_.begin(), history_.end(), hash));
+
+  history_[history_pos_] = hash;
+  history_pos_ = (history_pos_ + 1) % history_.size();
+
+  return frequency >= opts_.min_frequency;
+}
+
+doc_iterator::ptr filter_cache::execute(
+    const sub_reader& segment,
+    const std::shared_ptr<const irs::filter>& filter,
+    const filter::prepared& query,
+    bool admit) {
+  assert(filter);
+  const auto* reader = dynamic_cast<const segment_reader*>(&segment);
+
+  if (!reader) {
+    // segment identity is unknown
+    return query.execute(segment);
+  }
+
+  // keeps reader alive, i.e. its address can't be reused while executing
+  const auto impl = static_cast<sub_reader::ptr>(*reader);
+  const key lookup_key{ impl.get(), filter.get(), filter->hash() };
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (const auto* cached = cache_.get(lookup_key); cached) {
+      if (!cached->segment_ref.expired()) {
+        ++hits_;
+        return make_iterator(cached->docs);
+      }
+
+      cache_.erase(lookup_key); // entry of a destroyed reader
+    }
+
+    ++misses_;
+  }
+
+  auto it = query.execute(segment);
+
+  if (!admit || !opts_.max_memory || !it
+      || cost::extract(*it, cost::MAX) < opts_.min_cost) {
+    return it;
+  }
+
+  doc_set_ptr docs = make_doc_set(*it, segment);
+
+  if (!docs) {
+    // no document attribute, should not happen
+    return query.execute(segment);
+  }
+
+  const size_t memory = docs->memory();
+
+  if (memory > opts_.max_memory) {
+    return make_iterator(std::move(docs));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (const auto* cached = cache_.get(lookup_key);
+      cached && cached->segment_ref.expired()) {
+    cache_.erase(lookup_key); // entry of a destroyed reader
+  }
+
+  if (cache_.emplace(lookup_key, entry{ impl, filter, docs }, memory).second) {
+    cache_.shrink(opts_.max_memory);
+  }
+
+  return make_iterator(std::move(docs));
+}
+
+filter_cache::stats filter_cache::statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  stats result;
+  result.hits = hits_;
+  result.misses = misses_;
+  result.size = cache_.size();
+  result.memory = cache_.memory();
+
+  return result;
+}
+
+void filter_cache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+  std::fill(history_.begin(), history_.end(), 0);
+  history_pos_ = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      cached_filter implementation
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_query
+/// @brief prepared query evaluated via a filter cache
+////////////////////////////////////////////////////////////////////////////////
+class cached_query final : public filter::prepared {
+ public:
+  cached_query(
+      filter::prepared::ptr&& query,
+      const std::shared_ptr<const irs::filter>& filter,
+      filter_cache& cache,
+      bool admit) noexcept
+    : query_(std::move(query)),
+      filter_(filter),
+      cache_(&cache),
+      admit_(admit) {
+    assert(query_);
+    assert(filter_);
+  }
+
+  using filter::prepared::execute;
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& segment,
+      const order::prepared& /*ord*/,
+      const attribute_provider* /*ctx*/) const override {
+    return cache_->execute(segment, filter_, *query_, admit_);
+  }
+
+ private:
+  filter::prepared::ptr query_;
+  std::shared_ptr<const irs::filter> filter_;
+  filter_cache* cache_;
+  bool admit_;
+}; // cached_query
+
+DEFINE_FACTORY_DEFAULT(cached_filter)
+
+cached_filter::cached_filter() noexcept
+  : irs::filter(irs::type<cached_filter>::get()) {
+}
+
+filter::prepared::ptr cached_filter::prepare(
+    const index_reader& rdr,
+    const order::prepared& /*ord*/,
+    boost_t boost,
+    const attribute_provider* ctx) const {
+  if (!filter_) {
+    return prepared::empty();
+  }
+
+  boost *= this->boost();
+
+  // matched documents are not scored
+  auto query = filter_->prepare(rdr, order::prepared::unordered(), boost, ctx);
+
+  if (!cache_ || !query) {
+    return query;
+  }
+
+  const bool admit = cache_->track(*filter_);
+
+  return memory::make_managed<cached_query>(std::move(query), filter_, *cache_, admit);
+}
+
+size_t cached_filter::hash() const noexcept {
+  return filter_
+    ? hash_combine(irs::filter::hash(), filter_->hash())
+    : irs::filter::hash();
+}
+
+bool cached_filter::equals(const irs::filter& rhs) const noexcept {
+  const auto& typed_rhs = static_cast<const cached_filter&>(rhs);
+
+  return irs::filter::equals(rhs)
+    && cache_ == typed_rhs.cache_
+    && ((filter_ && typed_rhs.filter_ && *filter_ == *typed_rhs.filter_)
+        || (!filter_ && !typed_rhs.filter_));
+}
+
+}
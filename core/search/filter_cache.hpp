@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_FILTER_CACHE_H
+#define IRESEARCH_FILTER_CACHE_H
+
+#include <mutex>
+
+#include "filter.hpp"
+#include "search/cost.hpp"
+#include "utils/lru_cache.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class filter_cache
+/// @brief thread-safe LRU cache of documents matched by non-scoring filters
+///        within a segment, a segment is identified by the instance of its
+///        reader, i.e. a cached entry is never used for a segment of another
+///        index or a segment having a different set of live documents,
+///        reopening an unchanged segment keeps the reader instance
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API filter_cache : private util::noncopyable {
+ public:
+  struct options {
+    // max amount of memory consumed by cached documents
+    size_t max_memory{ 32*(size_t(1) << 20) };
+
+    // number of recent executions tracked to evaluate filter frequency
+    size_t history_size{ 256 };
+
+    // min number of recent executions of a filter which allows to cache
+    // the filter results
+    size_t min_frequency{ 2 };
+
+    // results of filters estimated to match fewer documents are not cached
+    // as they are cheap enough to evaluate
+    cost::cost_t min_cost{ 128 };
+  };
+
+  struct stats {
+    uint64_t hits{}; // number of executions served from the cache
+    uint64_t misses{}; // number of executions which evaluated a filter
+    size_t size{}; // number of cached entries
+    size_t memory{}; // amount of memory consumed by cached entries
+  };
+
+  filter_cache();
+  explicit filter_cache(const options& opts);
+  ~filter_cache();
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief registers a usage of a specified filter, expected to be called
+  ///        once per query
+  /// @returns results of the filter may be cached, i.e. the filter has been
+  ///          used frequently enough
+  ////////////////////////////////////////////////////////////////////////////
+  bool track(const irs::filter& filter);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluates a specified prepared filter on a specified segment
+  /// @param filter filter the query was prepared from, used as a part of
+  ///        the cache key and owned by the cache while an entry exists
+  /// @param admit cache the matched documents if not cached yet
+  /// @returns iterator over the matched documents, provides no scores
+  ////////////////////////////////////////////////////////////////////////////
+  doc_iterator::ptr execute(
+    const sub_reader& segment,
+    const std::shared_ptr<const irs::filter>& filter,
+    const filter::prepared& query,
+    bool admit);
+
+  stats statistics() const;
+
+  void clear();
+
+ private:
+  struct entry;
+
+  struct key {
+    const sub_reader* segment; // segment reader instance
+    const irs::filter* filter;
+    size_t filter_hash; // cached value of 'filter->hash()'
+  };
+
+  struct key_hash {
+    size_t operator()(const key& value) const noexcept;
+  };
+
+  struct key_equal {
+    bool operator()(const key& lhs, const key& rhs) const noexcept;
+  };
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  options opts_;
+  mutable std::mutex mutex_;
+  lru_cache<key, entry, key_hash, key_equal> cache_; // keys refer to filters owned by entries
+  std::vector<size_t> history_; // hashes of recently executed filters
+  size_t history_pos_{};
+  uint64_t hits_{};
+  uint64_t misses_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // filter_cache
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_filter
+/// @brief filter evaluating a wrapped filter via a specified 'filter_cache',
+///        matched documents are not scored
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API cached_filter final : public filter {
+ public:
+  DECLARE_FACTORY();
+
+  cached_filter() noexcept;
+
+  const irs::filter* filter() const noexcept {
+    return filter_.get();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets a specified filter to evaluate
+  /// @note the filter can't be modified afterwards as it may be used as a part
+  ///       of a cache key
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  const T& filter(T&& filter) {
+    typedef typename std::enable_if <
+      std::is_base_of<irs::filter, std::decay_t<T>>::value, std::decay_t<T>
+    >::type type;
+
+    auto ptr = std::make_shared<const type>(std::forward<T>(filter));
+    auto& impl = *ptr;
+    filter_ = std::move(ptr);
+    return impl;
+  }
+
+  filter_cache* cache() const noexcept { return cache_; }
+
+  cached_filter& cache(filter_cache* cache) noexcept {
+    cache_ = cache;
+    return *this;
+  }
+
+  bool empty() const noexcept { return nullptr == filter_; }
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+
+  virtual size_t hash() const noexcept override;
+
+ protected:
+  virtual bool equals(const irs::filter& rhs) const noexcept override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::shared_ptr<const irs::filter> filter_;
+  filter_cache* cache_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // cached_filter
+
+}
+
+#endif // IRESEARCH_FILTER_CACHE_H
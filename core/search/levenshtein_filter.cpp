@@ -30,6 +30,7 @@
 #include "search/filter_visitor.hpp"
 #include "search/multiterm_query.hpp"
 #include "index/index_reader.hpp"
+#include "utils/automaton_cache.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/levenshtein_utils.hpp"
 #include "utils/levenshtein_default_pdp.hpp"
@@ -77,6 +78,35 @@ inline auto executeLevenshtein(byte_type max_distance,
   return lev(d);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @returns validated levenshtein automaton for a specified term, nullptr
+///          if the automaton isn't a valid acceptor, automatons built for
+///          the default parametric descriptions are shared via process-wide
+///          cache
+////////////////////////////////////////////////////////////////////////////////
+automaton_cache::ptr make_acceptor(
+    const parametric_description& d,
+    by_edit_distance_options::pdp_f provider,
+    bool with_transpositions,
+    const bytes_ref& term) {
+  if (!provider || &default_pdp == provider) {
+    auto acceptor = automaton_cache::global().levenshtein(
+      d.max_distance(), with_transpositions, term);
+
+    if (acceptor) {
+      return acceptor;
+    }
+  }
+
+  auto acceptor = make_levenshtein_automaton(d, term);
+
+  if (!validate(acceptor)) {
+    return nullptr;
+  }
+
+  return std::make_shared<const automaton>(std::move(acceptor));
+}
+
 template<typename StatesType>
 struct aggregated_stats_visitor : util::noncopyable {
   aggregated_stats_visitor(
@@ -182,23 +212,146 @@ void visit(
   }
 }
 
-template<typename Collector>
-bool collect_terms(
-    const index_reader& index,
-    const string_ref& field,
-    const bytes_ref& term,
-    const parametric_description& d,
-    Collector& collector) {
-  const auto acceptor = make_levenshtein_automaton(d, term);
+//////////////////////////////////////////////////////////////////////////////
+/// @brief visitation logic for levenshtein filter verifying every term
+///        of a field
+/// @param segment segment reader
+/// @param field term reader
+/// @param distance edit distance evaluator
+/// @param visitor visitor
+//////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void visit(
+    const sub_reader& segment,
+    const term_reader& reader,
+    const uint32_t utf8_target_size,
+    bit_parallel_edit_distance& distance,
+    Visitor& visitor) {
+  assert(distance);
+  auto terms = reader.iterator();
 
-  if (!validate(acceptor)) {
-    return false;
+  if (IRS_UNLIKELY(!terms)) {
+    return;
   }
 
-  auto matcher = make_automaton_matcher(acceptor);
-  const uint32_t utf8_term_size = std::max(1U, uint32_t(utf8_utils::utf8_length(term)));
-  const byte_type max_distance = d.max_distance() + 1;
+  bool prepared = false;
+
+  while (terms->next()) {
+    const auto& value = terms->value();
+    const auto term_distance = distance(value);
+
+    if (term_distance > distance.max_distance()) {
+      continue;
+    }
+
+    if (!prepared) {
+      visitor.prepare(segment, reader, *terms);
+      prepared = true;
+    }
+
+    terms->read();
+
+    const auto utf8_value_size = static_cast<uint32_t>(utf8_utils::utf8_length(value));
+    const auto boost = ::similarity(uint32_t(term_distance),
+                                    std::min(utf8_value_size, utf8_target_size));
 
+    visitor.visit(boost);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class term_matcher
+/// @brief visits terms of a field within a specified edit distance to
+///        a target via the strategy which is cheaper for a particular field
+////////////////////////////////////////////////////////////////////////////////
+class term_matcher : util::noncopyable {
+ public:
+  using strategy_t = by_edit_distance_options::MatchStrategy;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns max number of terms in a field which are cheaper to verify one
+  ///          by one than to intersect with an automaton, verification costs
+  ///          grow linearly with a number of terms while both the automaton
+  ///          and the part of a term dictionary it visits grow quickly with
+  ///          the distance
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t max_verified_terms(byte_type max_distance) noexcept {
+    assert(max_distance);
+    return max_distance < 5
+      ? size_t(256) << 2*(max_distance - 1)
+      : std::numeric_limits<size_t>::max();
+  }
+
+  term_matcher(
+      const parametric_description& d,
+      by_edit_distance_options::pdp_f provider,
+      bool with_transpositions,
+      const bytes_ref& term,
+      strategy_t strategy)
+    : d_(&d),
+      provider_(provider),
+      term_(term),
+      distance_(term, d.max_distance(), with_transpositions),
+      utf8_term_size_(std::max(1U, uint32_t(utf8_utils::utf8_length(term)))),
+      with_transpositions_(with_transpositions),
+      strategy_(strategy) {
+  }
+
+  template<typename Visitor>
+  void operator()(
+      const sub_reader& segment,
+      const term_reader& field,
+      Visitor& visitor) {
+    if (verify(field)) {
+      ::visit(segment, field, utf8_term_size_, distance_, visitor);
+      return;
+    }
+
+    if (!acceptor_) {
+      acceptor_ = make_acceptor(*d_, provider_, with_transpositions_, term_);
+
+      // acceptor is validated by 'make_acceptor' and might be shared
+      if (acceptor_) {
+        matcher_ = std::make_unique<automaton_table_matcher>(
+          make_automaton_matcher(*acceptor_, false));
+      }
+    }
+
+    if (matcher_) {
+      const byte_type no_distance = d_->max_distance() + 1;
+      ::visit(segment, field, no_distance, utf8_term_size_, *matcher_, visitor);
+    }
+  }
+
+ private:
+  bool verify(const term_reader& field) const noexcept {
+    switch (strategy_) {
+      case strategy_t::AUTOMATON:
+        return false;
+      case strategy_t::BIT_PARALLEL:
+        return bool(distance_);
+      default:
+        return distance_ && field.size() <= max_verified_terms(d_->max_distance());
+    }
+  }
+
+  const parametric_description* d_;
+  by_edit_distance_options::pdp_f provider_;
+  bstring term_;
+  bit_parallel_edit_distance distance_;
+  automaton_cache::ptr acceptor_; // created on demand
+  std::unique_ptr<automaton_table_matcher> matcher_;
+  uint32_t utf8_term_size_;
+  bool with_transpositions_;
+  strategy_t strategy_;
+}; // term_matcher
+
+template<typename Collector>
+void collect_terms(
+    const index_reader& index,
+    const string_ref& field,
+    term_matcher& matcher,
+    Collector& collector) {
   for (auto& segment : index) {
     auto* reader = segment.field(field);
 
@@ -206,10 +359,8 @@ bool collect_terms(
       continue;
     }
 
-    visit(segment, *reader, max_distance, utf8_term_size, matcher, collector);
+    matcher(segment, *reader, collector);
   }
-
-  return true;
 }
 
 filter::prepared::ptr prepare_levenshtein_filter(
@@ -217,9 +368,8 @@ filter::prepared::ptr prepare_levenshtein_filter(
     const order::prepared& order,
     boost_t boost,
     const string_ref& field,
-    const bytes_ref& term,
     size_t terms_limit,
-    const parametric_description& d) {
+    term_matcher& matcher) {
   field_collectors field_stats(order);
   term_collectors term_stats(order, 1);
   multiterm_query::states_t states(index);
@@ -228,15 +378,11 @@ filter::prepared::ptr prepare_levenshtein_filter(
     all_terms_collector<decltype(states)> term_collector(states, field_stats, term_stats);
     term_collector.stat_index(0); // aggregate stats from different terms
 
-    if (!collect_terms(index, field, term, d, term_collector)) {
-      return filter::prepared::empty();
-    }
+    collect_terms(index, field, matcher, term_collector);
   } else {
     top_terms_collector term_collector(terms_limit, field_stats);
 
-    if (!collect_terms(index, field, term, d, term_collector)) {
-      return filter::prepared::empty();
-    }
+    collect_terms(index, field, matcher, term_collector);
 
     aggregated_stats_visitor<decltype(states)> aggregate_stats(states, term_stats);
     term_collector.visit([&aggregate_stats](top_term_state<boost_t>& state) {
@@ -281,32 +427,15 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
       };
     },
     [&opts](const parametric_description& d) -> field_visitor {
-      struct automaton_context : util::noncopyable {
-        automaton_context(const parametric_description& d, const bytes_ref& term)
-          : acceptor(make_levenshtein_automaton(d, term)),
-            matcher(make_automaton_matcher(acceptor)) {
-        }
-
-        automaton acceptor;
-        automaton_table_matcher matcher;
-      };
-
       // FIXME
-      auto ctx = memory::make_shared<automaton_context>(d, opts.term);
+      auto matcher = memory::make_shared<term_matcher>(
+        d, opts.provider, opts.with_transpositions, opts.term, opts.strategy);
 
-      if (!validate(ctx->acceptor)) {
-        return [](const sub_reader&, const term_reader&, filter_visitor&){};
-      }
-
-      const uint32_t utf8_term_size = std::max(1U, uint32_t(utf8_utils::utf8_length(opts.term)));
-      const byte_type max_distance = d.max_distance() + 1;
-
-      return [ctx, utf8_term_size, max_distance](
+      return [matcher](
           const sub_reader& segment,
           const term_reader& field,
           filter_visitor& visitor) mutable {
-        return ::visit(segment, field, max_distance,
-                       utf8_term_size, ctx->matcher, visitor);
+        return (*matcher)(segment, field, visitor);
       };
     }
   );
@@ -321,7 +450,8 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
     size_t scored_terms_limit,
     byte_type max_distance,
     options_type::pdp_f provider,
-    bool with_transpositions) {
+    bool with_transpositions,
+    options_type::MatchStrategy strategy) {
   return executeLevenshtein(
     max_distance, provider, with_transpositions,
     []() -> filter::prepared::ptr {
@@ -330,9 +460,12 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
     [&index, &order, boost, &field, &term]() -> filter::prepared::ptr {
       return by_term::prepare(index, order, boost, field, term);
     },
-    [&field, &term, scored_terms_limit, &index, &order, boost](
+    [&field, &term, scored_terms_limit, &index, &order, boost, provider, with_transpositions, strategy](
         const parametric_description& d) -> filter::prepared::ptr {
-      return prepare_levenshtein_filter(index, order, boost, field, term, scored_terms_limit, d);
+      term_matcher matcher(d, provider, with_transpositions, term, strategy);
+
+      return prepare_levenshtein_filter(index, order, boost, field,
+                                        scored_terms_limit, matcher);
     }
   );
 }
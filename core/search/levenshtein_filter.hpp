@@ -61,6 +61,20 @@ struct IRESEARCH_API by_edit_distance_filter_options {
   //////////////////////////////////////////////////////////////////////////////
   bool with_transpositions{false};
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the way terms of a field are matched against a target
+  /// @note doesn't affect the result and thus isn't the part of filter
+  ///       identity
+  //////////////////////////////////////////////////////////////////////////////
+  enum class MatchStrategy : uint8_t {
+    AUTO = 0,     // choose for every segment based on the estimated costs
+    AUTOMATON,    // intersect a term dictionary with levenshtein automaton
+    BIT_PARALLEL  // verify every term via 'bit_parallel_edit_distance',
+                  // 'AUTOMATON' is used for targets longer than 64 symbols
+  };
+
+  MatchStrategy strategy{MatchStrategy::AUTO};
+
   bool operator==(const by_edit_distance_filter_options& rhs) const noexcept {
     return term == rhs.term &&
       max_distance == rhs.max_distance &&
@@ -115,7 +129,8 @@ class IRESEARCH_API by_edit_distance final
     size_t terms_limit,
     byte_type max_distance,
     options_type::pdp_f provider,
-    bool with_transpositions);
+    bool with_transpositions,
+    options_type::MatchStrategy strategy = options_type::MatchStrategy::AUTO);
 
   static field_visitor visitor(
     const options_type::filter_options& options);
@@ -130,7 +145,7 @@ class IRESEARCH_API by_edit_distance final
     return prepare(index, order, this->boost()*boost,
                    field(), options().term, options().max_terms,
                    options().max_distance, options().provider,
-                   options().with_transpositions);
+                   options().with_transpositions, options().strategy);
   }
 }; // by_edit_distance
 
@@ -22,8 +22,6 @@
 
 #include "ngram_similarity_filter.hpp"
 
-#include <set>
-
 #include "shared.hpp"
 #include "analysis/token_attributes.hpp"
 #include "index/index_reader.hpp"
@@ -33,6 +31,7 @@
 #include "search/disjunction.hpp"
 #include "search/min_match_disjunction.hpp"
 #include "search/states_cache.hpp"
+#include "utils/bitset.hpp"
 #include "utils/misc.hpp"
 #include "utils/map_utils.hpp"
 
@@ -139,24 +138,26 @@ class ngram_similarity_doc_iterator final
     const score* scr;
   };
 
-  struct search_state {
-    search_state(size_t p, const score* s) : parent{nullptr}, scr{s}, pos{p}, len(1) {}
-    search_state(search_state&&) = default;
-    search_state(const search_state&) = default;
-    search_state& operator=(const search_state&) = default;
+  static constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
 
-    // appending constructor
-    search_state(std::shared_ptr<search_state>& other, size_t p, const score* s)
-      : parent{other}, scr{s}, pos{p}, len(other->len + 1) {}
+  struct search_state {
+    search_state(size_t parent, const score* scr, uint32_t pos, size_t len) noexcept
+      : parent(parent), scr(scr), pos(pos), len(len) {
+    }
 
-    std::shared_ptr<search_state> parent;
+    size_t parent; // offset of a parent state in 'states_' or 'NO_PARENT'
     const score* scr;
-    size_t pos;
+    uint32_t pos;
     size_t len;
   };
 
-  using search_states_t = std::map<uint32_t, std::shared_ptr<search_state>, std::greater<uint32_t>>;
-  using pos_temp_t = std::vector<std::pair<uint32_t, std::shared_ptr<search_state>>>;
+  // position of a candidate + offset of its state in 'states_'
+  using candidate_t = std::pair<uint32_t, size_t>;
+  using candidates_t = std::vector<candidate_t>;
+  // candidates are stored sorted by position, reverse iteration gives
+  // the closest preceding candidates first
+  using candidate_iterator = candidates_t::reverse_iterator;
+
   using attributes = std::tuple<
     attribute_ptr<document>,
     frequency,
@@ -166,20 +167,69 @@ class ngram_similarity_doc_iterator final
 
   bool check_serial_positions();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns closest candidate located at or before a specified position
+  //////////////////////////////////////////////////////////////////////////////
+  candidate_iterator find_candidate(uint32_t pos) noexcept {
+    return std::lower_bound(
+      search_buf_.rbegin(), search_buf_.rend(), pos,
+      [](const candidate_t& lhs, uint32_t rhs) noexcept {
+        return lhs.first > rhs;
+    });
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds a candidate for a specified position unless the position is
+  ///        occupied already
+  /// @returns the candidate has been added
+  //////////////////////////////////////////////////////////////////////////////
+  bool emplace_candidate(uint32_t pos, size_t state) {
+    // positions of a term are visited in ascending order, so it's
+    // likely to end up at the very end
+    auto it = search_buf_.end();
+    if (!search_buf_.empty() && search_buf_.back().first >= pos) {
+      it = std::lower_bound(
+        search_buf_.begin(), search_buf_.end(), pos,
+        [](const candidate_t& lhs, uint32_t rhs) noexcept {
+          return lhs.first < rhs;
+      });
+
+      if (it->first == pos) {
+        return false;
+      }
+    }
+
+    search_buf_.emplace(it, pos, state);
+    return true;
+  }
+
+  size_t new_state(size_t parent, const score* scr, uint32_t pos) {
+    const size_t len = NO_PARENT == parent ? 1 : states_[parent].len + 1;
+    states_.emplace_back(parent, scr, pos, len);
+    return states_.size() - 1;
+  }
+
   std::vector<position_t> pos_;
   approximation approx_;
   attributes attrs_;
-  std::set<size_t> used_pos_; // longest sequence positions overlaping detector
+  bitset used_pos_; // longest sequence positions overlaping detector
   std::vector<const score*> longest_sequence_;
-  std::vector<size_t> pos_sequence_;
+  std::vector<uint32_t> pos_sequence_;
   size_t min_match_count_;
-  search_states_t search_buf_;
+  std::vector<search_state> states_; // all states created for a document
+  candidates_t search_buf_; // sequence candidates
+  candidates_t swap_cache_; // candidates to replace once a term is processed
   boost_t total_terms_count_;
   bool empty_order_;
 };
 
 bool ngram_similarity_doc_iterator::check_serial_positions() {
   size_t potential = approx_.match_count(); // how long max sequence could be in the best case
+  // documents matching fewer terms are skipped by the approximation
+  assert(potential >= min_match_count_);
+
+  // buffers are reused between documents
+  states_.clear();
   search_buf_.clear();
   size_t longest_sequence_len = 0;
 
@@ -194,35 +244,33 @@ bool ngram_similarity_doc_iterator::check_serial_positions() {
         // this term could not start largest (or long enough) sequence.
         // skip it to first position to append to any existing candidates
         assert(!search_buf_.empty());
-        pos.seek(search_buf_.rbegin()->first + 1);
+        pos.seek(search_buf_.front().first + 1);
       } else {
         pos.next();
       }
       if (!pos_limits::eof(pos.value())) {
-        pos_temp_t swap_cache;
+        swap_cache_.clear();
         auto last_found_pos = pos_limits::invalid();
         do {
-          auto current_pos = pos.value();
-          auto found = search_buf_.lower_bound(current_pos);
-          if (found != search_buf_.end()) {
+          const uint32_t current_pos = pos.value();
+          auto found = find_candidate(current_pos);
+          if (found != search_buf_.rend()) {
             if (last_found_pos != found->first) {
               last_found_pos = found->first;
-              const auto* found_state = found->second.get();
-              assert(found_state);
+              const auto* found_state = &states_[found->second];
               auto current_sequence = found;
               // if we hit same position - set length to 0 to force checking candidates to the left
               size_t current_found_len = (found->first == current_pos ||
                                           found_state->scr == pos_iterator.scr) ? 0 : found_state->len + 1;
-              auto initial_found = found;
+              const auto initial_found_scr = found_state->scr;
               if (current_found_len > longest_sequence_len) {
                 longest_sequence_len = current_found_len;
               } else {
                 // maybe some previous candidates could produce better results.
                 // lets go leftward and check if there are any candidates which could became longer
                 // if we stick this ngram to them rather than the closest one found
-                for (++found; found != search_buf_.end(); ++found) {
-                  found_state = found->second.get();
-                  assert(found_state);
+                for (++found; found != search_buf_.rend(); ++found) {
+                  found_state = &states_[found->second];
                   if (found_state->scr != pos_iterator.scr &&
                       found_state->len + 1 > current_found_len) {
                     // we have better option. Replace this match!
@@ -236,38 +284,33 @@ bool ngram_similarity_doc_iterator::check_serial_positions() {
                 }
               }
               if (current_found_len) {
-                auto new_candidate = std::make_shared<search_state>(current_sequence->second, current_pos, pos_iterator.scr);
-                const auto res = search_buf_.try_emplace(current_pos, std::move(new_candidate));
-                if (!res.second) {
+                const auto new_candidate = new_state(current_sequence->second, pos_iterator.scr, current_pos);
+                if (!emplace_candidate(current_pos, new_candidate)) {
                   // pos already used. This could be if same ngram used several times.
                   // replace with new length through swap cache - to not spoil
                   // candidate for following positions of same ngram
-                  swap_cache.emplace_back(current_pos, std::move(new_candidate));
+                  swap_cache_.emplace_back(current_pos, new_candidate);
                 }
-              } else if (initial_found->second->scr == pos_iterator.scr &&
+              } else if (initial_found_scr == pos_iterator.scr &&
                          potential > longest_sequence_len && potential >= min_match_count_) {
                 // we just hit same iterator and found no better place to join,
                 // so it will produce new candidate
-                search_buf_.emplace(std::piecewise_construct,
-                  std::forward_as_tuple(current_pos),
-                  std::forward_as_tuple(std::make_shared<search_state>(current_pos, pos_iterator.scr)));
+                emplace_candidate(current_pos, new_state(NO_PARENT, pos_iterator.scr, current_pos));
               }
             }
           } else  if (potential > longest_sequence_len && potential >= min_match_count_) {
             // this ngram at this position  could potentially start a long enough sequence
             // so add it to candidate list
-            search_buf_.emplace(std::piecewise_construct,
-              std::forward_as_tuple(current_pos),
-              std::forward_as_tuple(std::make_shared<search_state>(current_pos, pos_iterator.scr)));
+            emplace_candidate(current_pos, new_state(NO_PARENT, pos_iterator.scr, current_pos));
             if (!longest_sequence_len) {
               longest_sequence_len = 1;
             }
           }
         } while (pos.next());
-        for (auto& p : swap_cache) {
-          auto res = search_buf_.find(p.first);
-          assert(res != search_buf_.end());
-          std::swap(res->second, p.second);
+        for (auto& p : swap_cache_) {
+          auto res = find_candidate(p.first);
+          assert(res != search_buf_.rend() && res->first == p.first);
+          res->second = p.second;
         }
       }
       --potential; // we are done with this term.
@@ -293,8 +336,8 @@ bool ngram_similarity_doc_iterator::check_serial_positions() {
     size_t count_longest{ 0 };
     // try to optimize case with one longest candidate
     // performance profiling shows it is majority of cases
-    for (auto i = search_buf_.begin(), end = search_buf_.end(); i != end; ++i) {
-      if (i->second->len == longest_sequence_len) {
+    for (auto& candidate : search_buf_) {
+      if (states_[candidate.second].len == longest_sequence_len) {
         ++count_longest;
         if (count_longest > 1) {
           break;
@@ -304,53 +347,51 @@ bool ngram_similarity_doc_iterator::check_serial_positions() {
 
     if (count_longest > 1) {
       longest_sequence_.clear();
-      used_pos_.clear();
+      // every state position is a candidate position, the last one is the largest
+      used_pos_.reset(search_buf_.back().first + 1);
       longest_sequence_.reserve(longest_sequence_len);
       pos_sequence_.reserve(longest_sequence_len);
-      for (auto i = search_buf_.begin(), end = search_buf_.end(); i != end;) {
+      for (auto i = search_buf_.rbegin(), end = search_buf_.rend(); i != end; ++i) {
         pos_sequence_.clear();
-        const auto* state = i->second.get();
-        assert(state && state->len <= longest_sequence_len);
+        const auto* state = &states_[i->second];
+        assert(state->len <= longest_sequence_len);
         if (state->len == longest_sequence_len) {
           bool delete_candidate = false;
           // only first longest sequence will contribute to frequency
           if (longest_sequence_.empty()) {
             longest_sequence_.push_back(state->scr);
             pos_sequence_.push_back(state->pos);
-            auto cur_parent = state->parent;
-            while (cur_parent) {
-              longest_sequence_.push_back(cur_parent->scr);
-              pos_sequence_.push_back(cur_parent->pos);
-              cur_parent = cur_parent->parent;
+            for (auto parent = state->parent; NO_PARENT != parent; parent = states_[parent].parent) {
+              longest_sequence_.push_back(states_[parent].scr);
+              pos_sequence_.push_back(states_[parent].pos);
             }
           } else {
-            if (used_pos_.find(state->pos) != used_pos_.end() ||
+            if (used_pos_.test(state->pos) ||
                 state->scr != longest_sequence_[0]) {
               delete_candidate = true;
             } else {
               pos_sequence_.push_back(state->pos);
-              auto cur_parent = state->parent;
               size_t j = 1;
-              while (cur_parent) {
+              for (auto parent = state->parent; NO_PARENT != parent; parent = states_[parent].parent) {
                 assert(j < longest_sequence_.size());
-                if (longest_sequence_[j] != cur_parent->scr ||
-                  used_pos_.find(cur_parent->pos) != used_pos_.end()) {
+                const auto& parent_state = states_[parent];
+                if (longest_sequence_[j] != parent_state.scr ||
+                    used_pos_.test(parent_state.pos)) {
                   delete_candidate = true;
                   break;
                 }
-                pos_sequence_.push_back(cur_parent->pos);
-                cur_parent = cur_parent->parent;
+                pos_sequence_.push_back(parent_state.pos);
                 ++j;
               }
             }
           }
           if (!delete_candidate) {
             ++freq;
-            used_pos_.insert(std::begin(pos_sequence_),
-                            std::end(pos_sequence_));
+            for (const auto p : pos_sequence_) {
+              used_pos_.set(p);
+            }
           }
         }
-        ++i;
       }
     } else {
       freq = 1;
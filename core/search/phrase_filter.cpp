@@ -22,6 +22,7 @@
 
 #include "phrase_filter.hpp"
 
+#include "analysis/common_grams_token_stream.hpp"
 #include "index/field_meta.hpp"
 #include "search/collectors.hpp"
 #include "search/filter_visitor.hpp"
@@ -151,7 +152,7 @@ struct prepare : util::noncopyable {
       index, order, boost, field, part.term,
       0, // collect all terms
       part.max_distance, part.provider,
-      part.with_transpositions);
+      part.with_transpositions, part.strategy);
   }
 
   result_type operator()(const by_terms_options& /*part*/) const {
@@ -172,7 +173,7 @@ struct prepare : util::noncopyable {
 
   prepare(const index_reader& index,
           const order::prepared& order,
-          const std::string& field,
+          const string_ref& field,
           const boost_t boost) noexcept
     : index(index), order(order),
       field(field), boost(boost) {
@@ -184,6 +185,80 @@ struct prepare : util::noncopyable {
   const boost_t boost;
 }; // prepare
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief rewrites a phrase of simple terms into a phrase over the common
+///        grams companion field: each pair of adjacent terms containing a
+///        common word is replaced by a bigram at the position of its first
+///        term, terms not covered by any bigram are kept as is, e.g.
+///        "the state of the art" -> "the state", "state of", "of the", "the art"
+/// @returns true if phrase was rewritten, false - otherwise
+//////////////////////////////////////////////////////////////////////////////
+bool make_common_grams(
+    const index_reader& index,
+    const string_ref& field,
+    const by_phrase_options& phrase,
+    by_phrase_options& grams) {
+  const auto& common = phrase.common_grams();
+
+  if (common.field.empty() || !phrase.simple() || phrase.size() < 2) {
+    return false;
+  }
+
+  // bigrams are indexed for adjacent tokens only
+  if (std::prev(phrase.end())->first - phrase.begin()->first + 1 != phrase.size()) {
+    return false;
+  }
+
+  auto is_common = [&common](const auto& part) {
+    return common.words.count(std::get<by_term_options>(part.second).term) != 0;
+  };
+
+  if (std::none_of(phrase.begin(), phrase.end(), is_common)) {
+    return false;
+  }
+
+  // bigram postings have to be available in every segment containing
+  // the original field, otherwise fall back to the original phrase
+  for (const auto& segment : index) {
+    const auto* reader = segment.field(field);
+
+    if (!reader || !by_phrase::required().is_subset_of(reader->meta().features)) {
+      continue;
+    }
+
+    const auto* grams_reader = segment.field(common.field);
+
+    if (!grams_reader ||
+        !by_phrase::required().is_subset_of(grams_reader->meta().features)) {
+      return false;
+    }
+  }
+
+  grams.clear();
+
+  bstring gram;
+  bool covered = false; // current term is a part of the previous bigram
+  for (auto it = phrase.begin(), end = phrase.end(); it != end; ++it) {
+    const auto& term = std::get<by_term_options>(it->second).term;
+    const auto next = std::next(it);
+
+    if (next != end && (is_common(*it) || is_common(*next))) {
+      analysis::common_grams_token_stream::make_gram(
+        gram, term, std::get<by_term_options>(next->second).term,
+        common.separator);
+      grams.insert<by_term_options>(it->first).term = gram;
+      covered = true;
+    } else {
+      if (!covered) {
+        grams.insert<by_term_options>(it->first).term = term;
+      }
+      covered = false;
+    }
+  }
+
+  return true;
+}
+
 }
 
 namespace iresearch {
@@ -501,10 +576,20 @@ filter::prepared::ptr by_phrase::prepare(
     return filter::prepared::empty();
   }
 
-  if (1 == options().size()) {
+  string_ref field = this->field();
+  const by_phrase_options* phrase = &options();
+
+  // phrase rewritten to common grams
+  by_phrase_options grams;
+  if (make_common_grams(index, field, *phrase, grams)) {
+    field = phrase->common_grams().field;
+    phrase = &grams;
+  }
+
+  if (1 == phrase->size()) {
     auto query = std::visit(
-      ::prepare{index, ord, field(), this->boost()*boost},
-      options().begin()->second);
+      ::prepare{index, ord, field, this->boost()*boost},
+      phrase->begin()->second);
 
     if (query) {
       return query;
@@ -512,8 +597,8 @@ filter::prepared::ptr by_phrase::prepare(
   }
 
   // prepare phrase stats (collector for each term)
-  if (options().simple()) {
-    return fixed_prepare_collect(index, ord, boost);
+  if (phrase->simple()) {
+    return fixed_prepare_collect(index, ord, boost, field, *phrase);
   }
 
   return variadic_prepare_collect(index, ord, boost);
@@ -522,8 +607,10 @@ filter::prepared::ptr by_phrase::prepare(
 filter::prepared::ptr by_phrase::fixed_prepare_collect(
     const index_reader& index,
     const order::prepared& ord,
-    boost_t boost) const {
-  const auto phrase_size = options().size();
+    boost_t boost,
+    const string_ref& field,
+    const by_phrase_options& phrase) const {
+  const auto phrase_size = phrase.size();
   const auto is_ord_empty = ord.empty();
 
   // stats collectors
@@ -538,8 +625,6 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
   phrase_terms.reserve(phrase_size);
 
   // iterate over the segments
-  const string_ref field = this->field();
-
   phrase_term_visitor<decltype(phrase_terms)> ptv(phrase_terms);
 
   for (const auto& segment : index) {
@@ -558,7 +643,7 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
     field_stats.collect(segment, *reader); // collect field statistics once per segment
     ptv.reset(term_stats);
 
-    for (const auto& word : options()) {
+    for (const auto& word : phrase) {
       assert(std::get_if<by_term_options>(&word.second));
       by_term::visit(segment, *reader, std::get<by_term_options>(word.second).term, ptv);
       if (!ptv.found()) {
@@ -584,8 +669,8 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
   }
 
   // offset of the first term in a phrase
-  assert(!options().empty());
-  const size_t base_offset = options().begin()->first;
+  assert(!phrase.empty());
+  const size_t base_offset = phrase.begin()->first;
 
   // finish stats
   bstring stats(ord.stats_size(), 0); // aggregated phrase stats
@@ -595,7 +680,7 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
   auto pos_itr = positions.begin();
 
   size_t term_idx = 0;
-  for (const auto& term : options()) {
+  for (const auto& term : phrase) {
     *pos_itr = position::value_t(term.first - base_offset);
     term_stats.finish(stats_buf, term_idx, field_stats, index);
     ++pos_itr;
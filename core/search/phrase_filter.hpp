@@ -24,6 +24,7 @@
 #define IRESEARCH_PHRASE_FILTER_H
 
 #include <map>
+#include <set>
 #include <variant>
 
 #include "search/levenshtein_filter.hpp"
@@ -57,6 +58,24 @@ class IRESEARCH_API by_phrase_options {
  public:
   using filter_type = by_phrase;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief description of a companion field indexed with
+  ///        'common_grams_token_stream', phrases of simple terms containing
+  ///        any of the common words are evaluated against bigrams from
+  ///        that field instead of intersecting positions of every term
+  //////////////////////////////////////////////////////////////////////////////
+  struct common_grams_options {
+    std::string field; // companion field name, empty - disabled
+    std::set<bstring> words; // common words the field was indexed with
+    std::string separator{" "}; // separator between bigram parts
+
+    bool operator==(const common_grams_options& rhs) const {
+      return field == rhs.field
+        && words == rhs.words
+        && separator == rhs.separator;
+    }
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief insert phrase part into the phrase at a specified position
   /// @returns reference to the inserted phrase part
@@ -120,7 +139,7 @@ class IRESEARCH_API by_phrase_options {
   /// @returns true is options are equal, false - otherwise
   //////////////////////////////////////////////////////////////////////////////
   bool operator==(const by_phrase_options& rhs) const noexcept {
-    return phrase_ == rhs.phrase_;
+    return phrase_ == rhs.phrase_ && common_grams_ == rhs.common_grams_;
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -132,6 +151,9 @@ class IRESEARCH_API by_phrase_options {
       hash = hash_combine(hash, part.first);
       hash = hash_combine(hash, part.second);
     }
+    if (!common_grams_.field.empty()) {
+      hash = hash_combine(hash, common_grams_.field);
+    }
     return hash;
   }
 
@@ -148,6 +170,18 @@ class IRESEARCH_API by_phrase_options {
   //////////////////////////////////////////////////////////////////////////////
   bool simple() const noexcept { return is_simple_term_only_; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns common grams companion field description
+  //////////////////////////////////////////////////////////////////////////////
+  common_grams_options& common_grams() noexcept { return common_grams_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns common grams companion field description
+  //////////////////////////////////////////////////////////////////////////////
+  const common_grams_options& common_grams() const noexcept {
+    return common_grams_;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @returns true if phrase is empty, false - otherwise
   //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +208,7 @@ class IRESEARCH_API by_phrase_options {
   }
 
   phrase_type phrase_;
+  common_grams_options common_grams_;
   bool is_simple_term_only_{true};
 }; // by_phrase_options
 
@@ -202,7 +237,9 @@ class IRESEARCH_API by_phrase : public filter_base<by_phrase_options> {
   filter::prepared::ptr fixed_prepare_collect(
     const index_reader& index,
     const order::prepared& ord,
-    boost_t boost) const;
+    boost_t boost,
+    const string_ref& field,
+    const by_phrase_options& phrase) const;
 
   filter::prepared::ptr variadic_prepare_collect(
     const index_reader& index,
@@ -29,6 +29,7 @@
 #include "search/prefix_filter.hpp"
 #include "index/index_reader.hpp"
 #include "utils/wildcard_utils.hpp"
+#include "utils/automaton_cache.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/hash_utils.hpp"
 
@@ -128,22 +129,24 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
     },
     [](const bytes_ref& term) -> field_visitor{
       struct automaton_context : util::noncopyable {
-        automaton_context(const bytes_ref& term)
-          : acceptor(from_wildcard(term)),
-            matcher(make_automaton_matcher(acceptor)) {
+        explicit automaton_context(automaton_cache::ptr&& acceptor)
+          : acceptor(std::move(acceptor)),
+            matcher(make_automaton_matcher(*this->acceptor, false)) { // validated by cache
         }
 
-        automaton acceptor;
+        automaton_cache::ptr acceptor;
         automaton_table_matcher matcher;
       };
 
-      // FIXME
-      auto ctx = memory::make_shared<automaton_context>(term);
+      auto acceptor = automaton_cache::global().wildcard(term);
 
-      if (!validate(ctx->acceptor)) {
+      if (!acceptor) {
         return [](const sub_reader&, const term_reader&, filter_visitor&) { };
       }
 
+      // FIXME
+      auto ctx = memory::make_shared<automaton_context>(std::move(acceptor));
+
       return [ctx](
           const sub_reader& segment,
           const term_reader& field,
@@ -174,8 +177,15 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
       return by_prefix::prepare(index, order, boost, field, term, scored_terms_limit);
     },
     [&index, &order, boost, &field, scored_terms_limit](const bytes_ref& term) -> filter::prepared::ptr {
-      return prepare_automaton_filter(field, from_wildcard(term), scored_terms_limit,
-                                      index, order, boost);
+      const auto acceptor = automaton_cache::global().wildcard(term);
+
+      if (!acceptor) {
+        return prepared::empty();
+      }
+
+      return prepare_automaton_filter(field, *acceptor, scored_terms_limit,
+                                      index, order, boost,
+                                      false); // validated by cache
     }
   );
 }
@@ -307,6 +307,16 @@
 #define IRESEARCH_AVX2
 #endif
 
+// IRESEARCH_TARGET allows using instruction set extensions beyond the ones
+// enabled for a translation unit in a particular function, such functions
+// must only be called after checking the host CPU via 'cpuinfo'
+// NOTE: MSVC allows using any intrinsic without additional flags
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IRESEARCH_TARGET(features) __attribute__((target(features)))
+#else
+#define IRESEARCH_TARGET(features)
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Endianess
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +70,58 @@ void fd_pool_size::clear() noexcept {
   size = FD_POOL_DEFAULT_SIZE;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   io_advice_hints
+// -----------------------------------------------------------------------------
+
+DEFINE_FACTORY_DEFAULT(io_advice_hints)
+
+void io_advice_hints::set(const string_ref& ext, IOAdvice advice) {
+  hints_[static_cast<std::string>(ext)].advice = advice;
+}
+
+const io_advice_hints::hint* io_advice_hints::get(
+    const string_ref& filename) const noexcept {
+  if (hints_.empty()) {
+    return nullptr;
+  }
+
+  const auto* begin = filename.c_str();
+  const auto* end = begin + filename.size();
+  const auto* dot = end;
+
+  while (dot != begin && *(dot - 1) != '.') {
+    --dot;
+  }
+
+  if (dot == begin) {
+    return nullptr; // no extension
+  }
+
+  const auto it = hints_.find(string_ref(dot, std::distance(dot, end)));
+
+  return hints_.end() == it ? nullptr : &it->second;
+}
+
+IOAdvice io_advice_hints::advice(
+    const string_ref& filename,
+    IOAdvice advice) const noexcept {
+  const auto* hint = get(filename);
+
+  if (!hint) {
+    return advice;
+  }
+
+  constexpr auto PATTERN = IOAdvice::SEQUENTIAL | IOAdvice::RANDOM;
+
+  // access pattern requested by a caller takes precedence
+  const auto pattern = IOAdvice::NORMAL == (advice & PATTERN)
+    ? hint->advice & PATTERN
+    : advice & PATTERN;
+
+  return pattern | ((advice | hint->advice) & IOAdvice::READONCE);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   index_file_refs
 // -----------------------------------------------------------------------------
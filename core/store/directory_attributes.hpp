@@ -25,10 +25,13 @@
 #define IRESEARCH_DIRECTORY_ATTRIBUTES_H
 
 #include "shared.hpp"
+#include "directory.hpp"
 #include "utils/attribute_store.hpp"
 #include "utils/ref_counter.hpp"
 #include "utils/container_utils.hpp"
 
+#include <map>
+
 namespace iresearch {
 
 //////////////////////////////////////////////////////////////////////////////
@@ -76,6 +79,51 @@ struct IRESEARCH_API fd_pool_size: public stored_attribute {
   size_t size;
 }; // fd_pool_size
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class io_advice_hints
+/// @brief per file extension access pattern hints used by directories where
+///        applicable, e.g. fs_directory, mmap_directory, in case if a caller
+///        of 'directory::open(...)' gives no access pattern advice
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API io_advice_hints : public stored_attribute {
+ public:
+  struct hint {
+    IOAdvice advice{ IOAdvice::NORMAL };
+  };
+
+  DECLARE_FACTORY();
+
+  io_advice_hints() = default;
+
+  void clear() noexcept { hints_.clear(); }
+
+  bool empty() const noexcept { return hints_.empty(); }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief set access pattern hint for files with the specified extension
+  ////////////////////////////////////////////////////////////////////////////
+  void set(const string_ref& ext, IOAdvice advice);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns hint for a file with the specified name or nullptr if there is
+  ///          no hint registered for the file extension
+  ////////////////////////////////////////////////////////////////////////////
+  const hint* get(const string_ref& filename) const noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns effective advice for a file with the specified name, access
+  ///          pattern requested by a caller (e.g. SEQUENTIAL for merges) takes
+  ///          precedence over the hint, 'READONCE' requested by either a
+  ///          caller or a hint is preserved
+  ////////////////////////////////////////////////////////////////////////////
+  IOAdvice advice(const string_ref& filename, IOAdvice advice) const noexcept;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::map<std::string, hint, std::less<>> hints_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // io_advice_hints
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class index_file_refs
 /// @brief represents a ref_counter for index related files
@@ -562,6 +562,10 @@ index_input::ptr fs_directory::open(
 
     (path/=dir_)/=name;
 
+    if (auto& hints = attributes().get<io_advice_hints>(); hints) {
+      advice = hints->advice(name, advice);
+    }
+
     return fs_index_input::open(path.c_str(), pool_size, advice);
   } catch(...) {
   }
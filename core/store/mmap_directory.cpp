@@ -21,6 +21,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "mmap_directory.hpp"
+#include "directory_attributes.hpp"
 #include "store_utils.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/mmap_utils.hpp"
@@ -156,6 +157,10 @@ index_input::ptr mmap_directory::open(
     return nullptr;
   }
 
+  if (auto& hints = attributes().get<io_advice_hints>(); hints) {
+    advice = hints->advice(name, advice);
+  }
+
   return mmap_index_input::open(path.c_str(), advice);
 }
 
@@ -23,6 +23,7 @@
 #include "shared.hpp"
 #include "store_utils.hpp"
 
+#include "error/error.hpp"
 #include "utils/crc.hpp"
 #include "utils/std.hpp"
 #include "utils/string_utils.hpp"
@@ -469,6 +470,240 @@ uint32_t write_block(
 }
 
 } // bitpack
+
+namespace elias_fano {
+
+// a block never takes more space than 128 bit packed 32-bit values
+constexpr size_t MAX_WORDS = BLOCK_SIZE*sizeof(uint32_t)/sizeof(uint64_t);
+
+enum BlockType : uint64_t {
+  ELIAS_FANO = 0,
+  DENSE,
+  ALL_EQUAL
+};
+
+FORCE_INLINE uint64_t make_header(uint64_t universe, BlockType type) noexcept {
+  assert(universe <= (std::numeric_limits<uint64_t>::max() >> 2));
+  return (universe << 2) | type;
+}
+
+// number of lower bits of every value stored explicitly
+FORCE_INLINE uint32_t low_bits(uint64_t universe) noexcept {
+  return universe > BLOCK_SIZE
+    ? uint32_t(math::log2_floor_64(universe / BLOCK_SIZE))
+    : 0;
+}
+
+// number of 64-bit words taken by unary coded upper bits
+FORCE_INLINE size_t high_words(uint64_t universe, uint32_t low) noexcept {
+  return math::div_ceil64((universe >> low) + BLOCK_SIZE, 64);
+}
+
+// number of 64-bit words taken by a bitset
+FORCE_INLINE size_t bitset_words(uint64_t universe) noexcept {
+  return math::div_ceil64(universe, 64);
+}
+
+// throws if a block header claims more words than a block might take
+FORCE_INLINE size_t check_words(size_t count) {
+  if (count > MAX_WORDS) {
+    throw index_error(string_utils::to_string(
+      "invalid Elias-Fano block size, got " IR_SIZE_T_SPECIFIER " words while at most " IR_SIZE_T_SPECIFIER " are allowed",
+      count, MAX_WORDS));
+  }
+
+  return count;
+}
+
+FORCE_INLINE void read_words(data_input& in, uint64_t* words, size_t count) {
+  for (auto* end = words + check_words(count); words != end; ++words) {
+    *words = uint64_t(in.read_long());
+  }
+}
+
+FORCE_INLINE void write_words(data_output& out, const uint64_t* words, size_t count) {
+  assert(count <= MAX_WORDS);
+
+  for (auto* end = words + count; words != end; ++words) {
+    out.write_long(int64_t(*words));
+  }
+}
+
+void skip_block(index_input& in) {
+  const uint64_t header = in.read_vlong();
+  const uint64_t universe = header >> 2;
+
+  switch (header & 3) {
+    case ELIAS_FANO: {
+      const uint32_t low = low_bits(universe);
+      in.seek(in.file_pointer()
+              + packed::bytes_required_32(BLOCK_SIZE, low)
+              + sizeof(uint64_t)*check_words(high_words(universe, low)));
+    } break;
+    case DENSE:
+      in.seek(in.file_pointer() + sizeof(uint64_t)*check_words(bitset_words(universe)));
+      break;
+    case ALL_EQUAL:
+      break;
+    default:
+      throw index_error(string_utils::to_string(
+        "invalid Elias-Fano block type '%d'",
+        int(header & 3)));
+  }
+}
+
+void read_block(
+    data_input& in,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  assert(encoded);
+  assert(decoded);
+
+  uint64_t words[MAX_WORDS];
+  const uint64_t header = in.read_vlong();
+  const uint64_t universe = header >> 2;
+
+  if (ALL_EQUAL == (header & 3)) {
+    std::fill(decoded, decoded + BLOCK_SIZE, uint32_t(universe / BLOCK_SIZE));
+    return;
+  }
+
+  if (DENSE == (header & 3)) {
+    const size_t count = bitset_words(universe);
+    read_words(in, words, count);
+
+    uint32_t prev = 0;
+    uint32_t* out = decoded;
+    uint32_t* out_end = decoded + BLOCK_SIZE;
+    for (size_t i = 0; i < count && out != out_end; ++i) {
+      for (uint64_t word = words[i]; word && out != out_end; word &= word - 1) {
+        const auto value = uint32_t(64*i + math::ctz64(word)) + 1;
+        *out++ = value - prev;
+        prev = value;
+      }
+    }
+    assert(out == out_end);
+
+    return;
+  }
+
+  if (ELIAS_FANO != (header & 3)) {
+    throw index_error(string_utils::to_string(
+      "invalid Elias-Fano block type '%d'",
+      int(header & 3)));
+  }
+
+  // lower bits go to 'decoded' first
+  const uint32_t low = low_bits(universe);
+  if (low) {
+    const size_t required = packed::bytes_required_32(BLOCK_SIZE, low);
+    const auto* buf = in.read_buffer(required, BufferHint::NORMAL);
+
+    if (!buf) {
+#ifdef IRESEARCH_DEBUG
+      const auto read = in.read_bytes(
+        reinterpret_cast<byte_type*>(encoded),
+        required);
+      assert(read == required);
+      UNUSED(read);
+#else
+      in.read_bytes(
+        reinterpret_cast<byte_type*>(encoded),
+        required);
+#endif // IRESEARCH_DEBUG
+
+      buf = reinterpret_cast<const byte_type*>(encoded);
+    }
+
+    ::unpack_block(decoded, reinterpret_cast<const uint32_t*>(buf), low);
+  } else {
+    std::memset(decoded, 0, sizeof(uint32_t)*BLOCK_SIZE);
+  }
+
+  const size_t count = high_words(universe, low);
+  read_words(in, words, count);
+
+  // i-th set bit is at position 'high(i) + i'
+  uint32_t prev = 0;
+  uint32_t i = 0;
+  for (size_t w = 0; w < count && i < BLOCK_SIZE; ++w) {
+    for (uint64_t word = words[w]; word && i < BLOCK_SIZE; word &= word - 1, ++i) {
+      const auto high = uint32_t(64*w + math::ctz64(word)) - i;
+      const uint32_t value = (high << low) | decoded[i];
+      decoded[i] = value - prev;
+      prev = value;
+    }
+  }
+  assert(BLOCK_SIZE == i);
+}
+
+bool write_block(
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t* RESTRICT encoded) {
+  assert(encoded);
+  assert(decoded);
+
+  if (irstd::all_equal(decoded, decoded + BLOCK_SIZE)) {
+    out.write_vlong(make_header(uint64_t(BLOCK_SIZE)*(*decoded), ALL_EQUAL));
+    return false;
+  }
+
+  uint64_t words[MAX_WORDS]{};
+  uint64_t universe = 0;
+  bool positive = true;
+  for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+    universe += decoded[i];
+    positive &= (0 != decoded[i]);
+  }
+
+  const uint32_t low = low_bits(universe);
+  const size_t num_high_words = high_words(universe, low);
+  const size_t ef_size = packed::bytes_required_32(BLOCK_SIZE, low)
+                       + sizeof(uint64_t)*num_high_words;
+
+  // bitset can't represent equal values
+  if (positive && sizeof(uint64_t)*bitset_words(universe) < ef_size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+      value += decoded[i];
+      set_bit(words[(value - 1) / 64], (value - 1) % 64);
+    }
+
+    out.write_vlong(make_header(universe, DENSE));
+    write_words(out, words, bitset_words(universe));
+
+    return true;
+  }
+
+  uint32_t lows[BLOCK_SIZE];
+  const uint32_t mask = (UINT32_C(1) << low) - 1;
+  uint64_t value = 0;
+  for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+    value += decoded[i];
+    lows[i] = uint32_t(value) & mask;
+
+    const uint64_t high = (value >> low) + i;
+    set_bit(words[high / 64], high % 64);
+  }
+
+  out.write_vlong(make_header(universe, ELIAS_FANO));
+
+  if (low) {
+    std::memset(encoded, 0, sizeof(uint32_t)*BLOCK_SIZE);
+    ::pack_block(lows, encoded, low);
+
+    out.write_bytes(
+      reinterpret_cast<const byte_type*>(encoded),
+      packed::bytes_required_32(BLOCK_SIZE, low));
+  }
+
+  write_words(out, words, num_high_words);
+
+  return false;
+}
+
+} // elias_fano
 } // encode
 
 // ----------------------------------------------------------------------------
@@ -448,6 +448,14 @@ class IRESEARCH_API bytes_ref_input : public index_input {
     return irs::vread<uint32_t>(pos_);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief reads up to 'count' variable-size encoded values into 'out'
+  /// @returns number of read values
+  ////////////////////////////////////////////////////////////////////////////
+  size_t read_vlongs(uint64_t* out, size_t count) noexcept {
+    return irs::vread_bulk(pos_, data_.end(), out, count);
+  }
+
   virtual int64_t checksum(size_t offset) const override final;
 
  private:
@@ -566,6 +574,59 @@ IRESEARCH_API uint32_t write_block(
 
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                Elias-Fano encode/decode helpers
+// ----------------------------------------------------------------------------
+//
+// A block of 128 deltas of a non-decreasing sequence is treated as a
+// partition of a partitioned Elias-Fano sequence: prefix sums of the deltas
+// are stored relative to the beginning of the partition, the universe of a
+// partition is the sum of its deltas. Each partition is stored using the
+// most compact of the following representations.
+//
+// Elias-Fano encoded block:
+//   <BlockHeader>
+//     <Universe << 2>
+//   </BlockHeader>
+//   <LowerBits>  (lower 'L = floor(log2(Universe/128))' bits, bit packed)
+//   <UpperBits>  (upper bits, unary coded, 64-bit words)
+//
+// Dense block, all deltas are positive:
+//   <BlockHeader>
+//     <(Universe << 2) | 1>
+//   </BlockHeader>
+//   <Bitset>     (a bit per value in [1, Universe], 64-bit words)
+//
+// In case if all deltas in a block are equal:
+//   <BlockHeader>
+//     <(Universe << 2) | 2>
+//   </BlockHeader>
+//
+// ----------------------------------------------------------------------------
+
+namespace elias_fano {
+
+// skip block of 128 integers that was previously
+// written with the corresponding 'write_block' function
+IRESEARCH_API void skip_block(index_input& in);
+
+// reads block of 128 deltas from the stream
+// that was previously encoded with the corresponding
+// 'write_block' function
+IRESEARCH_API void read_block(
+  data_input& in,
+  uint32_t* RESTRICT encoded,
+  uint32_t* RESTRICT decoded);
+
+// writes block of 128 deltas of a non-decreasing sequence to a stream
+// returns true if a block was stored as a bitset
+IRESEARCH_API bool write_block(
+  data_output& out,
+  const uint32_t* RESTRICT decoded,
+  uint32_t* RESTRICT encoded);
+
+} // elias_fano
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      delta encode/decode helpers
 // ----------------------------------------------------------------------------
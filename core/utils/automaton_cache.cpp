@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "automaton_cache.hpp"
+
+#include "utils/automaton_utils.hpp"
+#include "utils/levenshtein_default_pdp.hpp"
+#include "utils/levenshtein_utils.hpp"
+#include "utils/wildcard_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+// leading byte of a cache key denoting type of the cached automaton
+enum class key_type : byte_type {
+  WILDCARD = 0,
+  LEVENSHTEIN
+};
+
+// validates a built automaton before it gets shared between threads since
+// testing automaton properties (in debug builds) mutates the automaton
+automaton_cache::ptr build(const automaton_cache::factory_f& factory) {
+  auto a = factory();
+
+  if (!validate(a)) {
+    return nullptr;
+  }
+
+  return std::make_shared<const automaton>(std::move(a));
+}
+
+}
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    automaton_cache implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ automaton_cache& automaton_cache::global() noexcept {
+  static automaton_cache INSTANCE;
+  return INSTANCE;
+}
+
+automaton_cache::automaton_cache(size_t max_memory /*= DEFAULT_MAX_MEMORY*/)
+  : max_memory_(max_memory) {
+}
+
+/*static*/ size_t automaton_cache::memory(const automaton& a) noexcept {
+  using state_t = fst::fsa::AutomatonState<automaton::Weight>;
+
+  // each state is allocated separately and referred by a pointer
+  size_t memory = sizeof(automaton) +
+    a.NumStates()*(sizeof(state_t) + sizeof(state_t*));
+
+  for (automaton::StateId s = 0, n = a.NumStates(); s < n; ++s) {
+    memory += a.NumArcs(s)*sizeof(automaton::Arc);
+  }
+
+  return memory;
+}
+
+automaton_cache::ptr automaton_cache::get(
+    const bytes_ref& key,
+    const factory_f& factory) {
+  assert(factory);
+  bstring cache_key(key.c_str(), key.size());
+
+  size_t max_memory;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (const auto* value = cache_.get(cache_key); value) {
+      ++hits_;
+      return *value;
+    }
+
+    ++misses_;
+    max_memory = max_memory_;
+  }
+
+  // build automaton without holding a lock
+  auto value = build(factory);
+
+  if (!value) {
+    return value;
+  }
+
+  const size_t value_memory = cache_key.size() + memory(*value);
+
+  if (value_memory > max_memory) {
+    // automaton doesn't fit the cache at all
+    return value;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // automaton may have been built concurrently
+  auto res = cache_.emplace(cache_key, std::move(value), value_memory);
+  auto& cached = *res.first;
+
+  if (res.second) {
+    auto result = cached; // may be evicted by 'shrink'
+    cache_.shrink(max_memory_);
+    return result;
+  }
+
+  return cached;
+}
+
+automaton_cache::ptr automaton_cache::wildcard(const bytes_ref& expr) {
+  bstring key;
+  key.reserve(1 + expr.size());
+  key += byte_type(key_type::WILDCARD);
+  key.append(expr.c_str(), expr.size());
+
+  return get(key, [&expr](){ return from_wildcard(expr); });
+}
+
+automaton_cache::ptr automaton_cache::levenshtein(
+    byte_type max_distance,
+    bool with_transpositions,
+    const bytes_ref& target) {
+  const auto& description = default_pdp(max_distance, with_transpositions);
+
+  if (!description) {
+    return nullptr;
+  }
+
+  bstring key;
+  key.reserve(3 + target.size());
+  key += byte_type(key_type::LEVENSHTEIN);
+  key += max_distance;
+  key += byte_type(with_transpositions);
+  key.append(target.c_str(), target.size());
+
+  return get(key, [&description, &target](){
+    return make_levenshtein_automaton(description, target);
+  });
+}
+
+void automaton_cache::max_memory(size_t max_memory) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_memory_ = max_memory;
+  cache_.shrink(max_memory_);
+}
+
+automaton_cache::stats automaton_cache::statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  stats result;
+  result.hits = hits_;
+  result.misses = misses_;
+  result.size = cache_.size();
+  result.memory = cache_.memory();
+  result.max_memory = max_memory_;
+
+  return result;
+}
+
+void automaton_cache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+}
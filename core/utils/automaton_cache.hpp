@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_AUTOMATON_CACHE_H
+#define IRESEARCH_AUTOMATON_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "automaton.hpp"
+#include "utils/hash_utils.hpp"
+#include "utils/lru_cache.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class automaton_cache
+/// @brief thread-safe LRU cache of compiled automatons, allows to avoid
+///        building the same automaton for frequently repeated queries,
+///        e.g. wildcard or levenshtein ones, bounded by the estimated
+///        amount of memory consumed by cached automatons
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API automaton_cache : private util::noncopyable {
+ public:
+  using ptr = std::shared_ptr<const automaton>;
+  using factory_f = std::function<automaton()>;
+
+  struct stats {
+    uint64_t hits{}; // number of requests served from the cache
+    uint64_t misses{}; // number of requests which caused automaton building
+    size_t size{}; // number of cached automatons
+    size_t memory{}; // estimated memory consumed by cached automatons
+    size_t max_memory{}; // max memory consumed by cached automatons
+  };
+
+  static constexpr size_t DEFAULT_MAX_MEMORY = 16*(1 << 20); // 16MB
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide cache used by the filters
+  ////////////////////////////////////////////////////////////////////////////
+  static automaton_cache& global() noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @param max_memory max memory in bytes consumed by cached automatons,
+  ///        0 disables caching
+  ////////////////////////////////////////////////////////////////////////////
+  explicit automaton_cache(size_t max_memory = DEFAULT_MAX_MEMORY);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns automaton cached for a specified key, or the one produced
+  ///          by a specified factory otherwise, nullptr if the produced
+  ///          automaton isn't a valid acceptor
+  /// @note 'factory' is called without holding a lock
+  /// @note automatons exceeding the memory limit on their own aren't cached
+  /// @note returned automaton is already validated and may be shared between
+  ///       threads, its properties must not be tested again, e.g. matchers
+  ///       must be created with 'test_props = false'
+  ////////////////////////////////////////////////////////////////////////////
+  ptr get(const bytes_ref& key, const factory_f& factory);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns automaton accepting a specified wildcard expression
+  ///          as produced by 'from_wildcard(...)'
+  ////////////////////////////////////////////////////////////////////////////
+  ptr wildcard(const bytes_ref& expr);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns automaton accepting terms within a specified edit distance
+  ///          from a specified target as produced by
+  ///          'make_levenshtein_automaton(...)' for a description returned
+  ///          by 'default_pdp(...)', nullptr if there is no such description
+  ////////////////////////////////////////////////////////////////////////////
+  ptr levenshtein(
+    byte_type max_distance,
+    bool with_transpositions,
+    const bytes_ref& target);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets max memory in bytes consumed by cached automatons, evicts
+  ///        least recently used automatons exceeding the limit
+  ////////////////////////////////////////////////////////////////////////////
+  void max_memory(size_t max_memory);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns estimated amount of memory in bytes consumed by a specified
+  ///          automaton, which is accounted by the cache
+  ////////////////////////////////////////////////////////////////////////////
+  static size_t memory(const automaton& a) noexcept;
+
+  stats statistics() const;
+
+  void clear();
+
+ private:
+  struct key_hash {
+    size_t operator()(const bstring& key) const noexcept {
+      return hash(key.c_str(), key.size());
+    }
+  };
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  mutable std::mutex mutex_;
+  lru_cache<bstring, ptr, key_hash> cache_;
+  size_t max_memory_;
+  uint64_t hits_{};
+  uint64_t misses_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // automaton_cache
+
+}
+
+#endif // IRESEARCH_AUTOMATON_CACHE_H
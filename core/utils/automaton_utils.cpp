@@ -404,8 +404,9 @@ filter::prepared::ptr prepare_automaton_filter(
     size_t scored_terms_limit,
     const index_reader& index,
     const order::prepared& order,
-    boost_t boost) {
-  auto matcher = make_automaton_matcher(acceptor);
+    boost_t boost,
+    bool test_props /*= TEST_AUTOMATON_PROPS*/) {
+  auto matcher = make_automaton_matcher(acceptor, test_props);
 
   if (fst::kError == matcher.Properties(0)) {
     IR_FRMT_ERROR("Expected deterministic, epsilon-free acceptor, "
@@ -506,6 +506,8 @@ inline automaton make_all() {
 /// @param index index reader
 /// @param order compiled order
 /// @param bool query boost
+/// @param test_props test properties of the specified automaton, must be
+///        false for automatons shared between threads
 /// @returns compiled filter
 //////////////////////////////////////////////////////////////////////////////
 IRESEARCH_API filter::prepared::ptr prepare_automaton_filter(
@@ -514,7 +516,8 @@ IRESEARCH_API filter::prepared::ptr prepare_automaton_filter(
   size_t scored_terms_limit,
   const index_reader& index,
   const order::prepared& order,
-  boost_t boost);
+  boost_t boost,
+  bool test_props = TEST_AUTOMATON_PROPS);
 
 }
 
@@ -24,8 +24,16 @@
 #include "shared.hpp"
 #include "bit_packing.hpp"
 
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <utility>
+
+#include "cpuinfo.hpp"
+
+#ifdef IRESEARCH_SSE2
+#include <immintrin.h>
+#endif
 
 namespace {
 
@@ -280,6 +288,188 @@ FORCE_INLINE void __fastunpack<64>(const uint64_t* RESTRICT in, uint64_t* RESTRI
   std::memcpy(out, in, sizeof(uint64_t)*irs::packed::BLOCK_SIZE_64);
 }
 
+#ifdef IRESEARCH_SSE2
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           AVX2/AVX-512 unpacking
+// -----------------------------------------------------------------------------
+//
+// A group of consecutive values 'First, First+1, ...' of a block packed with
+// 'N' bits is unpacked at once:
+//   - words starting at the first word of the group are loaded into a vector,
+//     masked loads never touch memory beyond the end of a block
+//   - every lane gets the word holding the lower part of its value and the
+//     next word holding the upper part (if any) via permutation
+//   - the parts are aligned by variable shifts and merged
+// All permutation indices, shifts and load masks are compile time constants.
+
+template<int N, int First, int... I>
+struct __unpack_group {
+  static_assert(N > 0 && N < 32, "N <= 0 || N >= 32");
+
+  static constexpr int BASE = (First*N) / 32; // first word of a group
+  static constexpr int WORD[]{ (((First + I)*N) / 32 - BASE)... };
+  static constexpr int SHIFT[]{ (((First + I)*N) % 32)... };
+  static constexpr int SHIFT_HIGH[]{ (32 - ((First + I)*N) % 32)... };
+  static constexpr int LOAD_LOW[]{ (BASE + I < N ? -1 : 0)... };
+  static constexpr int LOAD_HIGH[]{ (BASE + 1 + I < N ? -1 : 0)... };
+  static constexpr uint32_t MASK = (1U << N) - 1;
+}; // __unpack_group
+
+template<int N, int First, int... I>
+IRESEARCH_TARGET("avx2")
+inline void __avx2unpack(
+    const uint32_t* RESTRICT in,
+    uint32_t* RESTRICT out,
+    std::integer_sequence<int, I...>) noexcept {
+  static_assert(8 == sizeof...(I));
+  using group = __unpack_group<N, First, I...>;
+
+  const auto* words = reinterpret_cast<const int*>(in) + group::BASE;
+
+  const __m256i word = _mm256_loadu_si256(
+    reinterpret_cast<const __m256i*>(group::WORD));
+  const __m256i low = _mm256_permutevar8x32_epi32(
+    _mm256_maskload_epi32(
+      words, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group::LOAD_LOW))),
+    word);
+  const __m256i high = _mm256_permutevar8x32_epi32(
+    _mm256_maskload_epi32(
+      words + 1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group::LOAD_HIGH))),
+    word);
+
+  // shift by 32 yields 0 for values not crossing a word boundary
+  const __m256i value = _mm256_and_si256(
+    _mm256_or_si256(
+      _mm256_srlv_epi32(
+        low, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group::SHIFT))),
+      _mm256_sllv_epi32(
+        high, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group::SHIFT_HIGH)))),
+    _mm256_set1_epi32(int(group::MASK)));
+
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + First), value);
+}
+
+template<int N>
+IRESEARCH_TARGET("avx2")
+void __avx2unpack(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) noexcept {
+  if constexpr (32 == N) {
+    std::memcpy(out, in, sizeof(uint32_t)*irs::packed::BLOCK_SIZE_32);
+  } else {
+    constexpr std::make_integer_sequence<int, 8> LANES;
+    __avx2unpack<N, 0>(in, out, LANES);
+    __avx2unpack<N, 8>(in, out, LANES);
+    __avx2unpack<N, 16>(in, out, LANES);
+    __avx2unpack<N, 24>(in, out, LANES);
+  }
+}
+
+template<int N, int First, int... I>
+IRESEARCH_TARGET("avx512f")
+inline void __avx512unpack(
+    const uint32_t* RESTRICT in,
+    uint32_t* RESTRICT out,
+    std::integer_sequence<int, I...>) noexcept {
+  static_assert(16 == sizeof...(I));
+  using group = __unpack_group<N, First, I...>;
+
+  constexpr __mmask16 LOAD_LOW = ((uint32_t(0 != group::LOAD_LOW[I]) << I) | ...);
+  constexpr __mmask16 LOAD_HIGH = ((uint32_t(0 != group::LOAD_HIGH[I]) << I) | ...);
+
+  const auto* words = in + group::BASE;
+
+  // zero-masking forms with all lanes selected are used since
+  // unmasked ones pass an undefined source operand to the builtins
+  constexpr __mmask16 ALL = 0xFFFF;
+
+  const __m512i word = _mm512_loadu_si512(group::WORD);
+  const __m512i low = _mm512_maskz_permutexvar_epi32(
+    ALL, word, _mm512_maskz_loadu_epi32(LOAD_LOW, words));
+  const __m512i high = _mm512_maskz_permutexvar_epi32(
+    ALL, word, _mm512_maskz_loadu_epi32(LOAD_HIGH, words + 1));
+
+  // shift by 32 yields 0 for values not crossing a word boundary
+  const __m512i value = _mm512_and_si512(
+    _mm512_or_si512(
+      _mm512_maskz_srlv_epi32(ALL, low, _mm512_loadu_si512(group::SHIFT)),
+      _mm512_maskz_sllv_epi32(ALL, high, _mm512_loadu_si512(group::SHIFT_HIGH))),
+    _mm512_set1_epi32(int(group::MASK)));
+
+  _mm512_storeu_si512(out + First, value);
+}
+
+template<int N>
+IRESEARCH_TARGET("avx512f")
+void __avx512unpack(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) noexcept {
+  if constexpr (32 == N) {
+    std::memcpy(out, in, sizeof(uint32_t)*irs::packed::BLOCK_SIZE_32);
+  } else {
+    constexpr std::make_integer_sequence<int, 16> LANES;
+    __avx512unpack<N, 0>(in, out, LANES);
+    __avx512unpack<N, 16>(in, out, LANES);
+  }
+}
+
+#endif // IRESEARCH_SSE2
+
+using irs::packed::unpack_block32_f;
+using unpack_block32_table = std::array<unpack_block32_f, irs::packed::BLOCK_SIZE_32>;
+
+template<template<int> class Kernel, int... N>
+constexpr unpack_block32_table make_unpack_block32_table(
+    std::integer_sequence<int, N...>) noexcept {
+  return {{ &Kernel<N + 1>::unpack... }};
+}
+
+template<int N>
+struct fast_unpack {
+  static void unpack(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) noexcept {
+    __fastunpack<N>(in, out);
+  }
+};
+
+#ifdef IRESEARCH_SSE2
+
+template<int N>
+struct avx2_unpack {
+  static void unpack(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) noexcept {
+    __avx2unpack<N>(in, out);
+  }
+};
+
+template<int N>
+struct avx512_unpack {
+  static void unpack(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) noexcept {
+    __avx512unpack<N>(in, out);
+  }
+};
+
+#endif // IRESEARCH_SSE2
+
+constexpr std::make_integer_sequence<int, irs::packed::BLOCK_SIZE_32> BITS;
+
+constexpr auto SCALAR_UNPACK_BLOCK32 = make_unpack_block32_table<fast_unpack>(BITS);
+#ifdef IRESEARCH_SSE2
+constexpr auto AVX2_UNPACK_BLOCK32 = make_unpack_block32_table<avx2_unpack>(BITS);
+constexpr auto AVX512_UNPACK_BLOCK32 = make_unpack_block32_table<avx512_unpack>(BITS);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @returns the fastest kernels for unpacking 32-bit blocks on the host CPU,
+///          indexed by the number of bits minus 1
+////////////////////////////////////////////////////////////////////////////////
+const unpack_block32_f* best_unpack_block32_kernels() noexcept {
+  using irs::packed::unpack_isa;
+
+  for (const auto isa : { unpack_isa::AVX512, unpack_isa::AVX2 }) {
+    if (const auto* kernels = irs::packed::unpack_block32_kernels(isa)) {
+      return kernels;
+    }
+  }
+
+  return SCALAR_UNPACK_BLOCK32.data();
+}
+
 template<int N, int I>
 FORCE_INLINE uint32_t __fastpack_at(const uint32_t* in) noexcept {
   // 32 == sizeof(uint32_t) * 8
@@ -668,44 +858,30 @@ void pack_block(const uint64_t* RESTRICT in,
   }
 }
 
+const unpack_block32_f* unpack_block32_kernels(unpack_isa isa) noexcept {
+  switch (isa) {
+    case unpack_isa::SCALAR:
+      return SCALAR_UNPACK_BLOCK32.data();
+#ifdef IRESEARCH_SSE2
+    case unpack_isa::AVX2:
+      return cpuinfo::support_avx2() ? AVX2_UNPACK_BLOCK32.data() : nullptr;
+    case unpack_isa::AVX512:
+      return cpuinfo::support_avx512() ? AVX512_UNPACK_BLOCK32.data() : nullptr;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
 void unpack_block(const uint32_t* RESTRICT in,
                   uint32_t* RESTRICT out,
                   const uint32_t bit) noexcept {
-  switch (bit) {
-    case 1:   __fastunpack<1>(in, out); break;
-    case 2:   __fastunpack<2>(in, out); break;
-    case 3:   __fastunpack<3>(in, out); break;
-    case 4:   __fastunpack<4>(in, out); break;
-    case 5:   __fastunpack<5>(in, out); break;
-    case 6:   __fastunpack<6>(in, out); break;
-    case 7:   __fastunpack<7>(in, out); break;
-    case 8:   __fastunpack<8>(in, out); break;
-    case 9:   __fastunpack<9>(in, out); break;
-    case 10: __fastunpack<10>(in, out); break;
-    case 11: __fastunpack<11>(in, out); break;
-    case 12: __fastunpack<12>(in, out); break;
-    case 13: __fastunpack<13>(in, out); break;
-    case 14: __fastunpack<14>(in, out); break;
-    case 15: __fastunpack<15>(in, out); break;
-    case 16: __fastunpack<16>(in, out); break;
-    case 17: __fastunpack<17>(in, out); break;
-    case 18: __fastunpack<18>(in, out); break;
-    case 19: __fastunpack<19>(in, out); break;
-    case 20: __fastunpack<20>(in, out); break;
-    case 21: __fastunpack<21>(in, out); break;
-    case 22: __fastunpack<22>(in, out); break;
-    case 23: __fastunpack<23>(in, out); break;
-    case 24: __fastunpack<24>(in, out); break;
-    case 25: __fastunpack<25>(in, out); break;
-    case 26: __fastunpack<26>(in, out); break;
-    case 27: __fastunpack<27>(in, out); break;
-    case 28: __fastunpack<28>(in, out); break;
-    case 29: __fastunpack<29>(in, out); break;
-    case 30: __fastunpack<30>(in, out); break;
-    case 31: __fastunpack<31>(in, out); break;
-    case 32: __fastunpack<32>(in, out); break;
-    default: assert(false); break;
-  }
+  // resolved lazily since 'cpuinfo' may be not initialized yet
+  // during static initialization
+  static const unpack_block32_f* KERNELS = best_unpack_block32_kernels();
+
+  assert(bit >= 1 && bit <= BLOCK_SIZE_32);
+  KERNELS[bit - 1](in, out);
 }
 
 void unpack_block(const uint64_t* RESTRICT in,
@@ -816,8 +992,13 @@ void pack(const uint64_t* first, const uint64_t* last,
 
 void unpack(uint32_t* first, uint32_t* last,
             const uint32_t* in, const uint32_t bit) noexcept {
+  static const unpack_block32_f* KERNELS = best_unpack_block32_kernels();
+
+  assert(bit >= 1 && bit <= BLOCK_SIZE_32);
+  const auto unpack_block = KERNELS[bit - 1];
+
   for (; first < last; first += BLOCK_SIZE_32, in += bit) {
-    unpack_block(in, first, bit);
+    unpack_block(in, first);
   }
 }
 
@@ -149,6 +149,25 @@ IRESEARCH_API void unpack_block(
   uint32_t* RESTRICT out,
   const uint32_t bit) noexcept;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief instruction sets of kernels unpacking 32-bit blocks
+////////////////////////////////////////////////////////////////////////////////
+enum class unpack_isa {
+  SCALAR,
+  AVX2,
+  AVX512
+};
+
+using unpack_block32_f = void(*)(const uint32_t* RESTRICT, uint32_t* RESTRICT) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @returns kernels unpacking 32-bit blocks with a specified instruction set
+///          indexed by the number of bits minus 1, nullptr if the instruction
+///          set isn't supported by the host CPU
+/// @note 'unpack_block' and 'unpack' use the fastest supported kernels
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API const unpack_block32_f* unpack_block32_kernels(unpack_isa isa) noexcept;
+
 IRESEARCH_API void unpack(
   uint64_t* first, 
   uint64_t* last, 
@@ -155,6 +155,7 @@ class dynamic_bitset : public dynamic_bitset_base<Alloc> {
   size_t words() const noexcept { return words_; }
 
   const word_t* data() const noexcept { return data_.get(); }
+  word_t* data() noexcept { return data_.get(); }
 
   const word_t* begin() const noexcept { return data(); }
   const word_t* end() const noexcept { return data() + words_; }
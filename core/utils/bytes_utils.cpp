@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "bytes_utils.hpp"
+
+#include <cstring>
+
+#include "utils/cpuinfo.hpp"
+
+#ifdef IRESEARCH_SSE2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using namespace irs;
+
+using vread_bulk_f = size_t(*)(const byte_type*&, const byte_type*, uint64_t*, size_t);
+
+constexpr size_t MAX_VSIZE = bytes_io<uint64_t>::const_max_vsize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads a value which may be truncated by 'end'
+/// @returns false if the value isn't entirely contained in [begin, end)
+////////////////////////////////////////////////////////////////////////////////
+bool vread_checked(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t& value) noexcept {
+  uint64_t out = 0;
+  size_t shift = 0;
+
+  for (auto* it = begin; it != end && shift < 64; ++it, shift += 7) {
+    out |= uint64_t(*it & 0x7F) << shift;
+
+    if (!(*it & 0x80)) {
+      begin = it + 1;
+      value = out;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t vread_bulk_scalar(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t* out,
+    size_t count) noexcept {
+  const auto* out_begin = out;
+  const auto* out_end = out + count;
+
+  // no bounds checks until the last 'MAX_VSIZE' bytes
+  for (; out != out_end && size_t(end - begin) >= MAX_VSIZE; ++out) {
+    *out = vread<uint64_t>(begin);
+  }
+
+  for (; out != out_end && vread_checked(begin, end, *out); ++out) { }
+
+  return size_t(out - out_begin);
+}
+
+#ifdef IRESEARCH_SSE2
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decodes values from a window of 'Traits::WIDTH' bytes at once:
+///        the continuation bits of the whole window are gathered into a mask
+///        giving the boundaries of all values in the window, single byte
+///        values (the vast majority for metadata deltas) are emitted directly
+///        while longer ones are assembled from a single 64-bit load
+////////////////////////////////////////////////////////////////////////////////
+template<typename Traits>
+FORCE_INLINE size_t vread_bulk_simd(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t* out,
+    size_t count) noexcept {
+  constexpr size_t WIDTH = Traits::WIDTH;
+  constexpr uint64_t WINDOW_MASK = WIDTH < 64
+    ? (UINT64_C(1) << WIDTH) - 1
+    : ~UINT64_C(0);
+
+  const auto* out_begin = out;
+  const auto* out_end = out + count;
+
+  while (out != out_end && size_t(end - begin) >= WIDTH) {
+    // bit is set for the last byte of every value in the window
+    uint64_t last = ~Traits::continuation_mask(begin) & WINDOW_MASK;
+
+    if (!last) {
+      break; // malformed value, let scalar decoder deal with it
+    }
+
+    size_t pos = 0;
+    for (; last && out != out_end; last &= last - 1, ++out) {
+      const size_t next = size_t(math::ctz64(last)) + 1;
+      const size_t size = next - pos;
+
+      if (1 == size) {
+        *out = begin[pos];
+      } else if (size <= sizeof(uint64_t) && pos + sizeof(uint64_t) <= WIDTH) {
+        uint64_t word;
+        std::memcpy(&word, begin + pos, sizeof word);
+        *out = Traits::extract(word, size);
+      } else {
+        const auto* value = begin + pos;
+        *out = vread<uint64_t>(value);
+      }
+
+      pos = next;
+    }
+
+    begin += pos;
+  }
+
+  return size_t(out - out_begin)
+    + vread_bulk_scalar(begin, end, out, size_t(out_end - out));
+}
+
+// payload bits of the first 'size' bytes of a little-endian word
+constexpr uint64_t payload_mask(size_t size) noexcept {
+  return UINT64_C(0x7F7F7F7F7F7F7F7F) >> (8*(sizeof(uint64_t) - size));
+}
+
+struct sse2_traits {
+  static constexpr size_t WIDTH = 16;
+
+  static FORCE_INLINE uint64_t continuation_mask(const byte_type* in) noexcept {
+    return uint32_t(_mm_movemask_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(in))));
+  }
+
+  static FORCE_INLINE uint64_t extract(uint64_t word, size_t size) noexcept {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i, word >>= 8) {
+      value |= (word & 0x7F) << (7*i);
+    }
+    return value;
+  }
+};
+
+// NOTE: functions are intentionally not forcibly inlined since they can't be
+// inlined into a generic kernel, they get inlined into the entry point
+struct avx2_traits {
+  static constexpr size_t WIDTH = 32;
+
+  IRESEARCH_TARGET("avx2,bmi2")
+  static inline uint64_t continuation_mask(const byte_type* in) noexcept {
+    return uint32_t(_mm256_movemask_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))));
+  }
+
+  IRESEARCH_TARGET("avx2,bmi2")
+  static inline uint64_t extract(uint64_t word, size_t size) noexcept {
+    return _pext_u64(word, payload_mask(size));
+  }
+};
+
+size_t vread_bulk_sse2(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t* out,
+    size_t count) noexcept {
+  return vread_bulk_simd<sse2_traits>(begin, end, out, count);
+}
+
+IRESEARCH_TARGET("avx2,bmi2")
+size_t vread_bulk_avx2(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t* out,
+    size_t count) noexcept {
+  return vread_bulk_simd<avx2_traits>(begin, end, out, count);
+}
+
+#endif // IRESEARCH_SSE2
+
+vread_bulk_f resolve_vread_bulk() noexcept {
+#ifdef IRESEARCH_SSE2
+  if (cpuinfo::support_avx2() && cpuinfo::support_bmi2()) {
+    return &vread_bulk_avx2;
+  }
+
+  return &vread_bulk_sse2;
+#else
+  return &vread_bulk_scalar;
+#endif
+}
+
+}
+
+namespace iresearch {
+
+size_t vread_bulk(
+    const byte_type*& begin,
+    const byte_type* end,
+    uint64_t* out,
+    size_t count) noexcept {
+  // resolved lazily since 'cpuinfo' may be not initialized yet
+  // during static initialization
+  static const vread_bulk_f IMPL = resolve_vread_bulk();
+
+  assert(begin <= end);
+  return IMPL(begin, end, out, count);
+}
+
+}
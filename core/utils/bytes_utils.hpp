@@ -379,6 +379,20 @@ inline T zvread(Iterator& in) {
     in, typename std::iterator_traits<Iterator>::iterator_category());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read up to 'count' variable-size encoded values from [begin, end)
+///        into 'out', only values entirely contained in the range are read
+///        will increment 'begin' to position after the end of the last read
+///        value
+/// @returns number of read values
+/// @note values are decoded by SIMD kernels chosen for the host CPU at runtime
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API size_t vread_bulk(
+  const byte_type*& begin,
+  const byte_type* end,
+  uint64_t* out,
+  size_t count) noexcept;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                              exported functions for writing bytes
 // -----------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 #ifndef IRESEARCH_DLL
   #include "lz4compression.hpp"
   #include "delta_compression.hpp"
+  #include "zstdcompression.hpp"
 #endif
 
 namespace {
@@ -168,6 +169,9 @@ void init() {
 #ifndef IRESEARCH_DLL
   lz4::init();
   delta::init();
+#ifdef USE_ZSTD
+  zstd::init();
+#endif
   none::init();
 #endif
 }
@@ -62,8 +62,14 @@ struct options {
   /// @brief
   Hint hint{ Hint::DEFAULT };
 
-  options(Hint hint = Hint::DEFAULT)
-    : hint(hint) {
+  /// @brief allow compressor to train a dictionary on the data being
+  ///        compressed and to store it along with the column metadata
+  /// @note the dictionary contains fragments of the data, it's never used for
+  ///       encrypted columns since the column metadata isn't encrypted
+  bool dictionary{ true };
+
+  options(Hint hint = Hint::DEFAULT, bool dictionary = true)
+    : hint(hint), dictionary(dictionary) {
   }
 };
 
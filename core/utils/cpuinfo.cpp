@@ -30,11 +30,83 @@ namespace iresearch {
 
 const cpuinfo cpuinfo::instance_;
 
+cpuinfo::cpuinfo() {
+  int f0_cpuinfo[4];
+  __cpuid(f0_cpuinfo, 0);
+  __cpuid(f1_cpuinfo_, 1);
+
+  if (f0_cpuinfo[0] >= 7) {
+    __cpuidex(f7_cpuinfo_, 7, 0);
+  }
+
+  // OSXSAVE is set and XMM/YMM state is enabled in XCR0
+  os_avx_ = check_bit<27>(f1_cpuinfo_[2])
+    && 6 == (_xgetbv(0) & 6);
+
+  // opmask and ZMM state is enabled in XCR0 as well
+  os_avx512_ = os_avx_ && 0xE6 == (_xgetbv(0) & 0xE6);
+}
+
 /*static*/ bool cpuinfo::support_popcnt() {
   // according to https://msdn.microsoft.com/en-us/library/bb385231.aspx
   return check_bit<23>(instance_.f1_cpuinfo_[2]);
 }
 
+/*static*/ bool cpuinfo::support_bmi2() {
+  // according to https://docs.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
+  return check_bit<8>(instance_.f7_cpuinfo_[1]);
+}
+
+/*static*/ bool cpuinfo::support_avx2() {
+  // according to https://docs.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
+  return instance_.os_avx_ && check_bit<5>(instance_.f7_cpuinfo_[1]);
+}
+
+/*static*/ bool cpuinfo::support_avx512() {
+  // according to https://docs.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
+  return instance_.os_avx512_ && check_bit<16>(instance_.f7_cpuinfo_[1]);
+}
+
+}
+
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+namespace iresearch {
+
+// NOTE: '__builtin_cpu_init' must be called before '__builtin_cpu_supports'
+// in case if the latter is used during static initialization
+
+/*static*/ bool cpuinfo::support_popcnt() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("popcnt");
+}
+
+/*static*/ bool cpuinfo::support_bmi2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("bmi2");
+}
+
+/*static*/ bool cpuinfo::support_avx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+/*static*/ bool cpuinfo::support_avx512() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f");
+}
+
+}
+
+#else
+
+namespace iresearch {
+
+/*static*/ bool cpuinfo::support_popcnt() { return false; }
+/*static*/ bool cpuinfo::support_bmi2() { return false; }
+/*static*/ bool cpuinfo::support_avx2() { return false; }
+/*static*/ bool cpuinfo::support_avx512() { return false; }
+
 }
 
 #endif
@@ -23,28 +23,39 @@
 #ifndef IRESEARCH_CPUID_ID
 #define IRESEARCH_CPUID_ID
 
-#if defined(_MSC_VER)
-
 #include "shared.hpp"
+
+#if defined(_MSC_VER)
 #include <intrin.h>
+#endif
 
 namespace iresearch {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class cpuinfo
+/// @brief instruction set extensions supported by the host CPU
+/// @note all checks return 'false' on non-x86 platforms
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API cpuinfo {
  public:
   static bool support_popcnt();
+  static bool support_bmi2();
+  static bool support_avx2();
+  static bool support_avx512(); // AVX-512 Foundation
+
+#if defined(_MSC_VER)
  private:
   static const cpuinfo instance_;
 
-  cpuinfo() {
-    __cpuid( f1_cpuinfo_, 1 );
-  }
+  cpuinfo();
 
-  int f1_cpuinfo_[4];
+  int f1_cpuinfo_[4]{};
+  int f7_cpuinfo_[4]{};
+  bool os_avx_{}; // OS saves AVX registers on context switch
+  bool os_avx512_{}; // OS saves AVX-512 registers on context switch
+#endif
 };
 
 }
 
 #endif
-
-#endif
@@ -479,6 +479,19 @@ void read_document_mask(
   reader->read(dir, meta, docs_mask);
 }
 
+void read_document_mask(
+    bitset& dense,
+    std::vector<doc_id_t>& sparse,
+    const directory& dir,
+    const segment_meta& meta) {
+  if (!segment_reader::has<document_mask_reader>(meta)) {
+    return; // nothing to read
+  }
+
+  auto reader = meta.codec->get_document_mask_reader();
+  reader->read(dir, meta, dense, sparse);
+}
+
 void flush_index_segment(directory& dir, index_meta::index_segment_t& segment) {
   assert(segment.meta.codec);
   assert(!segment.meta.size); // assume segment size will be calculated in a single place, here
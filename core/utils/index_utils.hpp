@@ -128,6 +128,16 @@ IRESEARCH_API index_writer::consolidation_policy_t consolidation_policy(
 
 void read_document_mask(document_mask& docs_mask, const directory& dir, const segment_meta& meta);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads document mask in the form it's stored, either into 'dense'
+///        or into 'sparse' (@see document_mask_reader::read(...))
+////////////////////////////////////////////////////////////////////////////////
+void read_document_mask(
+  bitset& dense,
+  std::vector<doc_id_t>& sparse,
+  const directory& dir,
+  const segment_meta& meta);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief writes segment_meta to the supplied directory
 ///        updates index_meta::index_segment_t::filename to the segment filename
@@ -770,4 +770,125 @@ bool edit_distance(
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                         bit_parallel_edit_distance implementation
+// -----------------------------------------------------------------------------
+
+bit_parallel_edit_distance::bit_parallel_edit_distance(
+    const bytes_ref& target,
+    byte_type max_distance,
+    bool with_transpositions)
+  : max_distance_(max_distance),
+    with_transpositions_(with_transpositions) {
+  if (!utf8_utils::utf8_to_utf32<true>(target, std::back_inserter(buf_))
+      || buf_.size() > MAX_TARGET_SIZE) {
+    return;
+  }
+
+  target_size_ = buf_.size();
+
+  for (size_t i = 0; i < target_size_; ++i) {
+    const uint32_t c = buf_[i];
+    const uint64_t bit = uint64_t(1) << i;
+
+    if (c < std::size(ascii_masks_)) {
+      ascii_masks_[c] |= bit;
+    } else {
+      masks_.emplace_back(c, bit);
+    }
+  }
+
+  // merge masks of the same symbols
+  std::sort(masks_.begin(), masks_.end());
+  auto last = masks_.begin();
+  for (auto it = masks_.begin(), end = masks_.end(); it != end; ++it) {
+    if (it->first != last->first) {
+      *++last = *it;
+    } else if (it != last) {
+      last->second |= it->second;
+    }
+  }
+  if (!masks_.empty()) {
+    masks_.erase(last + 1, masks_.end());
+  }
+
+  valid_ = true;
+}
+
+uint64_t bit_parallel_edit_distance::mask(uint32_t c) const noexcept {
+  if (c < std::size(ascii_masks_)) {
+    return ascii_masks_[c];
+  }
+
+  const auto it = std::lower_bound(
+    masks_.begin(), masks_.end(), c,
+    [](const std::pair<uint32_t, uint64_t>& lhs, uint32_t rhs) noexcept {
+      return lhs.first < rhs;
+  });
+
+  return it != masks_.end() && it->first == c ? it->second : 0;
+}
+
+size_t bit_parallel_edit_distance::operator()(const bytes_ref& rhs) {
+  assert(valid_);
+  const size_t no_match = size_t(max_distance_) + 1;
+
+  buf_.clear();
+  if (!utf8_utils::utf8_to_utf32<true>(rhs, std::back_inserter(buf_))) {
+    return no_match;
+  }
+
+  const size_t size = buf_.size();
+
+  // edit distance can't be less than the difference of lengths
+  if (abs_diff(uint32_t(target_size_), uint32_t(size)) > max_distance_) {
+    return no_match;
+  }
+
+  if (!target_size_) {
+    return size;
+  }
+
+  // columns of the dynamic programming matrix are encoded via vertical
+  // positive/negative deltas, only the value of the last row is tracked
+  const uint64_t last_row = uint64_t(1) << (target_size_ - 1);
+  uint64_t vp = ~uint64_t(0);
+  uint64_t vn = 0;
+  uint64_t d0 = 0;
+  uint64_t prev_eq = 0;
+  size_t distance = target_size_;
+
+  for (size_t i = 0; i < size; ++i) {
+    const uint64_t eq = mask(buf_[i]);
+
+    uint64_t tr = 0;
+    if (with_transpositions_) {
+      tr = (((~d0) & eq) << 1) & prev_eq;
+    }
+
+    d0 = (((eq & vp) + vp) ^ vp) | eq | vn | tr;
+    uint64_t hp = vn | ~(d0 | vp);
+    uint64_t hn = d0 & vp;
+
+    if (hp & last_row) {
+      ++distance;
+    } else if (hn & last_row) {
+      --distance;
+    }
+
+    // each of the remaining symbols may decrease distance at most by 1
+    if (distance > max_distance_ + (size - i - 1)) {
+      return no_match;
+    }
+
+    hp = (hp << 1) | 1;
+    hn <<= 1;
+    vp = hn | ~(d0 | hp);
+    vn = hp & d0;
+    prev_eq = eq;
+  }
+
+  return distance <= max_distance_ ? distance : no_match;
+}
+
 }
@@ -321,6 +321,72 @@ inline bool edit_distance(
                        rhs.begin(), rhs.size());
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--
+//
+// Implementation of the bit-parallel algorithm of evaluating edit distance
+// by Gene Myers described in
+//   "A fast bit-vector algorithm for approximate string matching based
+//    on dynamic programming"
+// extended for transpositions by Heikki Hyyro as described in
+//   "A bit-vector algorithm for computing Levenshtein and Damerau edit
+//    distances"
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class bit_parallel_edit_distance
+/// @brief evaluates edit distance between a fixed target and arbitrary words
+///        up to a specified max distance without building any automaton,
+///        target is limited to 'MAX_TARGET_SIZE' UTF-8 symbols
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API bit_parallel_edit_distance {
+ public:
+  static constexpr size_t MAX_TARGET_SIZE = 64;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param target UTF-8 encoded string
+  /// @param max_distance max edit distance to evaluate
+  /// @param with_transpositions consider transpositions as an atomic change
+  //////////////////////////////////////////////////////////////////////////////
+  bit_parallel_edit_distance(
+    const bytes_ref& target,
+    byte_type max_distance,
+    bool with_transpositions);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns edit distance between a target and a specified UTF-8 encoded
+  ///          string up to 'max_distance()', 'max_distance() + 1' if the
+  ///          distance is greater or 'rhs' isn't a valid UTF-8 sequence
+  /// @note calling function for an invalid instance is undefined behaviour
+  //////////////////////////////////////////////////////////////////////////////
+  size_t operator()(const bytes_ref& rhs);
+
+  byte_type max_distance() const noexcept { return max_distance_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of UTF-8 symbols in a target
+  //////////////////////////////////////////////////////////////////////////////
+  size_t target_size() const noexcept { return target_size_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns target is a valid UTF-8 sequence fitting 'MAX_TARGET_SIZE'
+  //////////////////////////////////////////////////////////////////////////////
+  explicit operator bool() const noexcept { return valid_; }
+
+ private:
+  uint64_t mask(uint32_t c) const noexcept;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  uint64_t ascii_masks_[128]{}; // positions of ASCII symbols in a target
+  std::vector<std::pair<uint32_t, uint64_t>> masks_; // positions of other symbols, sorted
+  std::vector<uint32_t> buf_; // decoded symbols of a word to compare
+  size_t target_size_{};
+  byte_type max_distance_;
+  bool with_transpositions_;
+  bool valid_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // bit_parallel_edit_distance
+
 }
 
 #endif // IRESEARCH_LEVENSHTEIN_UTILS_H
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_LRU_CACHE_H
+#define IRESEARCH_LRU_CACHE_H
+
+#include <cassert>
+#include <list>
+#include <utility>
+
+#include <absl/container/node_hash_map.h>
+
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class lru_cache
+/// @brief map of values ordered by the time of the last access, accounts
+///        the amount of memory consumed by each value and evicts least
+///        recently used values exceeding a memory limit on demand
+/// @note the container isn't thread-safe, users are supposed to guard it
+//////////////////////////////////////////////////////////////////////////////
+template<
+  typename Key,
+  typename Value,
+  typename Hash = typename absl::node_hash_map<Key, Value>::hasher,
+  typename Equal = typename absl::node_hash_map<Key, Value>::key_equal>
+class lru_cache : private util::noncopyable {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns value cached for a specified key marking it as recently used,
+  ///          nullptr if there is no such value
+  ////////////////////////////////////////////////////////////////////////////
+  Value* get(const Key& key) {
+    const auto it = index_.find(key);
+
+    if (it == index_.end()) {
+      return nullptr;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it->second.pos);
+    return &it->second.value;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns value cached for a specified key without marking it as
+  ///          recently used, nullptr if there is no such value
+  ////////////////////////////////////////////////////////////////////////////
+  const Value* find(const Key& key) const {
+    const auto it = index_.find(key);
+    return it == index_.end() ? nullptr : &it->second.value;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief caches a specified value consuming 'memory' bytes as the most
+  ///        recently used one unless a value is already cached for the key
+  /// @returns cached value and true if a specified value has been cached
+  /// @note doesn't evict anything, @see shrink(...)
+  ////////////////////////////////////////////////////////////////////////////
+  std::pair<Value*, bool> emplace(const Key& key, Value&& value, size_t memory) {
+    const auto [it, inserted] = index_.try_emplace(key, std::move(value), memory);
+
+    if (!inserted) {
+      return { &it->second.value, false };
+    }
+
+    try {
+      entries_.emplace_front(&*it);
+    } catch (...) {
+      index_.erase(it);
+      throw;
+    }
+
+    it->second.pos = entries_.begin();
+    memory_ += memory;
+
+    return { &it->second.value, true };
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief drops the value cached for a specified key
+  /// @returns true if the value has been dropped
+  ////////////////////////////////////////////////////////////////////////////
+  bool erase(const Key& key) {
+    const auto it = index_.find(key);
+
+    if (it == index_.end()) {
+      return false;
+    }
+
+    erase(it);
+    return true;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief evicts the least recently used value calling
+  ///        'visitor(key, value)' right before the eviction
+  /// @returns amount of released memory
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Visitor>
+  size_t pop(Visitor&& visitor) {
+    assert(!entries_.empty());
+    const auto it = index_.find(entries_.back()->first);
+    assert(it != index_.end());
+    visitor(it->first, it->second.value);
+    return erase(it);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief evicts least recently used values until the cache fits
+  ///        'max_memory' keeping at least 'keep' most recently used ones,
+  ///        'visitor(key, value)' is called right before each eviction
+  /// @returns number of evicted values
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Visitor>
+  size_t shrink(size_t max_memory, size_t keep, Visitor&& visitor) {
+    size_t count = 0;
+
+    for (; memory_ > max_memory && entries_.size() > keep; ++count) {
+      pop(visitor);
+    }
+
+    return count;
+  }
+
+  size_t shrink(size_t max_memory, size_t keep = 0) {
+    return shrink(max_memory, keep, [](const Key&, const Value&) noexcept { });
+  }
+
+  void clear() noexcept {
+    entries_.clear();
+    index_.clear();
+    memory_ = 0;
+  }
+
+  bool empty() const noexcept { return index_.empty(); }
+
+  // number of cached values
+  size_t size() const noexcept { return index_.size(); }
+
+  // amount of memory consumed by cached values
+  size_t memory() const noexcept { return memory_; }
+
+ private:
+  struct node {
+    node(Value&& value, size_t memory)
+      : value(std::move(value)), memory(memory) {
+    }
+
+    Value value;
+    size_t memory;
+    // position in 'entries_'
+    typename std::list<const std::pair<const Key, node>*>::iterator pos;
+  };
+
+  using index_t = absl::node_hash_map<Key, node, Hash, Equal>;
+  using entries_t = std::list<const typename index_t::value_type*>;
+
+  size_t erase(typename index_t::iterator it) {
+    const size_t memory = it->second.memory;
+    entries_.erase(it->second.pos);
+    index_.erase(it);
+    memory_ -= memory;
+    return memory;
+  }
+
+  index_t index_; // nodes are stable, referred by 'entries_'
+  entries_t entries_; // most recently used entries first
+  size_t memory_{};
+}; // lru_cache
+
+}
+
+#endif // IRESEARCH_LRU_CACHE_H
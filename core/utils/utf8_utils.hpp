@@ -23,12 +23,17 @@
 #ifndef IRESEARCH_UTF8_UTILS_H
 #define IRESEARCH_UTF8_UTILS_H
 
+#include <cstring>
 #include <vector>
 
 #include "shared.hpp"
 #include "log.hpp"
 #include "string.hpp"
 
+#ifdef IRESEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace iresearch {
 namespace utf8_utils {
 
@@ -220,6 +225,54 @@ FORCE_INLINE size_t utf8_length(const bytes_ref& in) noexcept {
   return utf8_length(in.c_str(), in.size());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @returns true if a specified sequence consists of ASCII characters only,
+///          i.e. has no byte with the most significant bit set
+////////////////////////////////////////////////////////////////////////////////
+inline bool is_ascii(const byte_type* begin, size_t size) noexcept {
+  const auto* end = begin + size;
+
+#ifdef IRESEARCH_SSE2
+  for (; end - begin >= 64; begin += 64) {
+    const auto* chunk = reinterpret_cast<const __m128i*>(begin);
+    const __m128i bits = _mm_or_si128(
+      _mm_or_si128(_mm_loadu_si128(chunk), _mm_loadu_si128(chunk + 1)),
+      _mm_or_si128(_mm_loadu_si128(chunk + 2), _mm_loadu_si128(chunk + 3)));
+
+    if (_mm_movemask_epi8(bits)) {
+      return false;
+    }
+  }
+
+  for (; end - begin >= 16; begin += 16) {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin)))) {
+      return false;
+    }
+  }
+#else
+  for (; end - begin >= 8; begin += 8) {
+    uint64_t word;
+    std::memcpy(&word, begin, sizeof word);
+
+    if (word & UINT64_C(0x8080808080808080)) {
+      return false;
+    }
+  }
+#endif
+
+  for (; begin != end; ++begin) {
+    if (*begin & 0x80) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+FORCE_INLINE bool is_ascii(const bytes_ref& in) noexcept {
+  return is_ascii(in.c_str(), in.size());
+}
+
 } // utf8_utils
 } // ROOT
 
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "zstdcompression.hpp"
+
+#ifdef USE_ZSTD
+
+#include "error/error.hpp"
+#include "store/store_utils.hpp"
+#include "utils/log.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/misc.hpp"
+
+#include <zstd.h>
+#include <zdict.h>
+
+namespace {
+
+inline int level(const irs::compression::options::Hint hint) noexcept {
+  static const int LEVELS[] { 0, 1, 9 };
+  assert(static_cast<size_t>(hint) < IRESEARCH_COUNTOF(LEVELS));
+
+  return LEVELS[static_cast<size_t>(hint)];
+}
+
+}
+
+namespace iresearch {
+
+static_assert(
+  sizeof(char) == sizeof(byte_type),
+  "sizeof(char) != sizeof(byte_type)"
+);
+
+namespace compression {
+
+void ZSTD_CCtx_deleter::operator()(void* p) noexcept {
+  ZSTD_freeCCtx(reinterpret_cast<ZSTD_CCtx*>(p));
+}
+
+void ZSTD_CDict_deleter::operator()(void* p) noexcept {
+  ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(p));
+}
+
+void ZSTD_DDict_deleter::operator()(void* p) noexcept {
+  ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(p));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  zstd compression
+// -----------------------------------------------------------------------------
+
+zstd::zstd_compressor::zstd_compressor(
+    int level /*= 0*/,
+    bool dictionary /*= true*/)
+  : ctx_(ZSTD_createCCtx()),
+    level_(level),
+    train_(dictionary) {
+  if (!ctx_) {
+    throw std::bad_alloc();
+  }
+}
+
+void zstd::zstd_compressor::sample(const byte_type* src, size_t size) {
+  samples_.append(src, size);
+
+  for (; size > SAMPLE_SIZE; size -= SAMPLE_SIZE) {
+    sample_sizes_.emplace_back(SAMPLE_SIZE);
+  }
+  sample_sizes_.emplace_back(size);
+
+  if (samples_.size() >= TRAINING_SIZE) {
+    train();
+  }
+}
+
+void zstd::zstd_compressor::train() {
+  assert(train_ && !cdict_);
+
+  train_ = false; // single attempt
+
+  bstring dict(DICTIONARY_CAPACITY, 0);
+  const size_t dict_size = ZDICT_trainFromBuffer(
+    &dict[0], dict.size(),
+    samples_.c_str(), sample_sizes_.data(), unsigned(sample_sizes_.size()));
+
+  // samples aren't needed anymore
+  bstring().swap(samples_);
+  std::vector<size_t>().swap(sample_sizes_);
+
+  if (ZDICT_isError(dict_size)) {
+    // not an error, e.g. data is too random to benefit from a dictionary
+    IR_FRMT_DEBUG(
+      "Failed to train zstd dictionary, reason: %s",
+      ZDICT_getErrorName(dict_size));
+    return;
+  }
+
+  dict.resize(dict_size);
+
+  cdict_.reset(ZSTD_createCDict(dict.c_str(), dict.size(), level_));
+
+  if (!cdict_) {
+    throw std::bad_alloc();
+  }
+
+  dict_ = std::move(dict);
+}
+
+bytes_ref zstd::zstd_compressor::compress(byte_type* src, size_t size, bstring& out) {
+  if (train_) {
+    sample(src, size);
+  }
+
+  // ensure we have enough space to store compressed data
+  string_utils::oversize(out, ZSTD_compressBound(size));
+
+  auto* ctx = reinterpret_cast<ZSTD_CCtx*>(ctx_.get());
+  auto* buf = &out[0];
+
+  const size_t zstd_size = cdict_
+    ? ZSTD_compress_usingCDict(ctx, buf, out.size(), src, size,
+                               reinterpret_cast<const ZSTD_CDict*>(cdict_.get()))
+    : ZSTD_compressCCtx(ctx, buf, out.size(), src, size, level_);
+
+  if (IRS_UNLIKELY(ZSTD_isError(zstd_size))) {
+    throw index_error(string_utils::to_string(
+      "while compressing, error: %s",
+      ZSTD_getErrorName(zstd_size)));
+  }
+
+  return bytes_ref(buf, zstd_size);
+}
+
+void zstd::zstd_compressor::flush(data_output& out) {
+  if (dict_.empty()) {
+    // nothing to store, blocks are self-contained
+    return;
+  }
+
+  write_string(out, dict_);
+}
+
+bytes_ref zstd::zstd_decompressor::decompress(
+    const byte_type* src, size_t src_size,
+    byte_type* dst, size_t dst_size) {
+  // decompressor is shared between all readers of a column
+  thread_local std::unique_ptr<ZSTD_DCtx, size_t(*)(ZSTD_DCtx*)> CTX(
+    ZSTD_createDCtx(), &ZSTD_freeDCtx);
+
+  if (!CTX) {
+    throw std::bad_alloc();
+  }
+
+  const auto dict_id = ZSTD_getDictID_fromFrame(src, src_size);
+
+  if (IRS_UNLIKELY(dict_id && dict_id != dict_id_)) {
+    return bytes_ref::NIL; // corrupted index
+  }
+
+  const size_t zstd_size = dict_id
+    ? ZSTD_decompress_usingDDict(CTX.get(), dst, dst_size, src, src_size,
+                                 reinterpret_cast<const ZSTD_DDict*>(ddict_.get()))
+    : ZSTD_decompressDCtx(CTX.get(), dst, dst_size, src, src_size);
+
+  if (IRS_UNLIKELY(ZSTD_isError(zstd_size))) {
+    return bytes_ref::NIL; // corrupted index
+  }
+
+  return bytes_ref(dst, zstd_size);
+}
+
+bool zstd::zstd_decompressor::prepare(data_input& in) {
+  const auto dict = read_string<bstring>(in);
+
+  if (dict.empty()) {
+    return true;
+  }
+
+  ddict_.reset(ZSTD_createDDict(dict.c_str(), dict.size()));
+
+  if (!ddict_) {
+    return false;
+  }
+
+  dict_id_ = ZSTD_getDictID_fromDDict(
+    reinterpret_cast<const ZSTD_DDict*>(ddict_.get()));
+
+  return 0 != dict_id_;
+}
+
+compressor::ptr zstd::compressor(const options& opts) {
+  return memory::make_shared<zstd_compressor>(::level(opts.hint), opts.dictionary);
+}
+
+decompressor::ptr zstd::decompressor() {
+  return memory::make_shared<zstd_decompressor>();
+}
+
+void zstd::init() {
+  // match registration below
+  REGISTER_COMPRESSION(zstd, &zstd::compressor, &zstd::decompressor);
+}
+
+REGISTER_COMPRESSION(zstd, &zstd::compressor, &zstd::decompressor);
+
+} // compression
+}
+
+#endif // USE_ZSTD
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_ZSTDCOMPRESSION_H
+#define IRESEARCH_ZSTDCOMPRESSION_H
+
+#include "string.hpp"
+#include "compression.hpp"
+#include "noncopyable.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace iresearch {
+namespace compression {
+
+struct ZSTD_CCtx_deleter {
+  void operator()(void* p) noexcept;
+};
+
+struct ZSTD_CDict_deleter {
+  void operator()(void* p) noexcept;
+};
+
+struct ZSTD_DDict_deleter {
+  void operator()(void* p) noexcept;
+};
+
+typedef std::unique_ptr<void, ZSTD_CCtx_deleter> zstd_cctx;
+typedef std::unique_ptr<void, ZSTD_CDict_deleter> zstd_cdict;
+typedef std::unique_ptr<void, ZSTD_DDict_deleter> zstd_ddict;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Zstandard compression, available if built with zstd (USE_ZSTD)
+///
+/// Unless disabled via 'options::dictionary', a compressor samples the first
+/// blocks it gets and, once enough data is collected, trains a dictionary
+/// used for compressing the rest of the blocks. The dictionary is stored
+/// in the column metadata via 'flush(...)' and loaded by 'prepare(...)' of
+/// a decompressor. Blocks compressed before training are self-contained.
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API zstd {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::compression::zstd";
+  }
+
+  // max size of a trained dictionary
+  static constexpr size_t DICTIONARY_CAPACITY = 16384;
+
+  // amount of data to sample before training a dictionary
+  static constexpr size_t TRAINING_SIZE = 32*DICTIONARY_CAPACITY;
+
+  // size of a single sample passed to the trainer
+  static constexpr size_t SAMPLE_SIZE = 1024;
+
+  class IRESEARCH_API zstd_compressor final : public compression::compressor {
+   public:
+    explicit zstd_compressor(int level = 0, bool dictionary = true);
+
+    int level() const noexcept { return level_; }
+
+    // trained dictionary, empty if none
+    const bstring& dictionary() const noexcept { return dict_; }
+
+    virtual bytes_ref compress(
+      byte_type* src,
+      size_t size,
+      bstring& out) override IRESEARCH_ATTRIBUTE_NONNULL();
+
+    // writes trained dictionary, nothing if there is none
+    virtual void flush(data_output& out) override;
+
+   private:
+    void sample(const byte_type* src, size_t size);
+    void train();
+
+    zstd_cctx ctx_;
+    zstd_cdict cdict_;
+    bstring dict_; // trained dictionary
+    bstring samples_; // data collected for training
+    std::vector<size_t> sample_sizes_;
+    const int level_; // 0 - default level
+    bool train_; // whether dictionary is still to be trained
+  };
+
+  class IRESEARCH_API zstd_decompressor final : public compression::decompressor {
+   public:
+    virtual bytes_ref decompress(
+      const byte_type* src, size_t src_size,
+      byte_type* dst, size_t dst_size) override IRESEARCH_ATTRIBUTE_NONNULL();
+
+    // reads trained dictionary, called only if something has been flushed
+    virtual bool prepare(data_input& in) override;
+
+   private:
+    zstd_ddict ddict_;
+    unsigned dict_id_{}; // 0 - no dictionary
+  };
+
+  static void init();
+  static compression::compressor::ptr compressor(const options& opts);
+  static compression::decompressor::ptr decompressor();
+}; // zstd
+
+} // compression
+} // namespace iresearch {
+
+#endif
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "utils/bit_packing.hpp"
+
+namespace {
+
+constexpr size_t NUM_BLOCKS = 64; // fits into L1 for every number of bits
+
+std::vector<uint32_t> random_values(uint32_t bits) {
+  std::mt19937 engine(42);
+  const uint32_t mask = bits < 32 ? (1U << bits) - 1 : ~0U;
+
+  std::vector<uint32_t> values(NUM_BLOCKS*irs::packed::BLOCK_SIZE_32);
+  for (auto& value : values) {
+    value = uint32_t(engine()) & mask;
+  }
+  return values;
+}
+
+std::vector<uint32_t> packed_values(const std::vector<uint32_t>& values, uint32_t bits) {
+  std::vector<uint32_t> packed(NUM_BLOCKS*bits);
+  irs::packed::pack(values.data(), values.data() + values.size(), packed.data(), bits);
+  return packed;
+}
+
+void BM_pack_block32(benchmark::State& state) {
+  const auto bits = uint32_t(state.range(0));
+  const auto values = random_values(bits);
+  std::vector<uint32_t> packed(NUM_BLOCKS*bits);
+
+  for (auto _ : state) {
+    const auto* in = values.data();
+    auto* out = packed.data();
+    for (size_t i = 0; i < NUM_BLOCKS; ++i, in += irs::packed::BLOCK_SIZE_32, out += bits) {
+      irs::packed::pack_block(in, out, bits);
+    }
+    benchmark::DoNotOptimize(packed.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations())*int64_t(values.size()));
+}
+
+void BM_unpack_block32(benchmark::State& state) {
+  const auto bits = uint32_t(state.range(0));
+  const auto values = random_values(bits);
+  const auto packed = packed_values(values, bits);
+  std::vector<uint32_t> unpacked(values.size());
+
+  for (auto _ : state) {
+    const auto* in = packed.data();
+    auto* out = unpacked.data();
+    for (size_t i = 0; i < NUM_BLOCKS; ++i, in += bits, out += irs::packed::BLOCK_SIZE_32) {
+      irs::packed::unpack_block(in, out, bits);
+    }
+    benchmark::DoNotOptimize(unpacked.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations())*int64_t(values.size()));
+}
+
+void BM_unpack32(benchmark::State& state) {
+  const auto bits = uint32_t(state.range(0));
+  const auto values = random_values(bits);
+  const auto packed = packed_values(values, bits);
+  std::vector<uint32_t> unpacked(values.size());
+
+  for (auto _ : state) {
+    irs::packed::unpack(unpacked.data(), unpacked.data() + unpacked.size(),
+                        packed.data(), bits);
+    benchmark::DoNotOptimize(unpacked.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations())*int64_t(values.size()));
+}
+
+}
+
+BENCHMARK(BM_pack_block32)->DenseRange(1, 32);
+BENCHMARK(BM_unpack_block32)->DenseRange(1, 32);
+BENCHMARK(BM_unpack32)->DenseRange(1, 32);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/ngram_token_stream.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+using utf8_ngram_token_stream = ngram_token_stream<ngram_token_stream_base::InputType::UTF8>;
+
+utf8_ngram_token_stream::Options options() {
+  // typical setup for 'by_ngram_similarity'
+  return utf8_ngram_token_stream::Options(
+    2, 4, false, ngram_token_stream_base::InputType::UTF8,
+    irs::bytes_ref::EMPTY, irs::bytes_ref::EMPTY);
+}
+
+void tokenize(benchmark::State& state, const irs::string_ref& str) {
+  utf8_ngram_token_stream stream(options());
+  irs::analysis::analyzer& analyzer = stream;
+
+  for (auto _ : state) {
+    analyzer.reset(str);
+    while (const bool has_next = analyzer.next()) {
+      benchmark::DoNotOptimize(has_next);
+    }
+  }
+}
+
+void tokenize_batch(benchmark::State& state, const irs::string_ref& str) {
+  utf8_ngram_token_stream stream(options());
+  irs::analysis::analyzer& analyzer = stream;
+  irs::token tokens[64];
+
+  for (auto _ : state) {
+    analyzer.reset(str);
+    while (const size_t count = analyzer.next_batch(tokens, std::size(tokens))) {
+      benchmark::DoNotOptimize(count);
+    }
+  }
+}
+
+constexpr irs::string_ref ASCII = "Quick brown fox jumps over the lazy dog";
+constexpr irs::string_ref UNICODE = "Быстрая коричневая лиса прыгает через ленивую собаку";
+
+void BM_ngram_analyzer_ascii(benchmark::State& state) {
+  tokenize(state, ASCII);
+}
+
+void BM_ngram_analyzer_ascii_batch(benchmark::State& state) {
+  tokenize_batch(state, ASCII);
+}
+
+void BM_ngram_analyzer_unicode(benchmark::State& state) {
+  tokenize(state, UNICODE);
+}
+
+void BM_ngram_analyzer_unicode_batch(benchmark::State& state) {
+  tokenize_batch(state, UNICODE);
+}
+
+}
+
+BENCHMARK(BM_ngram_analyzer_ascii);
+BENCHMARK(BM_ngram_analyzer_ascii_batch);
+BENCHMARK(BM_ngram_analyzer_unicode);
+BENCHMARK(BM_ngram_analyzer_unicode_batch);
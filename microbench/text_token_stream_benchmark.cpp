@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/text_token_stream.hpp"
+#include "utils/locale_utils.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+void tokenize(benchmark::State& state, const irs::string_ref& str) {
+  text_token_stream::options_t opts;
+  opts.locale = irs::locale_utils::locale("en_US.UTF-8");
+  opts.explicit_stopwords = { "the", "over" };
+  opts.explicit_stopwords_set = true;
+
+  text_token_stream stream(opts, opts.explicit_stopwords);
+
+  for (auto _ : state) {
+    stream.reset(str);
+    while (const bool has_next = stream.next()) {
+      benchmark::DoNotOptimize(has_next);
+    }
+  }
+}
+
+void BM_text_analyzer_ascii(benchmark::State& state) {
+  tokenize(state, "QUICK BROWN FOX JUMPS OVER THE LAZY DOG");
+}
+
+// non-ASCII input is tokenized via ICU
+void BM_text_analyzer_unicode(benchmark::State& state) {
+  tokenize(state, "QUICK BROWN FOX JUMPS OVER THE LAZY D\xC3\x96G");
+}
+
+}
+
+BENCHMARK(BM_text_analyzer_ascii);
+BENCHMARK(BM_text_analyzer_unicode);
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <thread>
+
+#include "analysis/analyzer_pool.hpp"
+#include "analysis/analyzers.hpp"
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/pipeline_token_stream.hpp"
+#include "analysis/token_attributes.hpp"
+
+namespace {
+
+std::vector<std::string> tokenize(irs::analysis::analyzer& stream, const irs::string_ref& data) {
+  std::vector<std::string> tokens;
+  EXPECT_TRUE(stream.reset(data));
+
+  auto* term = irs::get<irs::term_attribute>(stream);
+  EXPECT_NE(nullptr, term);
+
+  while (stream.next()) {
+    tokens.emplace_back(irs::ref_cast<char>(term->value));
+  }
+
+  return tokens;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief splits data by ',' and counts created instances
+////////////////////////////////////////////////////////////////////////////////
+class counting_analyzer final : public irs::analysis::analyzer {
+ public:
+  static size_t instances;
+
+  static constexpr irs::string_ref type_name() noexcept {
+    return "analyzer_pool_test_counting";
+  }
+
+  static ptr make(const irs::string_ref&) {
+    ++instances;
+    return std::make_shared<counting_analyzer>();
+  }
+
+  static bool normalize(const irs::string_ref& args, std::string& out) {
+    out.assign(args.c_str(), args.size());
+    return true;
+  }
+
+  counting_analyzer()
+    : irs::analysis::analyzer(irs::type<counting_analyzer>::get()),
+      impl_(",") {
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id id) noexcept override {
+    return impl_.get_mutable(id);
+  }
+
+  virtual bool next() override { return impl_.next(); }
+
+  virtual bool reset(const irs::string_ref& data) override {
+    return impl_.reset(data);
+  }
+
+ private:
+  irs::analysis::delimited_token_stream impl_;
+};
+
+size_t counting_analyzer::instances = 0;
+
+REGISTER_ANALYZER_JSON(counting_analyzer, counting_analyzer::make, counting_analyzer::normalize);
+
+}
+
+TEST(analyzer_pool_test, reuse) {
+  irs::analysis::analyzer_pool pool;
+  ASSERT_EQ(0, pool.size());
+
+  irs::analysis::analyzer* instance = nullptr;
+
+  {
+    auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+    ASSERT_TRUE(stream);
+    ASSERT_EQ(irs::type<irs::analysis::delimited_token_stream>::id(), stream->type());
+    ASSERT_EQ((std::vector<std::string>{ "a", "b" }), tokenize(*stream, "a,b"));
+    instance = stream.get();
+    ASSERT_EQ(1, pool.size());
+  }
+
+  // idle instance is reused
+  {
+    auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+    ASSERT_TRUE(stream);
+    ASSERT_EQ(instance, stream.get());
+
+    // in-use instance is never shared
+    auto other = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+    ASSERT_TRUE(other);
+    ASSERT_NE(instance, other.get());
+    ASSERT_EQ((std::vector<std::string>{ "a", "b" }), tokenize(*other, "a,b"));
+  }
+
+  // equivalent arguments share instances
+  {
+    auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{ \"delimiter\" : \",\" }");
+    ASSERT_TRUE(stream);
+    ASSERT_TRUE(stream.get() == instance || 1 == pool.size());
+    ASSERT_EQ(1, pool.size());
+  }
+
+  // different arguments
+  {
+    auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\";\"}");
+    ASSERT_TRUE(stream);
+    ASSERT_NE(instance, stream.get());
+    ASSERT_EQ((std::vector<std::string>{ "a,b", "c" }), tokenize(*stream, "a,b;c"));
+    ASSERT_EQ(2, pool.size());
+  }
+
+  // definitions and idle instances are dropped
+  pool.clear();
+  ASSERT_EQ(0, pool.size());
+  {
+    auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+    ASSERT_TRUE(stream);
+    ASSERT_EQ((std::vector<std::string>{ "a", "b" }), tokenize(*stream, "a,b"));
+  }
+  ASSERT_EQ(1, pool.size());
+}
+
+TEST(analyzer_pool_test, max_definitions) {
+  irs::analysis::analyzer_pool pool(irs::analysis::analyzer_pool::DEFAULT_POOL_SIZE, 2);
+  const size_t initial = counting_analyzer::instances;
+
+  auto get = [&pool](const irs::string_ref& args) {
+    return pool.get("analyzer_pool_test_counting", irs::type<irs::text_format::json>::get(), args);
+  };
+
+  get("a");
+  get("b");
+  ASSERT_EQ(2, pool.size());
+  ASSERT_EQ(initial + 2, counting_analyzer::instances);
+
+  get("a"); // 'b' is least recently used now
+  ASSERT_EQ(initial + 2, counting_analyzer::instances);
+
+  // evicts 'b', an acquired instance outlives its definition
+  auto stream = get("c");
+  ASSERT_TRUE(stream);
+  ASSERT_EQ(2, pool.size());
+  ASSERT_EQ(initial + 3, counting_analyzer::instances);
+
+  get("a");
+  ASSERT_EQ(initial + 3, counting_analyzer::instances);
+  get("b");
+  ASSERT_EQ(initial + 4, counting_analyzer::instances);
+  ASSERT_EQ(2, pool.size());
+
+  pool.clear();
+  ASSERT_EQ(0, pool.size());
+  ASSERT_EQ((std::vector<std::string>{ "a", "b" }), tokenize(*stream, "a,b"));
+}
+
+TEST(analyzer_pool_test, invalid) {
+  irs::analysis::analyzer_pool pool;
+
+  ASSERT_FALSE(pool.get("delimiter", irs::type<irs::text_format::json>::get(), "1"));
+  ASSERT_FALSE(pool.get("delimiter", irs::type<irs::text_format::json>::get(), irs::string_ref::NIL));
+  ASSERT_FALSE(pool.get("no_such_analyzer", irs::type<irs::text_format::json>::get(), "{}", false));
+  ASSERT_EQ(0, pool.size());
+}
+
+TEST(analyzer_pool_test, release) {
+  irs::analysis::analyzer_pool pool;
+  irs::analysis::analyzer* instance = nullptr;
+
+  {
+    irs::analysis::analyzer::ptr stream = pool.get(
+      "delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}").release();
+    ASSERT_NE(nullptr, stream);
+    instance = stream.get();
+  }
+
+  // instance is returned back into the pool once the last reference is gone
+  auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+  ASSERT_EQ(instance, stream.get());
+}
+
+TEST(analyzer_pool_test, pipeline) {
+  const irs::string_ref args =
+    "{\"pipeline\":["
+      "{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}},"
+      "{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\";\"}}"
+    "]}";
+
+  irs::analysis::analyzer_pool pool;
+
+  {
+    auto stream = pool.get("pipeline", irs::type<irs::text_format::json>::get(), args);
+    ASSERT_TRUE(stream);
+    ASSERT_EQ(irs::type<irs::analysis::pipeline_token_stream>::id(), stream->type());
+    ASSERT_EQ((std::vector<std::string>{ "a", "b", "c" }), tokenize(*stream, "a;b,c"));
+  }
+
+  // members of a destroyed pipeline are reused
+  {
+    const irs::string_ref counting_args =
+      "{\"pipeline\":["
+        "{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\";\"}},"
+        "{\"type\":\"analyzer_pool_test_counting\",\"properties\":{}}"
+      "]}";
+    const size_t initial = counting_analyzer::instances;
+
+    for (size_t i = 0; i < 3; ++i) {
+      auto stream = irs::analysis::analyzers::get("pipeline", irs::type<irs::text_format::json>::get(), counting_args);
+      ASSERT_NE(nullptr, stream);
+      ASSERT_EQ((std::vector<std::string>{ "a", "b", "c" }), tokenize(*stream, "a;b,c"));
+    }
+
+    ASSERT_LE(counting_analyzer::instances, initial + 1);
+  }
+}
+
+TEST(analyzer_pool_test, concurrent) {
+  constexpr size_t THREADS = 8;
+  constexpr size_t ITERATIONS = 1000;
+
+  irs::analysis::analyzer_pool pool(THREADS);
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{ false };
+
+  for (size_t i = 0; i < THREADS; ++i) {
+    threads.emplace_back([&pool, &failed]() {
+      for (size_t j = 0; j < ITERATIONS; ++j) {
+        auto stream = pool.get("delimiter", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\",\"}");
+
+        if (!stream || std::vector<std::string>{ "a", "b" } != tokenize(*stream, "a,b")) {
+          failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(failed);
+  ASSERT_EQ(1, pool.size());
+}
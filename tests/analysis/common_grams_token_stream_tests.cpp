@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "tests_config.hpp"
+
+#include "analysis/common_grams_token_stream.hpp"
+#include "analysis/token_attributes.hpp"
+
+#ifndef IRESEARCH_DLL
+
+namespace {
+
+struct analyzer_token {
+  irs::string_ref value;
+  uint32_t start;
+  uint32_t end;
+  uint32_t pos;
+};
+
+using analyzer_tokens = std::vector<analyzer_token>;
+
+void assert_tokens(
+    irs::analysis::analyzer& stream,
+    const irs::string_ref& data,
+    const analyzer_tokens& expected_tokens) {
+  SCOPED_TRACE(data);
+  auto* offset = irs::get<irs::offset>(stream);
+  ASSERT_TRUE(offset);
+  auto* term = irs::get<irs::term_attribute>(stream);
+  ASSERT_TRUE(term);
+  auto* inc = irs::get<irs::increment>(stream);
+  ASSERT_TRUE(inc);
+  ASSERT_TRUE(stream.reset(data));
+  uint32_t pos{ std::numeric_limits<uint32_t>::max() };
+  auto expected_token = expected_tokens.begin();
+  while (stream.next()) {
+    pos += inc->value;
+    ASSERT_NE(expected_token, expected_tokens.end());
+    ASSERT_EQ(irs::ref_cast<irs::byte_type>(expected_token->value), term->value);
+    ASSERT_EQ(expected_token->start, offset->start);
+    ASSERT_EQ(expected_token->end, offset->end);
+    ASSERT_EQ(expected_token->pos, pos);
+    ++expected_token;
+  }
+  ASSERT_EQ(expected_token, expected_tokens.end());
+}
+
+}
+
+TEST(common_grams_token_stream_test, consts) {
+  static_assert("common_grams" == irs::type<irs::analysis::common_grams_token_stream>::name());
+}
+
+TEST(common_grams_token_stream_test, no_base) {
+  irs::analysis::common_grams_token_stream stream({});
+  ASSERT_FALSE(stream.reset("quick brown fox"));
+  ASSERT_FALSE(stream.next());
+}
+
+TEST(common_grams_token_stream_test, bigrams) {
+  irs::analysis::common_grams_token_stream::options_t options;
+  options.base = irs::analysis::analyzers::get(
+    "delimiter", irs::type<irs::text_format::json>::get(),
+    "{\"delimiter\":\" \"}");
+  ASSERT_NE(nullptr, options.base);
+  options.words.emplace("the");
+  options.words.emplace("of");
+
+  irs::analysis::common_grams_token_stream stream(std::move(options));
+  ASSERT_EQ(irs::type<irs::analysis::common_grams_token_stream>::id(), stream.type());
+
+  {
+    const analyzer_tokens expected{
+      { "the", 0, 3, 0 },
+      { "the state", 0, 9, 0 },
+      { "state", 4, 9, 1 },
+      { "state of", 4, 12, 1 },
+      { "of", 10, 12, 2 },
+      { "of the", 10, 16, 2 },
+      { "the", 13, 16, 3 },
+      { "the art", 13, 20, 3 },
+      { "art", 17, 20, 4 },
+    };
+    assert_tokens(stream, "the state of the art", expected);
+  }
+
+  // no common words
+  {
+    const analyzer_tokens expected{
+      { "quick", 0, 5, 0 },
+      { "brown", 6, 11, 1 },
+      { "fox", 12, 15, 2 },
+    };
+    assert_tokens(stream, "quick brown fox", expected);
+  }
+
+  // single common word
+  {
+    const analyzer_tokens expected{
+      { "the", 0, 3, 0 },
+    };
+    assert_tokens(stream, "the", expected);
+  }
+
+  // common word at the end
+  {
+    const analyzer_tokens expected{
+      { "part", 0, 4, 0 },
+      { "part of", 0, 7, 0 },
+      { "of", 5, 7, 1 },
+    };
+    assert_tokens(stream, "part of", expected);
+  }
+}
+
+TEST(common_grams_token_stream_test, custom_separator) {
+  irs::analysis::common_grams_token_stream::options_t options;
+  options.base = irs::analysis::analyzers::get(
+    "delimiter", irs::type<irs::text_format::json>::get(),
+    "{\"delimiter\":\",\"}");
+  ASSERT_NE(nullptr, options.base);
+  options.words.emplace("a");
+  options.separator = "_";
+
+  irs::analysis::common_grams_token_stream stream(std::move(options));
+
+  const analyzer_tokens expected{
+    { "a", 0, 1, 0 },
+    { "a_b", 0, 3, 0 },
+    { "b", 2, 3, 1 },
+    { "c", 4, 5, 2 },
+  };
+  assert_tokens(stream, "a,b,c", expected);
+}
+
+TEST(common_grams_token_stream_test, make_gram) {
+  irs::bstring gram;
+  irs::analysis::common_grams_token_stream::make_gram(
+    gram, irs::ref_cast<irs::byte_type>(irs::string_ref("state")),
+    irs::ref_cast<irs::byte_type>(irs::string_ref("of")), " ");
+  ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref("state of")), gram);
+}
+
+TEST(common_grams_token_stream_test, construct) {
+  auto stream = irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}},"
+    "\"words\":[\"the\",\"of\"]}");
+  ASSERT_NE(nullptr, stream);
+
+  const analyzer_tokens expected{
+    { "state", 0, 5, 0 },
+    { "state of", 0, 8, 0 },
+    { "of", 6, 8, 1 },
+    { "of mind", 6, 13, 1 },
+    { "mind", 9, 13, 2 },
+  };
+  assert_tokens(*stream, "state of mind", expected);
+}
+
+TEST(common_grams_token_stream_test, construct_invalid) {
+  // invalid json
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(), "INVALID_JSON}"));
+
+  // not an object
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(), "[1,2,3]"));
+
+  // no analyzer
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"words\":[\"the\"]}"));
+
+  // no analyzer type
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"properties\":{\"delimiter\":\" \"}},\"words\":[\"the\"]}"));
+
+  // unknown analyzer
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"UNKNOWN\",\"properties\":{}},\"words\":[\"the\"]}"));
+
+  // no words
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}}}"));
+
+  // non-string word
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}},"
+    "\"words\":[\"the\", 1]}"));
+
+  // non-string separator
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "common_grams", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}},"
+    "\"words\":[\"the\"],\"separator\":1}"));
+}
+
+TEST(common_grams_token_stream_test, normalize_json) {
+  {
+    std::string actual;
+    ASSERT_TRUE(irs::analysis::analyzers::normalize(
+      actual, "common_grams", irs::type<irs::text_format::json>::get(),
+      "{\"unknown\":1,\"words\":[\"the\",\"of\",\"the\"],"
+      "\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"unknown\":1,\"delimiter\":\" \"}}}"));
+    ASSERT_EQ(
+      "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}},"
+      "\"separator\":\" \",\"words\":[\"of\",\"the\"]}",
+      actual);
+  }
+
+  {
+    std::string actual;
+    ASSERT_TRUE(irs::analysis::analyzers::normalize(
+      actual, "common_grams", irs::type<irs::text_format::json>::get(),
+      "{\"words\":[],\"separator\":\"_\","
+      "\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}}}"));
+    ASSERT_EQ(
+      "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}},"
+      "\"separator\":\"_\",\"words\":[]}",
+      actual);
+  }
+
+  // invalid wrapped analyzer properties
+  {
+    std::string actual;
+    ASSERT_FALSE(irs::analysis::analyzers::normalize(
+      actual, "common_grams", irs::type<irs::text_format::json>::get(),
+      "{\"words\":[],\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"wrong\":\",\"}}}"));
+  }
+}
+
+#endif // IRESEARCH_DLL
@@ -474,6 +474,73 @@ TEST_F(delimited_token_stream_tests, test_load) {
   }
 }
 
+TEST_F(delimited_token_stream_tests, test_batch) {
+  auto assert_batch = [](const irs::string_ref& delimiter, const irs::string_ref& data, size_t batch_size) {
+    SCOPED_TRACE(testing::Message("Delimiter:<") << delimiter << "> Data:<" << data << "> Batch:" << batch_size);
+
+    struct token_value {
+      std::string term;
+      std::string payload;
+      uint32_t increment;
+      uint32_t start;
+      uint32_t end;
+    };
+
+    std::vector<token_value> expected;
+
+    {
+      irs::analysis::delimited_token_stream stream(delimiter);
+      auto* inc = irs::get<irs::increment>(stream);
+      auto* offset = irs::get<irs::offset>(stream);
+      auto* payload = irs::get<irs::payload>(stream);
+      auto* term = irs::get<irs::term_attribute>(stream);
+      ASSERT_TRUE(stream.reset(data));
+
+      while (stream.next()) {
+        expected.push_back({
+          static_cast<std::string>(irs::ref_cast<char>(term->value)),
+          static_cast<std::string>(irs::ref_cast<char>(payload->value)),
+          inc->value, offset->start, offset->end });
+      }
+    }
+
+    irs::analysis::delimited_token_stream stream(delimiter);
+    ASSERT_TRUE(stream.batched());
+    auto* offset = irs::get<irs::offset>(stream);
+    ASSERT_TRUE(stream.reset(data));
+
+    std::vector<irs::token> tokens(batch_size);
+    auto expected_token = expected.begin();
+
+    for (size_t count; (count = stream.next_batch(tokens.data(), tokens.size())); ) {
+      ASSERT_LE(count, batch_size);
+
+      for (size_t i = 0; i < count; ++i, ++expected_token) {
+        ASSERT_NE(expected.end(), expected_token);
+        ASSERT_EQ(expected_token->term, irs::ref_cast<char>(tokens[i].term));
+        ASSERT_EQ(expected_token->payload, irs::ref_cast<char>(tokens[i].payload));
+        ASSERT_EQ(expected_token->increment, tokens[i].increment);
+        ASSERT_EQ(expected_token->start, tokens[i].start);
+        ASSERT_EQ(expected_token->end, tokens[i].end);
+      }
+
+      ASSERT_EQ(tokens[count - 1].end, offset->end);
+    }
+
+    ASSERT_EQ(expected.end(), expected_token);
+    ASSERT_EQ(0, stream.next_batch(tokens.data(), tokens.size()));
+  };
+
+  for (size_t batch_size : { 1, 2, 3, 64 }) {
+    assert_batch(irs::string_ref::NIL, "abc,def\"\",\"\"ghi", batch_size);
+    assert_batch(",", "abc,def,ghi", batch_size);
+    assert_batch(",", "\"abc\",\"d\"\"ef\",ghi,,\"\"\"x\"\"\",\"mismatched", batch_size);
+    assert_batch("", "abc,\"def\"", batch_size);
+    assert_batch("\"", "a\"b\"c", batch_size);
+    assert_batch(",", "", batch_size);
+  }
+}
+
 TEST_F(delimited_token_stream_tests, test_make_config_json) {
   //with unknown parameter
   {
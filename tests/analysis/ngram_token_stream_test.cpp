@@ -214,6 +214,24 @@ TEST(ngram_token_stream_test, next_utf8) {
     }
     ASSERT_EQ(expected_token, expected.end());
     ASSERT_FALSE(stream.next());
+
+    // same tokens are produced in batches
+    ASSERT_TRUE(stream.batched());
+    ASSERT_TRUE(stream.reset(data));
+    expected_token = expected.begin();
+    irs::token tokens[3];
+    for (size_t count; (count = stream.next_batch(tokens, std::size(tokens))); ) {
+      ASSERT_LE(count, std::size(tokens));
+      for (auto* it = tokens; it != tokens + count; ++it, ++expected_token) {
+        ASSERT_NE(expected_token, expected.end());
+        ASSERT_EQ(irs::ref_cast<irs::byte_type>(expected_token->value), it->term);
+        ASSERT_EQ(expected_token->start, it->start);
+        ASSERT_EQ(expected_token->end, it->end);
+        ASSERT_TRUE(it->payload.null());
+      }
+      ASSERT_EQ(tokens[count - 1].end, offset->end);
+    }
+    ASSERT_EQ(expected_token, expected.end());
   };
 
   auto locale = irs::locale_utils::locale("C.UTF-8");
@@ -681,6 +699,24 @@ TEST(ngram_token_stream_test, next) {
     }
     ASSERT_EQ(expected_token, expected.end());
     ASSERT_FALSE(stream.next());
+
+    // same tokens are produced in batches
+    ASSERT_TRUE(stream.batched());
+    ASSERT_TRUE(stream.reset(data));
+    expected_token = expected.begin();
+    irs::token tokens[3];
+    for (size_t count; (count = stream.next_batch(tokens, std::size(tokens))); ) {
+      ASSERT_LE(count, std::size(tokens));
+      for (auto* it = tokens; it != tokens + count; ++it, ++expected_token) {
+        ASSERT_NE(expected_token, expected.end());
+        ASSERT_EQ(irs::ref_cast<irs::byte_type>(expected_token->value), it->term);
+        ASSERT_EQ(expected_token->start, it->start);
+        ASSERT_EQ(expected_token->end, it->end);
+        ASSERT_TRUE(it->payload.null());
+      }
+      ASSERT_EQ(tokens[count - 1].end, offset->end);
+    }
+    ASSERT_EQ(expected_token, expected.end());
   };
 
   {
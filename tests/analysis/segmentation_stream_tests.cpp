@@ -78,6 +78,28 @@ void assert_stream(irs::analysis::analyzer* pipe, const std::string& data, const
   }
   ASSERT_EQ(expected_token, expected_tokens.end());
   ASSERT_FALSE(pipe->next());
+
+  // same tokens are produced in batches
+  ASSERT_TRUE(pipe->batched());
+  ASSERT_TRUE(pipe->reset(data));
+  pos = std::numeric_limits<uint32_t>::max();
+  expected_token = expected_tokens.begin();
+  irs::token tokens[3];
+  for (size_t count; (count = pipe->next_batch(tokens, std::size(tokens))); ) {
+    ASSERT_LE(count, std::size(tokens));
+    for (auto* token = tokens; token != tokens + count; ++token) {
+      pos += token->increment;
+      ASSERT_NE(expected_token, expected_tokens.end());
+      ASSERT_EQ(irs::ref_cast<irs::byte_type>(expected_token->value), token->term);
+      ASSERT_EQ(expected_token->start, token->start);
+      ASSERT_EQ(expected_token->end, token->end);
+      ASSERT_EQ(expected_token->pos, pos);
+      ++expected_token;
+    }
+    ASSERT_EQ(tokens[count - 1].term, term->value);
+    ASSERT_EQ(tokens[count - 1].end, offset->end);
+  }
+  ASSERT_EQ(expected_token, expected_tokens.end());
 }
 
 
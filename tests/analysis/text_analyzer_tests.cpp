@@ -1452,3 +1452,86 @@ TEST_F(TextAnalyzerParserTestSuite, test_text_ngrams) {
     }
   }
 }
+
+TEST_F(TextAnalyzerParserTestSuite, test_ascii_fast_path) {
+  struct token {
+    std::string value;
+    uint32_t start;
+    uint32_t end;
+    uint32_t inc;
+
+    bool operator==(const token& rhs) const {
+      return value == rhs.value && start == rhs.start && end == rhs.end && inc == rhs.inc;
+    }
+  };
+
+  auto tokenize = [](analyzer& stream, const irs::string_ref& data) {
+    std::vector<token> tokens;
+    EXPECT_TRUE(stream.reset(data));
+
+    auto* term = irs::get<irs::term_attribute>(stream);
+    auto* offset = irs::get<irs::offset>(stream);
+    auto* inc = irs::get<irs::increment>(stream);
+
+    while (stream.next()) {
+      tokens.push_back(token{
+        static_cast<std::string>(irs::ref_cast<char>(term->value)),
+        offset->start, offset->end, inc->value });
+    }
+
+    return tokens;
+  };
+
+  // a non-ASCII suffix forces tokenization via ICU, i.e. ASCII data must be
+  // tokenized the same way with or without it
+  const std::string non_ascii_suffix = " \xC3\xA9"; // e with acute
+  auto assert_consistent = [&](analyzer& stream, const std::string& data) {
+    auto expected = tokenize(stream, data + non_ascii_suffix);
+    ASSERT_FALSE(expected.empty());
+    while (!expected.empty() && expected.back().start > data.size()) {
+      expected.pop_back();
+    }
+    ASSERT_EQ(expected, tokenize(stream, data)) << "data: '" << data << "'";
+  };
+
+  const std::vector<std::string> samples {
+    "", " ", "The QUICK brown-fox jumps over 2 lazy dogs",
+    "can't", "3.14", "1,000", "1;2", "foo_bar", "_", "__", "a_", "_1",
+    "U.S.A.", "e.g.", "a:b", "a..b", "1'2", "_a_", "a_.b", "x@y.com",
+    "\tmixed\r\nlines\n", "1.a", "a.1", "a1b", "$100 (approx.)"
+  };
+
+  for (auto case_convert : { text_token_stream::options_t::case_convert_t::LOWER,
+                             text_token_stream::options_t::case_convert_t::UPPER,
+                             text_token_stream::options_t::case_convert_t::NONE }) {
+    text_token_stream::options_t options;
+    options.locale = irs::locale_utils::locale("en_US.UTF-8");
+    options.case_convert = case_convert;
+    options.explicit_stopwords = { "the", "THE" };
+    options.explicit_stopwords_set = true;
+    text_token_stream stream(options, options.explicit_stopwords);
+
+    for (auto& data : samples) {
+      assert_consistent(stream, data);
+    }
+
+    // pseudo-random data made of characters affecting word boundaries
+    const irs::string_ref alphabet = "aZ19_.':,;@-! \t";
+    uint64_t seed = 42;
+    for (size_t i = 0; i < 1000; ++i) {
+      std::string data;
+      for (size_t size = 1 + i % 12; data.size() < size; ) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        data += alphabet[(seed >> 33) % alphabet.size()];
+      }
+      assert_consistent(stream, data);
+    }
+  }
+
+  // ngrams of ASCII words
+  {
+    auto stream = irs::analysis::analyzers::get("text", irs::type<irs::text_format::json>::get(), "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[], \"edgeNgram\" : {\"min\":1, \"max\":3, \"preserveOriginal\":true}}");
+    ASSERT_NE(nullptr, stream);
+    assert_consistent(*stream, " A  hErd of   quIck ");
+  }
+}
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <thread>
+
+#include "formats/columnstore_cache.hpp"
+
+TEST(columnstore_cache_test, next_id) {
+  const auto id0 = irs::columnstore_cache::next_id();
+  const auto id1 = irs::columnstore_cache::next_id();
+  ASSERT_NE(0, id0);
+  ASSERT_NE(0, id1);
+  ASSERT_NE(id0, id1);
+}
+
+TEST(columnstore_cache_test, get_put) {
+  irs::columnstore_cache cache(100, 1);
+
+  ASSERT_EQ(nullptr, cache.get(1, 0));
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+  ASSERT_EQ(100, stats.max_memory);
+
+  auto a = std::make_shared<const int>(42);
+  ASSERT_EQ(a, cache.put(1, 0, a, 10));
+  ASSERT_EQ(a, cache.get(1, 0));
+
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(10, stats.memory);
+
+  // block loaded concurrently
+  auto b = std::make_shared<const int>(42);
+  ASSERT_EQ(a, cache.put(1, 0, b, 10));
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(10, stats.memory);
+
+  // same offset, different columnstore
+  ASSERT_EQ(nullptr, cache.get(2, 0));
+  ASSERT_EQ(b, cache.put(2, 0, b, 20));
+  ASSERT_EQ(b, cache.get(2, 0));
+  ASSERT_EQ(a, cache.get(1, 0));
+
+  stats = cache.statistics();
+  ASSERT_EQ(3, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(2, stats.size);
+  ASSERT_EQ(30, stats.memory);
+
+  // block doesn't fit the cache
+  auto c = std::make_shared<const int>(42);
+  ASSERT_EQ(c, cache.put(3, 0, c, 101));
+  ASSERT_EQ(nullptr, cache.get(3, 0));
+  stats = cache.statistics();
+  ASSERT_EQ(2, stats.size);
+  ASSERT_EQ(30, stats.memory);
+  ASSERT_EQ(0, stats.evictions);
+
+  cache.clear();
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(0, stats.misses);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+  ASSERT_EQ(100, stats.max_memory);
+  ASSERT_EQ(nullptr, cache.get(1, 0));
+}
+
+TEST(columnstore_cache_test, evict) {
+  irs::columnstore_cache cache(100, 1);
+
+  for (uint64_t offset = 0; offset < 4; ++offset) {
+    cache.put(1, offset, std::make_shared<const uint64_t>(offset), 30);
+  }
+
+  // least recently used block is evicted
+  auto stats = cache.statistics();
+  ASSERT_EQ(3, stats.size);
+  ASSERT_EQ(90, stats.memory);
+  ASSERT_EQ(1, stats.evictions);
+  ASSERT_EQ(nullptr, cache.get(1, 0));
+
+  // mark block 1 as recently used
+  auto block = cache.get(1, 1);
+  ASSERT_NE(nullptr, block);
+  ASSERT_EQ(1, *std::static_pointer_cast<const uint64_t>(block));
+
+  cache.put(1, 4, std::make_shared<const uint64_t>(4), 30);
+  stats = cache.statistics();
+  ASSERT_EQ(3, stats.size);
+  ASSERT_EQ(2, stats.evictions);
+  ASSERT_EQ(nullptr, cache.get(1, 2));
+  ASSERT_NE(nullptr, cache.get(1, 1));
+  ASSERT_NE(nullptr, cache.get(1, 3));
+  ASSERT_NE(nullptr, cache.get(1, 4));
+
+  // evicted block remains valid while in use
+  cache.max_memory(30);
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(30, stats.memory);
+  ASSERT_EQ(30, stats.max_memory);
+  ASSERT_EQ(4, stats.evictions);
+  ASSERT_EQ(nullptr, cache.get(1, 1));
+  ASSERT_EQ(1, *std::static_pointer_cast<const uint64_t>(block));
+
+  // disable caching
+  cache.max_memory(0);
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+  ASSERT_EQ(5, stats.evictions);
+
+  block = std::make_shared<const uint64_t>(5);
+  ASSERT_EQ(block, cache.put(1, 5, block, 1));
+  ASSERT_EQ(nullptr, cache.get(1, 5));
+}
+
+TEST(columnstore_cache_test, erase) {
+  irs::columnstore_cache cache;
+
+  for (uint64_t offset = 0; offset < 4; ++offset) {
+    cache.put(1, offset, std::make_shared<const uint64_t>(offset), 10);
+    cache.put(2, offset, std::make_shared<const uint64_t>(offset), 20);
+  }
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(8, stats.size);
+  ASSERT_EQ(120, stats.memory);
+
+  cache.erase(1);
+  stats = cache.statistics();
+  ASSERT_EQ(4, stats.size);
+  ASSERT_EQ(80, stats.memory);
+  ASSERT_EQ(0, stats.evictions);
+
+  for (uint64_t offset = 0; offset < 4; ++offset) {
+    ASSERT_EQ(nullptr, cache.get(1, offset));
+    ASSERT_NE(nullptr, cache.get(2, offset));
+  }
+
+  cache.erase(3); // no such columnstore
+  ASSERT_EQ(4, cache.statistics().size);
+}
+
+TEST(columnstore_cache_test, shards) {
+  constexpr size_t SHARDS = 4;
+  irs::columnstore_cache cache(SHARDS*100, SHARDS);
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(SHARDS*100, stats.max_memory);
+
+  // block exceeding the share of a shard is admitted against the whole limit
+  auto block = std::make_shared<const int>(42);
+  ASSERT_EQ(block, cache.put(1, 0, block, SHARDS*100 + 1));
+  ASSERT_EQ(nullptr, cache.get(1, 0));
+  ASSERT_EQ(block, cache.put(1, 0, block, 101));
+  ASSERT_EQ(block, cache.get(1, 0));
+
+  for (uint64_t offset = 1; offset < 100; ++offset) {
+    cache.put(1, offset, std::make_shared<const uint64_t>(offset), 10);
+    cache.put(2, offset, std::make_shared<const uint64_t>(offset), 10);
+  }
+
+  stats = cache.statistics();
+  ASSERT_LT(0, stats.evictions);
+  ASSERT_LE(stats.memory, stats.max_memory);
+  ASSERT_EQ(1 + 2*99, stats.size + stats.evictions);
+
+  // evicted blocks are not accounted to their columnstore anymore
+  cache.erase(1);
+  ASSERT_LT(0, cache.statistics().size);
+
+  for (uint64_t offset = 0; offset < 100; ++offset) {
+    ASSERT_EQ(nullptr, cache.get(1, offset));
+  }
+
+  cache.erase(2);
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+}
+
+TEST(columnstore_cache_test, oversized) {
+  constexpr size_t SHARDS = 4;
+  constexpr size_t MAX_MEMORY = SHARDS*100;
+  irs::columnstore_cache cache(MAX_MEMORY, SHARDS);
+
+  // each shard gets an equal share of the memory limit
+  for (uint64_t offset = 0; offset < 10*MAX_MEMORY; ++offset) {
+    cache.put(1, offset, std::make_shared<const uint64_t>(offset), 1);
+  }
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(MAX_MEMORY, stats.memory);
+  ASSERT_EQ(MAX_MEMORY, stats.size);
+  const auto evictions = stats.evictions;
+
+  // block exceeding the share evicts blocks of other shards
+  auto block = std::make_shared<const int>(42);
+  ASSERT_EQ(block, cache.put(2, 0, block, MAX_MEMORY - 50));
+  ASSERT_EQ(block, cache.get(2, 0));
+  stats = cache.statistics();
+  ASSERT_EQ(MAX_MEMORY, stats.memory);
+  ASSERT_EQ(51, stats.size);
+  ASSERT_EQ(evictions + MAX_MEMORY - 50, stats.evictions);
+
+  // block of the whole limit
+  block = std::make_shared<const int>(42);
+  ASSERT_EQ(block, cache.put(2, 1, block, MAX_MEMORY));
+  ASSERT_EQ(block, cache.get(2, 1));
+  stats = cache.statistics();
+  ASSERT_EQ(MAX_MEMORY, stats.memory);
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(nullptr, cache.get(2, 0));
+
+  // block exceeding the limit
+  block = std::make_shared<const int>(42);
+  ASSERT_EQ(block, cache.put(2, 2, block, MAX_MEMORY + 1));
+  ASSERT_EQ(nullptr, cache.get(2, 2));
+  ASSERT_NE(nullptr, cache.get(2, 1));
+
+  // shrinking the limit evicts oversized blocks
+  cache.max_memory(MAX_MEMORY/2);
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.memory);
+  ASSERT_EQ(0, stats.size);
+
+  cache.erase(1);
+  cache.erase(2);
+  ASSERT_EQ(0, cache.statistics().memory);
+}
+
+TEST(columnstore_cache_test, concurrent) {
+  constexpr size_t THREADS = 8;
+  constexpr uint64_t BLOCKS = 1000;
+
+  irs::columnstore_cache cache(BLOCKS/2);
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < THREADS; ++i) {
+    threads.emplace_back([&cache]() {
+      for (uint64_t offset = 0; offset < BLOCKS; ++offset) {
+        auto block = cache.get(1, offset);
+
+        if (!block) {
+          block = cache.put(1, offset, std::make_shared<const uint64_t>(offset), 1);
+        }
+
+        ASSERT_NE(nullptr, block);
+        ASSERT_EQ(offset, *std::static_pointer_cast<const uint64_t>(block));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache.statistics();
+  ASSERT_EQ(THREADS*BLOCKS, stats.hits + stats.misses);
+  ASSERT_LT(0, stats.size);
+  ASSERT_LE(stats.size, BLOCKS/2);
+  ASSERT_EQ(stats.size, stats.memory);
+}
@@ -87,6 +87,62 @@ class format_10_test_case : public tests::format_test_case {
     ASSERT_FALSE(actual_pos->next());
   }
 
+  void assert_positions_seek(irs::doc_iterator& expected, irs::doc_iterator& actual) {
+    auto* expected_pos = irs::get_mutable<irs::position>(&expected);
+    auto* actual_pos = irs::get_mutable<irs::position>(&actual);
+    ASSERT_EQ(!expected_pos, !actual_pos);
+
+    if (!expected_pos) {
+      return;
+    }
+
+    auto* expected_offset = irs::get<irs::offset>(*expected_pos);
+    auto* actual_offset = irs::get<irs::offset>(*actual_pos);
+    ASSERT_EQ(!expected_offset, !actual_offset);
+
+    auto* expected_payload = irs::get<irs::payload>(*expected_pos);
+    auto* actual_payload = irs::get<irs::payload>(*actual_pos);
+    ASSERT_EQ(!expected_payload, !actual_payload);
+
+    struct position_data {
+      uint32_t value;
+      irs::offset offs;
+      irs::bstring pay;
+    };
+
+    std::vector<position_data> positions;
+    for (; expected_pos->next();) {
+      auto& pos = positions.emplace_back();
+      pos.value = expected_pos->value();
+      if (expected_offset) {
+        pos.offs = *expected_offset;
+      }
+      if (expected_payload) {
+        pos.pay = expected_payload->value;
+      }
+    }
+
+    // seek to every other position
+    for (size_t i = 1, size = positions.size(); i < size; i += 2) {
+      auto& pos = positions[i];
+      ASSERT_EQ(pos.value, actual_pos->seek(pos.value));
+      ASSERT_EQ(pos.value, actual_pos->seek(pos.value - 1)); // seek to the smaller position
+
+      if (expected_offset) {
+        ASSERT_EQ(pos.offs.start, actual_offset->start);
+        ASSERT_EQ(pos.offs.end, actual_offset->end);
+      }
+
+      if (expected_payload) {
+        ASSERT_EQ(irs::bytes_ref(pos.pay), actual_payload->value);
+      }
+    }
+
+    // seek after the existing positions
+    ASSERT_TRUE(irs::pos_limits::eof(actual_pos->seek(irs::pos_limits::eof())));
+    ASSERT_FALSE(actual_pos->next());
+  }
+
   void postings_seek(const std::vector<irs::doc_id_t>& docs, const irs::flags& features) {
     irs::field_meta field;
     field.features = features;
@@ -285,6 +341,22 @@ class format_10_test_case : public tests::format_test_case {
           }
         }
 
+        // seek positions of every 7th document
+        {
+          const size_t inc = 7;
+          const size_t seed = 0;
+          auto it = reader->iterator(field.features, field.features, read_meta);
+          ASSERT_FALSE(irs::doc_limits::valid(it->value()));
+
+          postings expected(docs.begin(), docs.end(), field.features);
+          for (size_t i = seed, size = docs.size(); i < size; i += inc) {
+            auto doc = docs[i];
+            ASSERT_EQ(doc, it->seek(doc));
+            ASSERT_EQ(doc, expected.seek(doc));
+            assert_positions_seek(expected, *it);
+          }
+        }
+
         // seek for INVALID_DOC
         {
           auto it = reader->iterator(field.features, irs::flags::empty_instance(), read_meta);
@@ -904,6 +976,78 @@ TEST_P(format_10_test_case, postings_seek) {
   }
 }
 
+TEST_P(format_10_test_case, postings_decode_values) {
+  // reader relying on the default decoding of pre-decoded values
+  struct byte_postings_reader final : irs::postings_reader {
+    explicit byte_postings_reader(irs::postings_reader::ptr&& impl)
+      : impl(std::move(impl)) {
+    }
+
+    virtual void prepare(
+        irs::index_input& in,
+        const irs::reader_state& state,
+        const irs::flags& features) override {
+      impl->prepare(in, state, features);
+    }
+
+    using irs::postings_reader::decode;
+
+    virtual size_t decode(
+        const irs::byte_type* in,
+        const irs::flags& features,
+        irs::term_meta& state) override {
+      return impl->decode(in, features, state);
+    }
+
+    virtual irs::doc_iterator::ptr iterator(
+        const irs::flags& field,
+        const irs::flags& features,
+        const irs::term_meta& meta) override {
+      return impl->iterator(field, features, meta);
+    }
+
+    virtual size_t bit_union(
+        const irs::flags& field,
+        const term_provider_f& provider,
+        size_t* set) override {
+      return impl->bit_union(field, provider, set);
+    }
+
+    irs::postings_reader::ptr impl;
+  };
+
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, codec);
+  auto impl = codec->get_postings_reader();
+  ASSERT_NE(nullptr, impl);
+  byte_postings_reader reader(codec->get_postings_reader());
+
+  const irs::flags features{ irs::type<irs::frequency>::get(), irs::type<irs::position>::get(), irs::type<irs::payload>::get() };
+
+  // values of 2 terms, the first one has skip list, the second one is
+  // a single document term followed by a value of the next term
+  const uint64_t values[] = {
+    1000, 4000, 1 << 20, 1 << 21, 1 << 10, 1 << 22, 1 << 15,
+    1, 0, 42, 43, 44, 45, 46
+  };
+
+  irs::version10::term_meta expected;
+  irs::version10::term_meta actual;
+  const auto* in = values;
+  for (size_t i = 0; i < 2; ++i) {
+    const size_t expected_size = impl->decode(in, features, expected);
+    ASSERT_EQ(expected_size, reader.decode(in, features, actual));
+    ASSERT_EQ(expected.docs_count, actual.docs_count);
+    ASSERT_EQ(expected.freq, actual.freq);
+    ASSERT_EQ(expected.doc_start, actual.doc_start);
+    ASSERT_EQ(expected.pos_start, actual.pos_start);
+    ASSERT_EQ(expected.pos_end, actual.pos_end);
+    ASSERT_EQ(expected.pay_start, actual.pay_start);
+    ASSERT_EQ(expected.e_skip_start, actual.e_skip_start);
+    in += expected_size;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        format specific test cases
 // -----------------------------------------------------------------------------
@@ -0,0 +1,616 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "search/term_filter.hpp"
+#include "store/directory_attributes.hpp"
+#include "store/memory_directory.hpp"
+#include "store/store_utils.hpp"
+#include "utils/bitset.hpp"
+#include "utils/index_utils.hpp"
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          format 15 specific tests
+// -----------------------------------------------------------------------------
+
+// stores uncompressed blocks, optionally with a marker as compression data
+template<bool Marker>
+struct marker_compression {
+  static constexpr irs::string_ref MARKER = "marker";
+
+  static size_t prepare_count;
+
+  struct compressor final : irs::compression::compressor {
+    virtual irs::bytes_ref compress(irs::byte_type* in, size_t size, irs::bstring& /*buf*/) override {
+      return irs::bytes_ref(in, size);
+    }
+
+    virtual void flush(data_output& out) override {
+      if (Marker) {
+        irs::write_string(out, MARKER);
+      }
+    }
+  };
+
+  struct decompressor final : irs::compression::decompressor {
+    virtual irs::bytes_ref decompress(
+        const irs::byte_type* src, size_t src_size,
+        irs::byte_type* dst, size_t dst_size) override {
+      if (src_size > dst_size) {
+        return irs::bytes_ref::NIL;
+      }
+
+      std::memcpy(dst, src, src_size);
+      return irs::bytes_ref(dst, src_size);
+    }
+
+    virtual bool prepare(data_input& in) override {
+      ++prepare_count;
+      return !Marker || MARKER == irs::read_string<std::string>(in);
+    }
+  };
+
+  static irs::compression::compressor::ptr make_compressor(
+      const irs::compression::options&) {
+    return std::make_shared<compressor>();
+  }
+
+  static irs::compression::decompressor::ptr make_decompressor() {
+    return std::make_shared<decompressor>();
+  }
+};
+
+template<bool Marker>
+size_t marker_compression<Marker>::prepare_count = 0;
+
+const irs::compression::compression_registrar MARKER_COMPRESSION(
+  irs::type<marker_compression<true>>::get(),
+  &marker_compression<true>::make_compressor,
+  &marker_compression<true>::make_decompressor);
+
+const irs::compression::compression_registrar NO_MARKER_COMPRESSION(
+  irs::type<marker_compression<false>>::get(),
+  &marker_compression<false>::make_compressor,
+  &marker_compression<false>::make_decompressor);
+
+class format_15_test_case : public tests::directory_test_case_base {
+ protected:
+  static constexpr size_t DOCS_COUNT = 1000;
+
+  // writes a single segment with DOCS_COUNT documents and masks
+  // documents having 'value' in a field 'name'
+  void write_masked_segment(const irs::string_ref& name, const irs::string_ref& value) {
+    std::string data = "[";
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      if (i) {
+        data += ",";
+      }
+      data += "{\"all\":\"all\",\"parity\":\"";
+      data += (i % 2 ? "odd" : "even");
+      data += "\",\"rare\":\"";
+      data += (i % 100 ? "no" : "yes");
+      data += "\"}";
+    }
+    data += "]";
+
+    tests::json_doc_generator gen(data.c_str(), &tests::generic_json_field_factory);
+
+    auto codec = irs::formats::get("1_5", "1_0");
+    ASSERT_NE(nullptr, codec);
+    auto writer = irs::index_writer::make(dir(), codec, irs::OM_CREATE);
+    ASSERT_NE(nullptr, writer);
+
+    for (const tests::document* doc; (doc = gen.next()) != nullptr;) {
+      ASSERT_TRUE(insert(*writer, doc->indexed.begin(), doc->indexed.end()));
+    }
+    writer->commit();
+
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = name;
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(value);
+    writer->documents().remove(irs::filter::ptr(std::move(filter)));
+    writer->commit();
+  }
+
+  // collects documents of the specified term
+  static std::vector<irs::doc_id_t> docs(
+      const irs::sub_reader& segment,
+      const irs::string_ref& name,
+      const irs::string_ref& value) {
+    std::vector<irs::doc_id_t> docs;
+
+    auto* terms = segment.field(name);
+    if (terms) {
+      auto term = terms->iterator();
+      if (term->seek(irs::ref_cast<irs::byte_type>(value))) {
+        for (auto it = term->postings(irs::flags::empty_instance()); it->next();) {
+          docs.emplace_back(it->value());
+        }
+      }
+    }
+
+    return docs;
+  }
+
+  // writes a column compressed with 'marker_compression<Marker>' using
+  // a columnstore of the specified format and ensures it's readable
+  template<bool Marker>
+  void assert_compression_data(const irs::string_ref& format, size_t expected_prepare_count) {
+    constexpr irs::doc_id_t DOCS = 100;
+    const irs::bytes_ref payload(irs::ref_cast<irs::byte_type>(irs::string_ref("abcd")));
+
+    auto codec = irs::formats::get(format, "1_0");
+    ASSERT_NE(nullptr, codec);
+    irs::segment_meta meta(std::string(format) + (Marker ? "_marker" : "_no_marker"), codec);
+
+    irs::field_id column_id;
+    {
+      auto writer = codec->get_columnstore_writer();
+      writer->prepare(dir(), meta);
+      auto column = writer->push_column({
+        irs::type<marker_compression<Marker>>::get(), {}, false });
+      column_id = column.first;
+
+      for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= DOCS; ++doc, ++meta.docs_count) {
+        column.second(doc).write_bytes(payload.c_str(), payload.size());
+      }
+
+      ASSERT_TRUE(writer->commit());
+    }
+
+    marker_compression<Marker>::prepare_count = 0;
+
+    auto reader = codec->get_columnstore_reader();
+    ASSERT_TRUE(reader->prepare(dir(), meta));
+    ASSERT_EQ(expected_prepare_count, marker_compression<Marker>::prepare_count);
+
+    auto* column = reader->column(column_id);
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+    irs::bytes_ref actual;
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= DOCS; ++doc) {
+      ASSERT_TRUE(values(doc, actual));
+      ASSERT_EQ(payload, actual);
+    }
+  }
+
+  void assert_masked_segment(const irs::string_ref& name,
+                             const irs::string_ref& masked,
+                             const irs::string_ref& live) {
+    auto reader = irs::directory_reader::open(dir());
+    ASSERT_EQ(1, reader.size());
+    auto& segment = reader[0];
+
+    const auto expected = docs(segment, name, live);
+    ASSERT_EQ(DOCS_COUNT, segment.docs_count());
+    ASSERT_EQ(expected.size(), segment.live_docs_count());
+
+    // all live documents
+    {
+      std::vector<irs::doc_id_t> actual;
+      for (auto it = segment.docs_iterator(); it->next();) {
+        actual.emplace_back(it->value());
+      }
+      ASSERT_EQ(expected, actual);
+    }
+
+    // masked postings
+    {
+      auto* terms = segment.field("all");
+      ASSERT_NE(nullptr, terms);
+      auto term = terms->iterator();
+      ASSERT_TRUE(term->next());
+
+      std::vector<irs::doc_id_t> actual;
+      for (auto it = segment.mask(term->postings(irs::flags::empty_instance())); it->next();) {
+        actual.emplace_back(it->value());
+      }
+      ASSERT_EQ(expected, actual);
+    }
+
+    // seek to masked documents
+    for (auto target : docs(segment, name, masked)) {
+      const auto next = std::upper_bound(expected.begin(), expected.end(), target);
+      const auto expected_doc = next == expected.end()
+        ? irs::doc_limits::eof()
+        : *next;
+
+      auto docs = segment.docs_iterator();
+      ASSERT_EQ(expected_doc, docs->seek(target));
+
+      auto* terms = segment.field("all");
+      ASSERT_NE(nullptr, terms);
+      auto term = terms->iterator();
+      ASSERT_TRUE(term->next());
+      auto postings = segment.mask(term->postings(irs::flags::empty_instance()));
+      ASSERT_EQ(expected_doc, postings->seek(target));
+    }
+  }
+};
+
+TEST_P(format_15_test_case, dense_docs_mask) {
+  write_masked_segment("parity", "even");
+  assert_masked_segment("parity", "even", "odd");
+}
+
+TEST_P(format_15_test_case, sparse_docs_mask) {
+  write_masked_segment("rare", "yes");
+  assert_masked_segment("rare", "yes", "no");
+}
+
+TEST_P(format_15_test_case, document_mask_dense_encoding) {
+  irs::document_mask mask;
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc < 10000; doc += 2) {
+    mask.emplace(doc);
+  }
+
+  irs::segment_meta meta("_1", nullptr);
+  meta.docs_count = 10000;
+  meta.version = 42;
+
+  uint64_t size_14;
+  {
+    auto writer = irs::formats::get("1_4")->get_document_mask_writer();
+    writer->write(dir(), meta, mask);
+    ASSERT_TRUE(dir().length(size_14, writer->filename(meta)));
+  }
+
+  meta.version = 43;
+
+  uint64_t size_15;
+  {
+    auto writer = irs::formats::get("1_5")->get_document_mask_writer();
+    writer->write(dir(), meta, mask);
+    ASSERT_TRUE(dir().length(size_15, writer->filename(meta)));
+  }
+
+  ASSERT_LT(size_15, size_14);
+
+  // read document mask
+  {
+    auto reader = irs::formats::get("1_5")->get_document_mask_reader();
+    irs::document_mask actual;
+    ASSERT_TRUE(reader->read(dir(), meta, actual));
+    ASSERT_EQ(mask, actual);
+  }
+
+  // read document mask in the form it's stored
+  {
+    auto reader = irs::formats::get("1_5")->get_document_mask_reader();
+    irs::bitset dense;
+    std::vector<irs::doc_id_t> sparse;
+    ASSERT_TRUE(reader->read(dir(), meta, dense, sparse));
+    ASSERT_TRUE(sparse.empty());
+    ASSERT_EQ(mask.size(), dense.count());
+    ASSERT_LE(dense.size(), irs::doc_limits::min() + meta.docs_count);
+    for (const auto doc : mask) {
+      ASSERT_TRUE(dense.test(doc));
+    }
+
+    // segment doesn't match the mask
+    meta.docs_count = 100;
+    ASSERT_THROW(reader->read(dir(), meta, dense, sparse), irs::index_error);
+    meta.docs_count = 10000;
+  }
+
+  // mask written by an older version is read sorted
+  {
+    meta.version = 42;
+    auto reader = irs::formats::get("1_5")->get_document_mask_reader();
+    irs::bitset dense;
+    std::vector<irs::doc_id_t> sparse;
+    ASSERT_TRUE(reader->read(dir(), meta, dense, sparse));
+    ASSERT_EQ(0, dense.size());
+    ASSERT_EQ(mask.size(), sparse.size());
+    ASSERT_TRUE(std::is_sorted(sparse.begin(), sparse.end()));
+    ASSERT_EQ(mask, irs::document_mask(sparse.begin(), sparse.end()));
+  }
+}
+
+TEST_P(format_15_test_case, columnstore_compression_data) {
+  ASSERT_TRUE(MARKER_COMPRESSION);
+  ASSERT_TRUE(NO_MARKER_COMPRESSION);
+
+  // old layout, compression data is always read
+  assert_compression_data<true>("1_4", 1);
+  assert_compression_data<false>("1_4", 1);
+
+  // compression data is read only if present
+  assert_compression_data<true>("1_5", 1);
+  assert_compression_data<false>("1_5", 0);
+}
+
+TEST_P(format_15_test_case, elias_fano_postings) {
+  constexpr size_t DOCS = 20000;
+  std::mt19937 engine;
+  std::bernoulli_distribution half(0.5);
+
+  // 'status' postings are dense and irregular, 'parity' postings are regular
+  std::string data = "[";
+  for (size_t i = 0; i < DOCS; ++i) {
+    if (i) {
+      data += ",";
+    }
+    data += "{\"status\":\"";
+    data += (half(engine) ? "on" : "off");
+    data += "\",\"parity\":\"";
+    data += (i % 2 ? "odd" : "even");
+    data += "\",\"rare\":\"";
+    data += (i % 1000 ? "no" : "yes");
+    data += "\"}";
+  }
+  data += "]";
+
+  auto write = [&data](irs::directory& dir, const irs::string_ref& codec) {
+    tests::json_doc_generator gen(data.c_str(), &tests::generic_json_field_factory);
+    auto writer = irs::index_writer::make(dir, irs::formats::get(codec), irs::OM_CREATE);
+    ASSERT_NE(nullptr, writer);
+
+    for (const tests::document* doc; (doc = gen.next()) != nullptr;) {
+      ASSERT_TRUE(insert(*writer, doc->indexed.begin(), doc->indexed.end()));
+    }
+    writer->commit();
+  };
+
+  // total size of document streams
+  auto doc_size = [](const irs::directory& dir) {
+    uint64_t total = 0;
+    dir.visit([&dir, &total](std::string& name) {
+      constexpr irs::string_ref EXT = ".doc";
+      uint64_t length;
+      if (name.size() > EXT.size()
+          && 0 == name.compare(name.size() - EXT.size(), EXT.size(), EXT.c_str())
+          && dir.length(length, name)) {
+        total += length;
+      }
+      return true;
+    });
+    return total;
+  };
+
+  irs::memory_directory expected_dir;
+  write(expected_dir, "1_5");
+  write(dir(), "1_5ef");
+  ASSERT_LT(doc_size(dir()), doc_size(expected_dir));
+
+  auto expected_reader = irs::directory_reader::open(expected_dir);
+  ASSERT_EQ(1, expected_reader.size());
+  auto reader = irs::directory_reader::open(dir());
+  ASSERT_EQ(1, reader.size());
+
+  for (auto& field : { "status", "parity", "rare" }) {
+    auto* expected_terms = expected_reader[0].field(field);
+    ASSERT_NE(nullptr, expected_terms);
+    auto* terms = reader[0].field(field);
+    ASSERT_NE(nullptr, terms);
+
+    auto expected_term = expected_terms->iterator();
+    auto term = terms->iterator();
+    while (expected_term->next()) {
+      ASSERT_TRUE(term->next());
+      ASSERT_EQ(expected_term->value(), term->value());
+
+      // iterate
+      {
+        auto expected_docs = expected_term->postings(irs::flags::empty_instance());
+        auto docs = term->postings(irs::flags::empty_instance());
+        while (expected_docs->next()) {
+          ASSERT_TRUE(docs->next());
+          ASSERT_EQ(expected_docs->value(), docs->value());
+        }
+        ASSERT_FALSE(docs->next());
+      }
+
+      // seek
+      {
+        std::uniform_int_distribution<irs::doc_id_t> step(1, 300);
+        auto expected_docs = expected_term->postings(irs::flags::empty_instance());
+        auto docs = term->postings(irs::flags::empty_instance());
+        for (irs::doc_id_t target = irs::doc_limits::min();
+             !irs::doc_limits::eof(expected_docs->value());
+             target += step(engine)) {
+          ASSERT_EQ(expected_docs->seek(target), docs->seek(target));
+        }
+      }
+    }
+    ASSERT_FALSE(term->next());
+  }
+}
+
+TEST_P(format_15_test_case, dense_postings) {
+  constexpr size_t DOCS = 20000;
+  std::mt19937 engine;
+  std::bernoulli_distribution half(0.5);
+
+  // 'on' and 'off' postings are dense in every segment, 'first' postings
+  // become dense only in a merged segment, 'yes' postings are never dense
+  std::vector<std::array<irs::string_ref, 3>> values(DOCS);
+  for (size_t i = 0; i < DOCS; ++i) {
+    values[i] = {
+      half(engine) ? "on" : "off",
+      i < DOCS/2 ? "first" : "second",
+      i % 1000 ? "no" : "yes" };
+  }
+
+  const std::string names[] { "status", "part", "rare" };
+
+  auto insert = [&values, &names](irs::index_writer& writer, size_t begin, size_t end) {
+    tests::binary_field field;
+    auto docs = writer.documents();
+
+    for (; begin != end; ++begin) {
+      auto doc = docs.insert();
+
+      for (size_t i = 0; i < IRESEARCH_COUNTOF(names); ++i) {
+        field.name(names[i]);
+        field.value(irs::ref_cast<irs::byte_type>(values[begin][i]));
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(field));
+      }
+    }
+  };
+
+  // first segment is written without dense postings
+  auto write = [&insert](irs::directory& dir, double threshold) {
+    auto codec = irs::formats::get("1_5ef");
+    ASSERT_NE(nullptr, codec);
+
+    {
+      auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE);
+      ASSERT_NE(nullptr, writer);
+      insert(*writer, 0, DOCS/2);
+      writer->commit();
+    }
+
+    irs::index_writer::init_options opts;
+    opts.dense_postings_threshold = threshold;
+    auto writer = irs::index_writer::make(dir, codec, irs::OM_APPEND, opts);
+    ASSERT_NE(nullptr, writer);
+    insert(*writer, DOCS/2, DOCS);
+    writer->commit();
+
+    auto reader = irs::directory_reader::open(dir);
+    ASSERT_EQ(2, reader.size());
+    ASSERT_EQ(DOCS/2, reader[1].docs_count());
+
+    ASSERT_TRUE(writer->consolidate(
+      irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count())));
+    writer->commit();
+  };
+
+  irs::memory_directory expected_dir;
+  write(expected_dir, 0.);
+  write(dir(), 0.3);
+
+  auto expected_reader = irs::directory_reader::open(expected_dir);
+  ASSERT_EQ(1, expected_reader.size());
+  auto reader = irs::directory_reader::open(dir());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(DOCS, reader[0].docs_count());
+
+  const size_t words = irs::bitset::bits_to_words(irs::doc_limits::min() + DOCS);
+
+  for (auto& field : names) {
+    auto* expected_terms = expected_reader[0].field(field);
+    ASSERT_NE(nullptr, expected_terms);
+    auto* terms = reader[0].field(field);
+    ASSERT_NE(nullptr, terms);
+    ASSERT_TRUE(terms->meta().features.empty());
+
+    std::vector<irs::seek_term_iterator::seek_cookie::ptr> expected_cookies;
+    std::vector<irs::seek_term_iterator::seek_cookie::ptr> cookies;
+
+    auto expected_term = expected_terms->iterator();
+    auto term = terms->iterator();
+    while (expected_term->next()) {
+      ASSERT_TRUE(term->next());
+      ASSERT_EQ(expected_term->value(), term->value());
+      expected_term->read();
+      term->read();
+      expected_cookies.emplace_back(expected_term->cookie());
+      cookies.emplace_back(term->cookie());
+
+      // iterate
+      {
+        auto expected_docs = expected_term->postings(irs::flags::empty_instance());
+        auto docs = term->postings(irs::flags::empty_instance());
+        ASSERT_EQ(irs::cost::extract(*expected_docs), irs::cost::extract(*docs));
+        ASSERT_FALSE(irs::doc_limits::valid(docs->value()));
+        while (expected_docs->next()) {
+          ASSERT_TRUE(docs->next());
+          ASSERT_EQ(expected_docs->value(), docs->value());
+        }
+        ASSERT_FALSE(docs->next());
+        ASSERT_TRUE(irs::doc_limits::eof(docs->value()));
+      }
+
+      // seek
+      {
+        std::uniform_int_distribution<irs::doc_id_t> step(1, 300);
+        auto expected_docs = expected_term->postings(irs::flags::empty_instance());
+        auto docs = term->postings(irs::flags::empty_instance());
+        for (irs::doc_id_t target = irs::doc_limits::min();
+             !irs::doc_limits::eof(expected_docs->value());
+             target += step(engine)) {
+          ASSERT_EQ(expected_docs->seek(target), docs->seek(target));
+        }
+      }
+    }
+    ASSERT_FALSE(term->next());
+
+    // union of all terms of a field
+    auto make_provider = [](const auto& cookies) {
+      return [begin = cookies.begin(), end = cookies.end()]() mutable
+          -> const irs::seek_term_iterator::seek_cookie* {
+        return begin != end ? (begin++)->get() : nullptr;
+      };
+    };
+
+    std::vector<size_t> expected_set(words);
+    std::vector<size_t> set(words);
+    ASSERT_EQ(
+      expected_terms->bit_union(make_provider(expected_cookies), expected_set.data()),
+      terms->bit_union(make_provider(cookies), set.data()));
+    ASSERT_EQ(expected_set, set);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  format_15_test,
+  format_15_test_case,
+  ::testing::Values(
+    &tests::memory_directory,
+    &tests::fs_directory,
+    &tests::mmap_directory,
+    &tests::rot13_cipher_directory<&tests::memory_directory, 16>
+  ),
+  tests::directory_test_case_base::to_string
+);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     generic tests
+// -----------------------------------------------------------------------------
+
+using tests::format_test_case;
+
+INSTANTIATE_TEST_CASE_P(
+  format_15_test,
+  format_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory,
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::fs_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+    ),
+    ::testing::Values(tests::format_info{"1_5", "1_0"},
+                      tests::format_info{"1_5ef", "1_0"})
+  ),
+  tests::to_string
+);
+
+}
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "formats_test_case_base.hpp"
+#include "formats/columnstore_cache.hpp"
 #include "formats/format_utils.hpp"
 #include "utils/lz4compression.hpp"
 
@@ -1078,6 +1079,134 @@ TEST_P(format_test_case, columns_rw_sparse_column_dense_block) {
   }
 }
 
+TEST_P(format_test_case, columns_rw_block_cache) {
+  auto& cache = irs::columnstore_cache::global();
+  auto restore_cache = irs::make_finally([&cache, max_memory = cache.statistics().max_memory]() {
+    cache.max_memory(max_memory);
+  });
+
+  irs::segment_meta seg("_1", codec());
+  constexpr irs::doc_id_t MAX_DOC = 10000;
+
+  auto expected_value = [](irs::doc_id_t doc) {
+    return std::to_string(doc) + std::string(doc % 7, 'x');
+  };
+
+  size_t column_id;
+
+  // write docs
+  {
+    auto writer = codec()->get_columnstore_writer();
+    writer->prepare(dir(), seg);
+    auto column = writer->push_column({
+      irs::type<irs::compression::lz4>::get(),
+      irs::compression::options(),
+      bool(irs::get_encryption(dir().attributes()))
+    });
+    column_id = column.first;
+    auto& column_handler = column.second;
+
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= MAX_DOC; ++doc, ++seg.docs_count) {
+      const auto value = expected_value(doc);
+      column_handler(doc).write_bytes(
+        reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+    }
+
+    ASSERT_TRUE(writer->commit());
+  }
+
+  auto reader = codec()->get_columnstore_reader();
+  ASSERT_TRUE(reader->prepare(dir(), seg));
+  auto* column = reader->column(column_id);
+  ASSERT_NE(nullptr, column);
+
+  auto read_all = [&](const irs::columnstore_reader::values_reader_f& values) {
+    irs::bytes_ref actual_value;
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= MAX_DOC; ++doc) {
+      ASSERT_TRUE(values(doc, actual_value));
+      ASSERT_EQ(expected_value(doc), irs::ref_cast<char>(actual_value));
+    }
+  };
+
+  cache.clear();
+
+  // each block is loaded once
+  read_all(column->values());
+  auto stats = cache.statistics();
+  const auto blocks = stats.misses;
+  ASSERT_LT(1, blocks);
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(blocks, stats.size);
+  ASSERT_LT(0, stats.memory);
+  ASSERT_LE(stats.memory, stats.max_memory);
+
+  // blocks are shared between readers
+  read_all(column->values());
+  stats = cache.statistics();
+  ASSERT_EQ(blocks, stats.hits);
+  ASSERT_EQ(blocks, stats.misses);
+  ASSERT_EQ(blocks, stats.size);
+
+  // blocks are shared with iterators
+  {
+    auto it = column->iterator();
+    auto* payload = irs::get<irs::payload>(*it);
+    ASSERT_NE(nullptr, payload);
+
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= MAX_DOC; ++doc) {
+      ASSERT_TRUE(it->next());
+      ASSERT_EQ(doc, it->value());
+      ASSERT_EQ(expected_value(doc), irs::ref_cast<char>(payload->value));
+    }
+    ASSERT_FALSE(it->next());
+
+    stats = cache.statistics();
+    ASSERT_EQ(2*blocks, stats.hits);
+    ASSERT_EQ(blocks, stats.misses);
+  }
+
+  // bounded cache
+  const auto block_memory = stats.memory / blocks;
+  cache.max_memory(2*block_memory);
+  stats = cache.statistics();
+  ASSERT_GE(2, stats.size);
+  ASSERT_LE(stats.memory, 2*block_memory);
+  ASSERT_EQ(blocks - stats.size, stats.evictions);
+
+  read_all(column->values());
+  stats = cache.statistics();
+  ASSERT_GE(2, stats.size);
+  ASSERT_LE(stats.memory, 2*block_memory);
+
+  // disabled cache, values remain valid till the next read
+  cache.max_memory(0);
+  ASSERT_EQ(0, cache.statistics().size);
+
+  {
+    auto values0 = column->values();
+    auto values1 = column->values();
+    irs::bytes_ref value0, value1;
+    ASSERT_TRUE(values0(1, value0));
+
+    for (irs::doc_id_t doc = MAX_DOC; doc > irs::doc_limits::min(); --doc) {
+      ASSERT_TRUE(values1(doc, value1));
+      ASSERT_EQ(expected_value(doc), irs::ref_cast<char>(value1));
+    }
+
+    ASSERT_EQ(expected_value(1), irs::ref_cast<char>(value0));
+    ASSERT_EQ(0, cache.statistics().size);
+  }
+
+  // blocks of a closed reader are dropped
+  cache.max_memory(irs::columnstore_cache::DEFAULT_MAX_MEMORY);
+  read_all(column->values());
+  ASSERT_EQ(blocks, cache.statistics().size);
+  reader.reset();
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+}
+
 TEST_P(format_test_case, columns_rw_dense_mask) {
   irs::segment_meta seg("_1", codec());
   const irs::doc_id_t MAX_DOC = 1026;
@@ -3239,6 +3368,33 @@ TEST_P(format_test_case, document_mask_rw) {
   }
 }
 
+TEST_P(format_test_case, document_mask_rw_dense) {
+  irs::document_mask mask_set;
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc < 1000; doc += 2) {
+    mask_set.emplace(doc);
+  }
+  irs::segment_meta meta("_1", nullptr);
+  meta.version = 42;
+
+  // write document_mask
+  {
+    auto writer = codec()->get_document_mask_writer();
+
+    writer->write(dir(), meta, mask_set);
+  }
+
+  // read document_mask
+  {
+    auto reader = codec()->get_document_mask_reader();
+    irs::document_mask expected;
+    EXPECT_TRUE(reader->read(dir(), meta, expected));
+    for (auto id : mask_set) {
+      EXPECT_EQ(1, expected.erase(id));
+    }
+    EXPECT_TRUE(expected.empty());
+  }
+}
+
 TEST_P(format_test_case, format_utils_checksum) {
   {
     auto stream = dir().create("file");
@@ -1214,3 +1214,229 @@ TEST_F(skip_reader_test, seek) {
     }
   }
 }
+
+TEST_F(skip_reader_test, seek_cached) {
+  const size_t count = 131072;
+  const size_t max_levels = 8;
+  const size_t skip_0 = 128;
+  const size_t skip_n = 8;
+  const std::string file = "docs";
+
+  irs::memory_directory dir;
+
+  // write data
+  {
+    irs::skip_writer writer(skip_0, skip_n);
+    size_t high = irs::doc_limits::invalid();
+
+    writer.prepare(
+      max_levels, count,
+      [&high](size_t, irs::index_output& out) {
+        out.write_vlong(high); // upper
+    });
+    ASSERT_TRUE(static_cast<bool>(writer));
+
+    irs::doc_id_t doc = irs::doc_limits::min();
+    for (size_t size = 0; size <= count; doc += 2, ++size) {
+      // skip every "skip" document
+      if (size && 0 == size % skip_0) {
+        writer.skip(size);
+      }
+
+      high = doc;
+    }
+
+    auto out = dir.create(file);
+    ASSERT_FALSE(!out);
+    writer.flush(*out);
+  }
+
+  // keeps the key of the last read skip per level similar to postings
+  struct reader_state {
+    irs::doc_id_t lower = irs::doc_limits::invalid();
+    irs::doc_id_t upper[max_levels]{};
+    size_t last_level = max_levels;
+  };
+
+  auto prepare = [&dir, &file](irs::skip_reader& reader, reader_state& state) {
+    auto in = dir.open(file, irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+    reader.prepare(
+      std::move(in), [&state](size_t level, irs::index_input& in) {
+        auto& upper = state.upper[level];
+
+        if (state.last_level > level) {
+          upper = state.lower;
+        } else {
+          state.lower = upper;
+        }
+        state.last_level = level;
+
+        if (in.eof()) {
+          upper = irs::doc_limits::eof();
+        } else {
+          upper = in.read_vlong();
+        }
+
+        return upper;
+    });
+  };
+
+  reader_state expected_state;
+  irs::skip_reader expected(skip_0, skip_n);
+  prepare(expected, expected_state);
+  ASSERT_EQ(4, expected.num_levels());
+  ASSERT_FALSE(expected.cached());
+
+  // level 2 shared by the readers
+  irs::skip_reader::cache_t cache;
+  std::vector<irs::doc_id_t> cached_states;
+
+  auto load = [&cached_states](reader_state& state) {
+    return [&cached_states, &state](size_t skip) {
+      ASSERT_LT(skip, cached_states.size());
+      state.lower = cached_states[skip];
+      state.last_level = 2;
+    };
+  };
+
+  reader_state state;
+  irs::skip_reader reader(skip_0, skip_n);
+  prepare(reader, state);
+  ASSERT_TRUE(reader.load_cache(
+    cache,
+    [&state, &cached_states](size_t skip) {
+      ASSERT_EQ(skip, cached_states.size());
+      cached_states.emplace_back(state.upper[2]);
+      state.last_level = 0;
+  }));
+  ASSERT_FALSE(reader.cached());
+  state.lower = irs::doc_limits::invalid();
+  std::fill_n(state.upper, max_levels, irs::doc_limits::invalid());
+  reader.reset();
+  reader.cache(cache, load(state));
+  ASSERT_TRUE(reader.cached());
+
+  // whole level 2 is loaded once
+  ASSERT_EQ(count/(skip_0*skip_n*skip_n), cached_states.size());
+  ASSERT_EQ(cached_states.size() + 1, cache.keys.size());
+  ASSERT_EQ(cached_states.size(), cache.ptrs.size());
+  ASSERT_TRUE(irs::doc_limits::eof(cache.keys.back()));
+
+  // reader sharing the cache
+  reader_state shared_state;
+  irs::skip_reader shared(skip_0, skip_n);
+  prepare(shared, shared_state);
+  shared.cache(cache, load(shared_state));
+  ASSERT_TRUE(shared.cached());
+
+  // seek for every document
+  {
+    irs::doc_id_t doc = irs::doc_limits::min();
+    for (size_t i = 0; i <= count; ++i, doc += 2) {
+      const size_t skipped = (i/skip_0) * skip_0;
+      ASSERT_EQ(skipped, reader.seek(doc));
+      ASSERT_LT(state.lower, doc);
+      ASSERT_LE(doc, state.upper[0]);
+    }
+  }
+
+  // seek with growing gaps, then with shrinking gaps
+  {
+    std::vector<irs::doc_id_t> targets;
+    irs::doc_id_t doc = irs::doc_limits::min();
+    for (size_t gap = 1; doc <= 2*count; gap *= 3) {
+      targets.emplace_back(doc);
+      doc += irs::doc_id_t(gap);
+    }
+    for (size_t gap = 2*count; gap; gap /= 5) {
+      targets.emplace_back(doc);
+      doc += irs::doc_id_t(gap);
+    }
+    targets.emplace_back(irs::doc_limits::eof());
+
+    for (auto* s : { &state, &shared_state, &expected_state }) {
+      s->lower = irs::doc_limits::invalid();
+      std::fill_n(s->upper, max_levels, irs::doc_limits::invalid());
+    }
+    reader.reset();
+    shared.reset();
+    expected.reset();
+
+    for (auto target : targets) {
+      const size_t skipped = expected.seek(target);
+      ASSERT_EQ(skipped, reader.seek(target));
+      ASSERT_EQ(skipped, shared.seek(target));
+      ASSERT_EQ(expected_state.lower, state.lower);
+      ASSERT_EQ(expected_state.upper[0], state.upper[0]);
+      ASSERT_EQ(expected_state.lower, shared_state.lower);
+      ASSERT_EQ(expected_state.upper[0], shared_state.upper[0]);
+    }
+  }
+
+  // seek backwards
+  {
+    irs::doc_id_t doc = count*2 + irs::doc_limits::min();
+    for (size_t i = count; i <= count; --i, doc -= 2) {
+      state.lower = irs::doc_limits::invalid();
+      std::fill_n(state.upper, max_levels, irs::doc_limits::invalid());
+      reader.reset();
+      const size_t skipped = (i/skip_0)*skip_0;
+      ASSERT_EQ(skipped, reader.seek(doc));
+      ASSERT_LT(state.lower, doc);
+      ASSERT_LE(doc, state.upper[0]);
+    }
+  }
+
+  ASSERT_EQ(count/(skip_0*skip_n*skip_n), cached_states.size());
+}
+
+TEST_F(skip_reader_test, seek_cached_single_level) {
+  const size_t count = 1000;
+  const size_t skip_0 = 128;
+  const size_t skip_n = 8;
+
+  irs::memory_directory dir;
+
+  {
+    irs::skip_writer writer(skip_0, skip_n);
+    irs::doc_id_t high = irs::doc_limits::invalid();
+    writer.prepare(
+      8, count,
+      [&high](size_t, irs::index_output& out) {
+        out.write_vint(high);
+    });
+
+    for (size_t size = 0; size <= count; ++size) {
+      if (size && 0 == size % skip_0) {
+        writer.skip(size);
+      }
+      high = irs::doc_id_t(size);
+    }
+
+    auto out = dir.create("docs");
+    ASSERT_FALSE(!out);
+    writer.flush(*out);
+  }
+
+  size_t calls_count = 0;
+  irs::skip_reader reader(skip_0, skip_n);
+  reader.prepare(
+    dir.open("docs", irs::IOAdvice::NORMAL),
+    [&calls_count](size_t level, irs::index_input& in) {
+      EXPECT_EQ(0, level);
+      ++calls_count;
+      return in.eof() ? irs::doc_limits::eof() : irs::doc_id_t(in.read_vint());
+  });
+  ASSERT_EQ(1, reader.num_levels());
+
+  irs::skip_reader::cache_t cache;
+  ASSERT_FALSE(reader.load_cache(cache, [](size_t) { FAIL(); }));
+  ASSERT_TRUE(cache.keys.empty());
+  cache.keys.emplace_back(irs::doc_limits::eof());
+  reader.cache(cache, [](size_t) { FAIL(); });
+  ASSERT_FALSE(reader.cached());
+
+  ASSERT_EQ(640, reader.seek(700));
+  ASSERT_EQ(6, calls_count);
+}
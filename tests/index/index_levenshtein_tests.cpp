@@ -26,6 +26,7 @@
 
 #include "index/index_tests.hpp"
 #include "utils/levenshtein_utils.hpp"
+#include "utils/utf8_utils.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/fstext/fst_table_matcher.hpp"
 
@@ -36,6 +37,9 @@ class levenshtein_automaton_index_test_case : public tests::index_test_base {
                     const irs::bytes_ref& target) {
     auto acceptor = irs::make_levenshtein_automaton(description, target);
     irs::automaton_table_matcher matcher(acceptor, true);
+    irs::bit_parallel_edit_distance bit_parallel_distance(
+      target, description.max_distance(), false);
+    ASSERT_TRUE(bool(bit_parallel_distance));
 
     for (auto& segment : reader) {
       auto fields = segment.fields();
@@ -56,6 +60,10 @@ class levenshtein_automaton_index_test_case : public tests::index_test_base {
 
           auto edit_distance = irs::edit_distance(expected_term, target);
           if (edit_distance > description.max_distance()) {
+            if (irs::utf8_utils::is_ascii(expected_term)) {
+              // byte-wise distance is the same as symbol-wise one
+              ASSERT_EQ(description.max_distance() + 1, bit_parallel_distance(expected_term));
+            }
             continue;
           }
 
@@ -73,6 +81,7 @@ class levenshtein_automaton_index_test_case : public tests::index_test_base {
           ASSERT_EQ(expected_term, actual_term);
           ASSERT_EQ(1, payload->value.size());
           ASSERT_EQ(edit_distance, payload->value[0]);
+          ASSERT_EQ(edit_distance, bit_parallel_distance(expected_term));
         }
       }
     }
@@ -23,10 +23,12 @@
 
 #include "index_tests.hpp"
 
+#include <future>
 #include <thread>
 
 #include "tests_shared.hpp" 
 #include "iql/query_builder.hpp"
+#include "search/term_filter.hpp"
 #include "store/memory_directory.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/lz4compression.hpp"
@@ -2572,6 +2574,78 @@ TEST_P(index_test_case, docs_bit_union) {
   docs_bit_union({irs::type<irs::frequency>::get()});
 }
 
+TEST_P(index_test_case, europarl_docs_batched_analyzers) {
+  // field tokenized by an analyzer producing tokens in batches
+  class analyzer_field : public tests::field_base {
+   public:
+    analyzer_field(const std::string& name, irs::analysis::analyzer::ptr&& stream)
+      : stream_(std::move(stream)) {
+      this->name(name);
+    }
+
+    void value(const std::string& value) { value_ = value; }
+
+    virtual const irs::flags& features() const override {
+      static irs::flags features{
+        irs::type<irs::frequency>::get(), irs::type<irs::position>::get(),
+        irs::type<irs::offset>::get(), irs::type<irs::payload>::get()
+      };
+      return features;
+    }
+
+    virtual irs::token_stream& get_tokens() const override {
+      stream_->reset(value_);
+      return *stream_;
+    }
+
+    virtual bool write(irs::data_output&) const override { return false; }
+
+   private:
+    irs::analysis::analyzer::ptr stream_;
+    std::string value_;
+  };
+
+  class doc_template : public tests::delim_doc_generator::doc_template {
+   public:
+    virtual void init() override {
+      clear();
+      add("title_delim", "delimiter", "{\"delimiter\":\" \"}");
+      add("title_ngram", "ngram", "{\"min\":1, \"max\":3, \"preserveOriginal\":true, \"streamType\":\"utf8\", \"startMarker\":\"^\", \"endMarker\":\"$\"}");
+      add("body_ngram", "ngram", "{\"min\":2, \"max\":3, \"preserveOriginal\":false, \"startMarker\":\"^\"}");
+      add("body_ngram_utf8", "ngram", "{\"min\":3, \"max\":4, \"preserveOriginal\":false, \"streamType\":\"utf8\", \"endMarker\":\"$\"}");
+    }
+
+    virtual void value(size_t idx, const std::string& value) override {
+      switch (idx) {
+        case 0: // title
+          indexed.get<analyzer_field>("title_delim")->value(value);
+          indexed.get<analyzer_field>("title_ngram")->value(value);
+          break;
+        case 2: // body
+          indexed.get<analyzer_field>("body_ngram")->value(value);
+          indexed.get<analyzer_field>("body_ngram_utf8")->value(value);
+          break;
+      }
+    }
+
+   private:
+    void add(const std::string& name, const irs::string_ref& type, const irs::string_ref& args) {
+      auto stream = irs::analysis::analyzers::get(type, irs::type<irs::text_format::json>::get(), args);
+      ASSERT_NE(nullptr, stream);
+      ASSERT_TRUE(stream->batched());
+      indexed.push_back(std::make_shared<analyzer_field>(name, std::move(stream)));
+    }
+  };
+
+  {
+    doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    tests::limiting_doc_generator limited_gen(gen, 0, 100);
+    add_segment(limited_gen);
+  }
+  assert_index();
+}
+
 TEST_P(index_test_case, europarl_docs_automaton) {
   {
     tests::templates::europarl_doc_template doc;
@@ -6258,6 +6332,280 @@ TEST_P(index_test_case, refresh_reader) {
   }
 }
 
+TEST_P(index_test_case, open_reader_concurrently) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+
+  // one segment per document
+  {
+    auto writer = open_writer();
+
+    for (const tests::document* doc; (doc = gen.next()) != nullptr;) {
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+      writer->commit();
+    }
+  }
+
+  auto assert_equal = [](const irs::directory_reader& expected,
+                         const irs::directory_reader& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.docs_count(), actual.docs_count());
+    ASSERT_EQ(expected.live_docs_count(), actual.live_docs_count());
+    ASSERT_EQ(expected.meta().meta, actual.meta().meta);
+
+    for (size_t i = 0, size = expected.size(); i < size; ++i) {
+      ASSERT_EQ(expected[i].docs_count(), actual[i].docs_count());
+      ASSERT_EQ(expected[i].live_docs_count(), actual[i].live_docs_count());
+
+      auto expected_docs = expected[i].docs_iterator();
+      auto actual_docs = actual[i].docs_iterator();
+      while (expected_docs->next()) {
+        ASSERT_TRUE(actual_docs->next());
+        ASSERT_EQ(expected_docs->value(), actual_docs->value());
+      }
+      ASSERT_FALSE(actual_docs->next());
+    }
+  };
+
+  irs::async_utils::thread_pool pool(4, 4);
+
+  auto expected = irs::directory_reader::open(dir(), codec());
+  auto actual = irs::directory_reader::open(dir(), codec(), &pool);
+  ASSERT_LT(1, actual.size());
+  assert_equal(expected, actual);
+
+  // remove a document and add a few segments
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = "name";
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("A"));
+    writer->documents().remove(irs::filter::ptr(std::move(filter)));
+    writer->commit();
+
+    gen.reset();
+    for (size_t i = 0; i < 3; ++i) {
+      auto* doc = gen.next();
+      ASSERT_NE(nullptr, doc);
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+      writer->commit();
+    }
+  }
+
+  expected = expected.reopen(codec());
+  actual = actual.reopen(codec(), &pool);
+  assert_equal(expected, actual);
+
+  // opening from a thread of a saturated pool doesn't wait for
+  // tasks stuck in the queue
+  {
+    irs::async_utils::thread_pool busy_pool(1, 1);
+    std::promise<irs::directory_reader> reader;
+    auto result = reader.get_future();
+
+    ASSERT_TRUE(busy_pool.run([&]() {
+      try {
+        reader.set_value(irs::directory_reader::open(dir(), codec(), &busy_pool));
+      } catch (...) {
+        reader.set_exception(std::current_exception());
+      }
+    }));
+
+    ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(30)));
+    assert_equal(expected, result.get());
+  }
+
+  // stopped pool falls back to sequential opening
+  pool.stop();
+  assert_equal(expected, irs::directory_reader::open(dir(), codec(), &pool));
+}
+
+TEST_P(index_test_case, nrt_reader) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  const tests::document* doc1 = gen.next();
+  const tests::document* doc2 = gen.next();
+  const tests::document* doc3 = gen.next();
+
+  auto live_docs = [](const irs::index_reader& reader) {
+    std::vector<irs::doc_id_t> docs;
+    for (auto& segment : reader) {
+      for (auto it = segment.docs_iterator(); it->next();) {
+        docs.emplace_back(it->value());
+      }
+    }
+    return docs;
+  };
+
+  auto writer = open_writer();
+
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_TRUE(insert(*writer,
+    doc2->indexed.begin(), doc2->indexed.end(),
+    doc2->stored.begin(), doc2->stored.end()
+  ));
+
+  // flushed documents are visible without commit
+  auto reader0 = writer->nrt_reader();
+  ASSERT_NE(nullptr, reader0);
+  ASSERT_EQ(1, reader0->size());
+  ASSERT_EQ(2, reader0->docs_count());
+  ASSERT_EQ(2, reader0->live_docs_count());
+  ASSERT_THROW(irs::directory_reader::open(dir(), codec()), irs::index_not_found);
+
+  // flushed files are referenced until commit
+  irs::directory_utils::remove_all_unreferenced(dir());
+
+  // removals are visible without commit, previous reader is unchanged
+  {
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = "name";
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("A"));
+    writer->documents().remove(irs::filter::ptr(std::move(filter)));
+  }
+
+  auto reader1 = writer->nrt_reader();
+  ASSERT_EQ(1, reader1->size());
+  ASSERT_EQ(1, reader1->live_docs_count());
+  ASSERT_EQ(2, reader0->live_docs_count());
+  ASSERT_EQ(2, live_docs(*reader0).size());
+  ASSERT_EQ(1, live_docs(*reader1).size());
+
+  // unchanged segments are shared with the reader cache
+  ASSERT_TRUE(insert(*writer,
+    doc3->indexed.begin(), doc3->indexed.end(),
+    doc3->stored.begin(), doc3->stored.end()
+  ));
+
+  auto reader2 = writer->nrt_reader();
+  ASSERT_EQ(2, reader2->size());
+  ASSERT_EQ(3, reader2->docs_count());
+  ASSERT_EQ(2, reader2->live_docs_count());
+  ASSERT_EQ((*reader1)[0].field("name"), (*reader2)[0].field("name"));
+
+  // no changes, same segments
+  auto reader3 = writer->nrt_reader();
+  ASSERT_EQ(reader2->size(), reader3->size());
+  ASSERT_EQ((*reader2)[0].field("name"), (*reader3)[0].field("name"));
+  ASSERT_EQ((*reader2)[1].field("name"), (*reader3)[1].field("name"));
+  ASSERT_THROW(irs::directory_reader::open(dir(), codec()), irs::index_not_found);
+
+  // flushed state is committed even without further changes
+  ASSERT_TRUE(writer->commit());
+  ASSERT_FALSE(writer->commit());
+
+  auto committed = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(reader3->size(), committed.size());
+  ASSERT_EQ(reader3->docs_count(), committed.docs_count());
+  ASSERT_EQ(reader3->live_docs_count(), committed.live_docs_count());
+  ASSERT_EQ(live_docs(*reader3), live_docs(committed));
+
+  // reader over committed state
+  auto reader4 = writer->nrt_reader();
+  ASSERT_EQ(committed.size(), reader4->size());
+  ASSERT_EQ(committed.live_docs_count(), reader4->live_docs_count());
+
+  // rollback discards flushed state
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_EQ(3, writer->nrt_reader()->live_docs_count());
+  ASSERT_TRUE(writer->begin());
+  writer->rollback();
+  ASSERT_EQ(2, writer->nrt_reader()->live_docs_count());
+  ASSERT_FALSE(writer->commit());
+  ASSERT_EQ(2, irs::directory_reader::open(dir(), codec()).live_docs_count());
+
+  // rollback without an open transaction discards flushed state too
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_EQ(3, writer->nrt_reader()->live_docs_count());
+  writer->rollback();
+  ASSERT_EQ(2, writer->nrt_reader()->live_docs_count());
+  ASSERT_FALSE(writer->commit());
+
+  {
+    auto committed = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, committed.live_docs_count());
+    ASSERT_EQ(live_docs(*reader4), live_docs(committed));
+  }
+
+  // writer remains usable after discarding flushed state
+  ASSERT_TRUE(insert(*writer,
+    doc2->indexed.begin(), doc2->indexed.end(),
+    doc2->stored.begin(), doc2->stored.end()
+  ));
+  ASSERT_TRUE(writer->commit());
+  ASSERT_EQ(3, irs::directory_reader::open(dir(), codec()).live_docs_count());
+}
+
+TEST_P(index_test_case, nrt_reader_consolidation) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  const tests::document* doc1 = gen.next();
+  const tests::document* doc2 = gen.next();
+  const tests::document* doc3 = gen.next();
+
+  auto writer = open_writer();
+
+  // 2 committed segments
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_TRUE(insert(*writer,
+    doc2->indexed.begin(), doc2->indexed.end(),
+    doc2->stored.begin(), doc2->stored.end()
+  ));
+  ASSERT_TRUE(writer->commit());
+  ASSERT_TRUE(insert(*writer,
+    doc3->indexed.begin(), doc3->indexed.end(),
+    doc3->stored.begin(), doc3->stored.end()
+  ));
+  ASSERT_TRUE(writer->commit());
+
+  // flushed but uncommitted removal
+  {
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = "name";
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("A"));
+    writer->documents().remove(irs::filter::ptr(std::move(filter)));
+  }
+  ASSERT_EQ(2, writer->nrt_reader()->live_docs_count());
+
+  // consolidation of committed segments must not resurrect removed document
+  ASSERT_TRUE(writer->consolidate(
+    irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count())));
+  ASSERT_TRUE(writer->commit());
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(2, reader.live_docs_count());
+
+  auto& segment = reader[0];
+  auto* terms = segment.field("name");
+  ASSERT_NE(nullptr, terms);
+  auto term = terms->iterator();
+  ASSERT_TRUE(term->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("A"))));
+  ASSERT_FALSE(segment.mask(term->postings(irs::flags::empty_instance()))->next());
+}
+
 TEST_P(index_test_case, reuse_segment_writer) {
   tests::json_doc_generator gen0(resource("arango_demo.json"), &tests::generic_json_field_factory);
   tests::json_doc_generator gen1(resource("simple_sequential.json"), &tests::generic_json_field_factory);
@@ -13971,6 +14319,32 @@ INSTANTIATE_TEST_CASE_P(
   tests::to_string
 );
 
+// Separate definition as MSVC parser fails to do conditional defines in macro expansion
+namespace {
+#if defined(IRESEARCH_SSE2)
+const auto index_test_case_15_values = ::testing::Values(tests::format_info{"1_5", "1_0"},
+                                                         tests::format_info{"1_5ef", "1_0"},
+                                                         tests::format_info{"1_5simd", "1_0"});
+#else
+const auto index_test_case_15_values = ::testing::Values(tests::format_info{"1_5", "1_0"},
+                                                         tests::format_info{"1_5ef", "1_0"});
+#endif
+}
+
+INSTANTIATE_TEST_CASE_P(
+  index_test_15,
+  index_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+    ),
+    index_test_case_15_values
+  ),
+  tests::to_string
+);
+
 class index_test_case_10 : public tests::index_test_base { };
 
 TEST_P(index_test_case_10, commit_payload) {
@@ -27,8 +27,14 @@
 #include "store/memory_directory.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/lz4compression.hpp"
+#include "utils/zstdcompression.hpp"
 #include "index/merge_writer.hpp"
 #include "index/comparer.hpp"
+#include "search/term_filter.hpp"
+#include "utils/async_utils.hpp"
+
+#include <future>
+#include <thread>
 
 namespace tests {
   class merge_writer_tests: public ::testing::Test {
@@ -2248,6 +2254,175 @@ TEST_F(merge_writer_tests, test_merge_writer_add_segments) {
   }
 }
 
+TEST_F(merge_writer_tests, test_merge_writer_concurrent) {
+  auto codec_ptr = irs::formats::get("1_0");
+  ASSERT_NE(nullptr, codec_ptr);
+  irs::memory_directory data_dir;
+
+  // populate directory
+  {
+    tests::json_doc_generator gen(
+      test_base::resource("simple_sequential.json"),
+      &tests::generic_json_field_factory
+    );
+
+    auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE);
+
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 10; ++j) {
+        auto* doc = gen.next();
+        ASSERT_NE(nullptr, doc);
+        ASSERT_TRUE(insert(
+          *writer,
+          doc->indexed.begin(), doc->indexed.end(),
+          doc->stored.begin(), doc->stored.end()
+        ));
+      }
+      writer->commit(); // create segmentN
+    }
+  }
+
+  auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+  ASSERT_EQ(3, reader.size());
+
+  irs::column_info_provider_t column_info = [](const irs::string_ref&) {
+    return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, true );
+  };
+
+  irs::async_utils::thread_pool pool(1, 1);
+
+  auto merge = [&](irs::directory& dir,
+                   irs::index_meta::index_segment_t& index_segment,
+                   irs::async_utils::thread_pool* pool,
+                   const irs::merge_writer::flush_progress_t& progress = {}) {
+    irs::merge_writer writer(dir, column_info, nullptr, pool);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    index_segment.meta.codec = codec_ptr;
+    return writer.flush(index_segment, progress);
+  };
+
+  irs::memory_directory expected_dir;
+  irs::index_meta::index_segment_t expected_segment;
+  ASSERT_TRUE(merge(expected_dir, expected_segment, nullptr));
+  auto expected = irs::segment_reader::open(expected_dir, expected_segment.meta);
+
+  // merged segment is equivalent to the one written sequentially
+  {
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    ASSERT_TRUE(merge(dir, index_segment, &pool));
+    ASSERT_EQ(expected_segment.meta.docs_count, index_segment.meta.docs_count);
+    ASSERT_EQ(expected_segment.meta.live_docs_count, index_segment.meta.live_docs_count);
+    ASSERT_EQ(expected_segment.meta.column_store, index_segment.meta.column_store);
+    ASSERT_EQ(expected_segment.meta.files.size(), index_segment.meta.files.size());
+
+    auto segment = irs::segment_reader::open(dir, index_segment.meta);
+    ASSERT_EQ(expected.docs_count(), segment.docs_count());
+
+    for (auto expected_fields = expected.fields(); expected_fields->next();) {
+      auto& expected_field = expected_fields->value();
+      auto* field = segment.field(expected_field.meta().name);
+      ASSERT_NE(nullptr, field);
+      ASSERT_EQ(expected_field.docs_count(), field->docs_count());
+      ASSERT_EQ(expected_field.size(), field->size());
+      ASSERT_EQ(irs::field_limits::valid(expected_field.meta().norm),
+                irs::field_limits::valid(field->meta().norm));
+
+      auto expected_terms = expected_field.iterator();
+      auto terms = field->iterator();
+
+      while (expected_terms->next()) {
+        ASSERT_TRUE(terms->next());
+        ASSERT_EQ(expected_terms->value(), terms->value());
+
+        auto expected_docs = expected_terms->postings(irs::flags::empty_instance());
+        auto docs = terms->postings(irs::flags::empty_instance());
+
+        while (expected_docs->next()) {
+          ASSERT_TRUE(docs->next());
+          ASSERT_EQ(expected_docs->value(), docs->value());
+        }
+        ASSERT_FALSE(docs->next());
+      }
+      ASSERT_FALSE(terms->next());
+    }
+
+    for (auto expected_columns = expected.columns(); expected_columns->next();) {
+      auto& expected_column = expected_columns->value();
+      auto* expected_values = expected.column_reader(expected_column.id);
+      ASSERT_NE(nullptr, expected_values);
+      auto* values = segment.column_reader(expected_column.name);
+      ASSERT_NE(nullptr, values);
+
+      auto expected_values_reader = expected_values->values();
+      auto values_reader = values->values();
+      irs::bytes_ref expected_value, value;
+
+      for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= expected.docs_count(); ++doc) {
+        ASSERT_EQ(expected_values_reader(doc, expected_value), values_reader(doc, value));
+        ASSERT_EQ(expected_value, value);
+      }
+    }
+  }
+
+  // termination requested by progress
+  {
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    index_segment.meta.name = "merged";
+    ASSERT_FALSE(merge(dir, index_segment, &pool, []() { return false; }));
+    ASSERT_TRUE(index_segment.meta.name.empty());
+    ASSERT_TRUE(index_segment.meta.files.empty());
+    ASSERT_EQ(0, index_segment.meta.docs_count);
+  }
+
+  // termination requested by progress while writing concurrently,
+  // progress is called only by the merging thread
+  for (size_t i = 1; i < 16; ++i) {
+    size_t call_count = i;
+    std::atomic<bool> foreign_thread{ false };
+    const auto merging_thread = std::this_thread::get_id();
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    index_segment.meta.name = "merged";
+
+    const bool res = merge(dir, index_segment, &pool, [&]() {
+      if (std::this_thread::get_id() != merging_thread) {
+        foreign_thread = true;
+      }
+
+      return 0 != call_count && 0 != --call_count;
+    });
+
+    ASSERT_FALSE(foreign_thread);
+
+    if (!res) {
+      ASSERT_TRUE(index_segment.meta.name.empty());
+      ASSERT_TRUE(index_segment.meta.files.empty());
+    }
+  }
+
+  // merge running on the only thread of the pool
+  {
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    std::packaged_task<bool()> task([&]() {
+      return merge(dir, index_segment, &pool);
+    });
+    auto res = task.get_future();
+
+    ASSERT_TRUE(pool.run([&task]() { task(); }));
+    ASSERT_EQ(std::future_status::ready, res.wait_for(std::chrono::seconds(30)));
+    ASSERT_TRUE(res.get());
+    ASSERT_EQ(expected_segment.meta.docs_count, index_segment.meta.docs_count);
+    ASSERT_EQ(expected_segment.meta.files.size(), index_segment.meta.files.size());
+  }
+}
+
 TEST_F(merge_writer_tests, test_merge_writer_flush_progress) {
   auto codec_ptr = irs::formats::get("1_0");
   ASSERT_NE(nullptr, codec_ptr);
@@ -2595,3 +2770,704 @@ TEST_F(merge_writer_tests, test_merge_writer_sorted) {
     ++expected_id;
   }
 }
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class positions_field
+/// @brief field emitting specified tokens with offsets and payloads
+////////////////////////////////////////////////////////////////////////////////
+class positions_field final : public tests::field_base {
+ public:
+  struct token {
+    std::string term;
+    std::string payload;
+  };
+
+  positions_field(const std::string& name, const irs::flags& features)
+    : features_(features) {
+    this->name(name);
+  }
+
+  const irs::flags& features() const override { return features_; }
+
+  irs::token_stream& get_tokens() const override {
+    stream_.reset(tokens);
+    return stream_;
+  }
+
+  bool write(irs::data_output&) const override { return false; }
+
+  std::vector<token> tokens;
+
+ private:
+  class stream final : public irs::token_stream {
+   public:
+    void reset(const std::vector<token>& tokens) {
+      tokens_ = &tokens;
+      next_ = 0;
+      offs_ = 0;
+    }
+
+    virtual bool next() override {
+      if (next_ == tokens_->size()) {
+        return false;
+      }
+
+      auto& token = (*tokens_)[next_++];
+      std::get<irs::term_attribute>(attrs_).value = irs::ref_cast<irs::byte_type>(token.term);
+      std::get<irs::payload>(attrs_).value = irs::ref_cast<irs::byte_type>(token.payload);
+      auto& offs = std::get<irs::offset>(attrs_);
+      offs.start = offs_;
+      offs.end = offs_ + uint32_t(token.term.size());
+      offs_ = offs.end + 1;
+
+      return true;
+    }
+
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      return irs::get_mutable(attrs_, type);
+    }
+
+   private:
+    std::tuple<irs::term_attribute, irs::increment, irs::offset, irs::payload> attrs_;
+    const std::vector<token>* tokens_{};
+    size_t next_{};
+    uint32_t offs_{};
+  };
+
+  irs::flags features_;
+  mutable stream stream_;
+}; // positions_field
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class stored_field
+/// @brief field storing a specified value in a column
+////////////////////////////////////////////////////////////////////////////////
+class stored_field final : public tests::field_base {
+ public:
+  stored_field(const std::string& name, const std::string& value)
+    : value_(value) {
+    this->name(name);
+  }
+
+  irs::token_stream& get_tokens() const override {
+    stream_.reset(value_);
+    return stream_;
+  }
+
+  bool write(irs::data_output& out) const override {
+    out.write_bytes(reinterpret_cast<const irs::byte_type*>(value_.c_str()), value_.size());
+    return true;
+  }
+
+  const std::string& value() const noexcept { return value_; }
+
+ private:
+  std::string value_;
+  mutable irs::string_token_stream stream_;
+}; // stored_field
+
+} // namespace
+
+TEST_F(merge_writer_tests, test_merge_writer_copy_postings) {
+  struct position_info {
+    uint32_t pos;
+    uint32_t start;
+    uint32_t end;
+    std::string payload;
+  };
+
+  using postings_t = std::map<irs::doc_id_t, std::vector<position_info>>;
+  using terms_t = std::map<std::string, postings_t>;
+
+  const irs::flags ALL_FEATURES{
+    irs::type<irs::frequency>::get(), irs::type<irs::position>::get(),
+    irs::type<irs::offset>::get(), irs::type<irs::payload>::get() };
+  const irs::flags POS_FEATURES{
+    irs::type<irs::frequency>::get(), irs::type<irs::position>::get() };
+  const irs::flags DOCS_FEATURES{ };
+
+  constexpr size_t SEGMENTS = 3;
+  constexpr size_t DOCS = 300; // more than 2 postings blocks
+  constexpr size_t REMOVED = 42; // doc removed from the last segment
+
+  for (auto* codec_name : { "1_0", "1_3" }) {
+    auto codec_ptr = irs::formats::get(codec_name);
+    ASSERT_NE(nullptr, codec_ptr);
+
+    irs::memory_directory data_dir;
+    std::map<std::string, terms_t> expected; // expected postings of merged segment
+
+    // populate directory
+    {
+      auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE);
+      irs::doc_id_t base = 0;
+
+      for (size_t i = 0; i < SEGMENTS; ++i) {
+        const std::string seg = std::to_string(i);
+
+        for (size_t j = 0; j < DOCS; ++j) {
+          auto all = std::make_shared<positions_field>("all", ALL_FEATURES);
+          auto pos = std::make_shared<positions_field>("pos", POS_FEATURES);
+          auto docs = std::make_shared<positions_field>("docs", DOCS_FEATURES);
+
+          docs->tokens.push_back({ "id" + seg + "_" + std::to_string(j), "" });
+          docs->tokens.push_back({ "segment" + seg, "" });
+          docs->tokens.push_back({ "common", "" });
+
+          for (size_t k = 0, count = j % 7 + 1; k < count; ++k) {
+            std::string payload((j + k) % 5 + 1, char('a' + k)); // variable length payload
+
+            all->tokens.push_back({ "segment" + seg, payload });
+            all->tokens.push_back({ "common", payload });
+            pos->tokens.push_back({ "segment" + seg, "" });
+            pos->tokens.push_back({ "rare" + seg + "_" + std::to_string(j % 50), "" });
+          }
+
+          if (7 == j) {
+            all->tokens.push_back({ "single" + seg, "single" });
+          }
+
+          tests::document doc;
+          doc.insert(all, true, false);
+          doc.insert(pos, true, false);
+          doc.insert(docs, true, false);
+
+          ASSERT_TRUE(insert(
+            *writer,
+            doc.indexed.begin(), doc.indexed.end(),
+            doc.stored.begin(), doc.stored.end()));
+
+          // compute expected postings of a merged segment
+          if (SEGMENTS - 1 == i && REMOVED == j) {
+            continue;
+          }
+
+          const irs::doc_id_t doc_id = ++base;
+
+          for (auto& field : { all, pos, docs }) {
+            auto& terms = expected[static_cast<std::string>(field->name())];
+            uint32_t position = irs::pos_limits::min();
+            uint32_t offset = 0;
+
+            for (auto& token : field->tokens) {
+              const uint32_t end = offset + uint32_t(token.term.size());
+              terms[token.term][doc_id].push_back({ position++, offset, end, token.payload });
+              offset = end + 1;
+            }
+          }
+        }
+
+        writer->commit(); // create segmentN
+      }
+
+      // remove a document from the last segment
+      auto filter = irs::by_term::make();
+      auto& filter_impl = static_cast<irs::by_term&>(*filter);
+      *filter_impl.mutable_field() = "docs";
+      filter_impl.mutable_options()->term = irs::ref_cast<irs::byte_type>(
+        irs::string_ref("id" + std::to_string(SEGMENTS - 1) + "_" + std::to_string(REMOVED)));
+      writer->documents().remove(std::move(filter));
+      writer->commit();
+    }
+
+    auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+    ASSERT_EQ(SEGMENTS, reader.size());
+
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    {
+      irs::column_info_provider_t column_info = [](const irs::string_ref&) {
+        return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, true );
+      };
+
+      irs::merge_writer writer(dir, column_info);
+
+      for (auto& sub_reader: reader) {
+        writer.add(sub_reader);
+      }
+
+      index_segment.meta.codec = codec_ptr;
+      ASSERT_TRUE(writer.flush(index_segment));
+    }
+
+    auto segment = irs::segment_reader::open(dir, index_segment.meta);
+    ASSERT_EQ(SEGMENTS*DOCS - 1, segment.docs_count());
+
+    auto assert_positions = [](const postings_t::value_type& expected_doc,
+                               const irs::flags& features,
+                               irs::doc_iterator& docs) {
+      if (!features.check<irs::frequency>()) {
+        return;
+      }
+
+      auto* freq = irs::get<irs::frequency>(docs);
+      ASSERT_NE(nullptr, freq);
+      ASSERT_EQ(expected_doc.second.size(), freq->value);
+
+      auto* pos = irs::get_mutable<irs::position>(&docs);
+      ASSERT_NE(nullptr, pos);
+      auto* offs = irs::get<irs::offset>(*pos);
+      auto* pay = irs::get<irs::payload>(*pos);
+      ASSERT_EQ(features.check<irs::offset>(), nullptr != offs);
+      ASSERT_EQ(features.check<irs::payload>(), nullptr != pay);
+
+      for (auto& expected_pos : expected_doc.second) {
+        ASSERT_TRUE(pos->next());
+        ASSERT_EQ(expected_pos.pos, pos->value());
+
+        if (offs) {
+          ASSERT_EQ(expected_pos.start, offs->start);
+          ASSERT_EQ(expected_pos.end, offs->end);
+        }
+
+        if (pay) {
+          ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_pos.payload)), pay->value);
+        }
+      }
+      ASSERT_FALSE(pos->next());
+    };
+
+    for (auto& expected_field : expected) {
+      auto* field = segment.field(expected_field.first);
+      ASSERT_NE(nullptr, field);
+      const auto& features = field->meta().features;
+      ASSERT_EQ(expected_field.second.size(), field->size());
+
+      auto terms = field->iterator();
+
+      for (auto& expected_term : expected_field.second) {
+        ASSERT_TRUE(terms->next());
+        ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_term.first)), terms->value());
+
+        // iterate over all postings
+        auto docs = terms->postings(features);
+
+        for (auto& expected_doc : expected_term.second) {
+          ASSERT_TRUE(docs->next());
+          ASSERT_EQ(expected_doc.first, docs->value());
+          assert_positions(expected_doc, features, *docs);
+        }
+        ASSERT_FALSE(docs->next());
+
+        // seek over postings using skip data
+        size_t i = 0;
+        for (auto& expected_doc : expected_term.second) {
+          if (0 != i++ % 61) {
+            continue;
+          }
+
+          auto docs = terms->postings(features);
+          ASSERT_EQ(expected_doc.first, docs->seek(expected_doc.first));
+          assert_positions(expected_doc, features, *docs);
+        }
+      }
+      ASSERT_FALSE(terms->next());
+    }
+  }
+}
+
+TEST_F(merge_writer_tests, test_merge_writer_copy_columns) {
+  using column_t = std::map<irs::doc_id_t, std::string>;
+
+  constexpr size_t SEGMENTS = 3;
+  constexpr size_t DOCS = 3000; // more than 2 index blocks
+  constexpr size_t REMOVED = 42; // doc removed from the last segment
+
+  const irs::column_info_provider_t column_info = [](const irs::string_ref& name) {
+    return name == "none"
+      ? irs::column_info(irs::type<irs::compression::none>::get(), irs::compression::options{}, false)
+      : irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, false);
+  };
+
+  for (auto* codec_name : { "1_0", "1_3" }) {
+    auto codec_ptr = irs::formats::get(codec_name);
+    ASSERT_NE(nullptr, codec_ptr);
+
+    irs::memory_directory data_dir;
+    std::map<std::string, column_t> expected; // expected columns of merged segment
+
+    // populate directory
+    {
+      irs::index_writer::init_options opts;
+      opts.column_info = column_info;
+
+      auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE, opts);
+      irs::doc_id_t base = 0;
+
+      for (size_t i = 0; i < SEGMENTS; ++i) {
+        for (size_t j = 0; j < DOCS; ++j) {
+          const std::string id = std::to_string(i) + "_" + std::to_string(j);
+          std::vector<std::shared_ptr<stored_field>> stored;
+
+          // dense fixed length column
+          stored.emplace_back(std::make_shared<stored_field>("fixed", std::string(8, char('a' + j % 26))));
+          // dense column without data
+          stored.emplace_back(std::make_shared<stored_field>("mask", ""));
+          // variable length column with values exceeding a data block
+          stored.emplace_back(std::make_shared<stored_field>("var", std::string(0 == j % 1000 ? 10000 : j % 7, char('a' + j % 26))));
+          // sparse column without compression
+          if (j % 3) {
+            stored.emplace_back(std::make_shared<stored_field>("none", id));
+          }
+          // column present in a single segment
+          if (1 == i) {
+            stored.emplace_back(std::make_shared<stored_field>("single", id));
+          }
+
+          tests::document doc;
+          doc.insert(std::make_shared<stored_field>("id", id), true, false);
+          for (auto& field : stored) {
+            doc.insert(field, false, true);
+          }
+
+          ASSERT_TRUE(insert(
+            *writer,
+            doc.indexed.begin(), doc.indexed.end(),
+            doc.stored.begin(), doc.stored.end()));
+
+          // compute expected columns of a merged segment
+          if (SEGMENTS - 1 == i && REMOVED == j) {
+            continue;
+          }
+
+          const irs::doc_id_t doc_id = ++base;
+
+          for (auto& field : stored) {
+            expected[static_cast<std::string>(field->name())][doc_id] = field->value();
+          }
+        }
+
+        writer->commit(); // create segmentN
+      }
+
+      // remove a document from the last segment
+      auto filter = irs::by_term::make();
+      auto& filter_impl = static_cast<irs::by_term&>(*filter);
+      *filter_impl.mutable_field() = "id";
+      filter_impl.mutable_options()->term = irs::ref_cast<irs::byte_type>(
+        irs::string_ref(std::to_string(SEGMENTS - 1) + "_" + std::to_string(REMOVED)));
+      writer->documents().remove(std::move(filter));
+      writer->commit();
+    }
+
+    auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+    ASSERT_EQ(SEGMENTS, reader.size());
+
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    {
+      irs::merge_writer writer(dir, column_info);
+
+      for (auto& sub_reader: reader) {
+        writer.add(sub_reader);
+      }
+
+      index_segment.meta.codec = codec_ptr;
+      ASSERT_TRUE(writer.flush(index_segment));
+    }
+
+    auto segment = irs::segment_reader::open(dir, index_segment.meta);
+    ASSERT_EQ(SEGMENTS*DOCS - 1, segment.docs_count());
+
+    for (auto& expected_column : expected) {
+      auto* column = segment.column_reader(expected_column.first);
+      ASSERT_NE(nullptr, column);
+      ASSERT_EQ(expected_column.second.size(), column->size());
+
+      // iterate over all values
+      auto it = column->iterator();
+      ASSERT_NE(nullptr, it);
+      auto* payload = irs::get<irs::payload>(*it);
+
+      for (auto& expected_value : expected_column.second) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(expected_value.first, it->value());
+
+        if (payload) {
+          ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), payload->value);
+        } else {
+          ASSERT_TRUE(expected_value.second.empty());
+        }
+      }
+      ASSERT_FALSE(it->next());
+
+      // random access
+      auto values = column->values();
+      irs::bytes_ref actual_value;
+
+      for (auto& expected_value : expected_column.second) {
+        ASSERT_TRUE(values(expected_value.first, actual_value));
+        ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), actual_value);
+      }
+    }
+  }
+}
+
+#ifdef USE_ZSTD
+
+TEST_F(merge_writer_tests, test_merge_writer_zstd_columns) {
+  using column_t = std::map<irs::doc_id_t, std::string>;
+
+  constexpr size_t SEGMENTS = 2;
+  constexpr size_t DOCS = 4000; // enough to train a dictionary
+
+  const irs::column_info_provider_t column_info = [](const irs::string_ref& name) {
+    if (name == "body") {
+      return irs::column_info(irs::type<irs::compression::zstd>::get(), irs::compression::options{}, false);
+    }
+
+    if (name == "id") { // no dictionary, self-contained blocks
+      return irs::column_info(
+        irs::type<irs::compression::zstd>::get(),
+        irs::compression::options{ irs::compression::options::Hint::DEFAULT, false }, false);
+    }
+
+    return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, false);
+  };
+
+  auto codec_ptr = irs::formats::get("1_5");
+  ASSERT_NE(nullptr, codec_ptr);
+
+  irs::memory_directory data_dir;
+  column_t expected; // expected column of merged segment
+  column_t expected_ids; // expected id column of merged segment
+
+  // populate directory
+  {
+    irs::index_writer::init_options opts;
+    opts.column_info = column_info;
+
+    auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE, opts);
+    irs::doc_id_t base = 0;
+
+    for (size_t i = 0; i < SEGMENTS; ++i) {
+      for (size_t j = 0; j < DOCS; ++j) {
+        const std::string id = std::to_string(i) + "_" + std::to_string(j);
+        const std::string body =
+          "{\"_key\":\"" + id + "\",\"name\":\"user" + std::to_string(j % 97) +
+          "\",\"address\":{\"city\":\"" + (j % 3 ? "Cologne" : "Berlin") +
+          "\",\"zip\":" + std::to_string(10000 + j*7 % 90000) +
+          "},\"tags\":[\"" + std::to_string(j % 13) + "\",\"" + std::to_string(j % 31) +
+          "\"],\"active\":" + (j % 2 ? "true" : "false") + "}";
+
+        tests::document doc;
+        doc.insert(std::make_shared<stored_field>("id", id), true, true);
+        doc.insert(std::make_shared<stored_field>("body", body), false, true);
+
+        ASSERT_TRUE(insert(
+          *writer,
+          doc.indexed.begin(), doc.indexed.end(),
+          doc.stored.begin(), doc.stored.end()));
+
+        expected[++base] = body;
+        expected_ids[base] = id;
+      }
+
+      writer->commit(); // create segmentN
+    }
+  }
+
+  auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+  ASSERT_EQ(SEGMENTS, reader.size());
+
+  irs::memory_directory dir;
+  irs::index_meta::index_segment_t index_segment;
+  {
+    irs::merge_writer writer(dir, column_info);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    index_segment.meta.codec = codec_ptr;
+    ASSERT_TRUE(writer.flush(index_segment));
+  }
+
+  auto segment = irs::segment_reader::open(dir, index_segment.meta);
+  ASSERT_EQ(SEGMENTS*DOCS, segment.docs_count());
+
+  auto* column = segment.column_reader("body");
+  ASSERT_NE(nullptr, column);
+  ASSERT_EQ(expected.size(), column->size());
+
+  // iterate over all values
+  auto it = column->iterator();
+  ASSERT_NE(nullptr, it);
+  auto* payload = irs::get<irs::payload>(*it);
+  ASSERT_NE(nullptr, payload);
+
+  for (auto& expected_value : expected) {
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(expected_value.first, it->value());
+    ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), payload->value);
+  }
+  ASSERT_FALSE(it->next());
+
+  // random access
+  auto values = column->values();
+  irs::bytes_ref actual_value;
+
+  for (auto& expected_value : expected) {
+    ASSERT_TRUE(values(expected_value.first, actual_value));
+    ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), actual_value);
+  }
+
+  // column without dictionary
+  auto* id_column = segment.column_reader("id");
+  ASSERT_NE(nullptr, id_column);
+  ASSERT_EQ(expected_ids.size(), id_column->size());
+
+  auto id_values = id_column->values();
+
+  for (auto& expected_value : expected_ids) {
+    ASSERT_TRUE(id_values(expected_value.first, actual_value));
+    ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), actual_value);
+  }
+}
+
+#endif // USE_ZSTD
+
+TEST_F(merge_writer_tests, test_merge_writer_sorted_columns) {
+  using column_t = std::map<std::string, std::string>; // sort key -> value
+
+  constexpr size_t SEGMENTS = 3;
+  constexpr size_t DOCS = 1500; // more than an index block
+  constexpr size_t REMOVED = 42; // doc removed from the last segment
+
+  const irs::column_info_provider_t column_info = [](const irs::string_ref&) {
+    return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, false);
+  };
+
+  auto codec_ptr = irs::formats::get("1_3");
+  ASSERT_NE(nullptr, codec_ptr);
+
+  binary_comparer test_comparer;
+  irs::memory_directory data_dir;
+  std::map<std::string, column_t> expected; // expected columns of merged segment
+
+  // populate directory, documents of all segments are interleaved in merged order
+  {
+    irs::index_writer::init_options opts;
+    opts.comparator = &test_comparer;
+    opts.column_info = column_info;
+
+    auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE, opts);
+
+    for (size_t i = 0; i < SEGMENTS; ++i) {
+      for (size_t j = 0; j < DOCS; ++j) {
+        const std::string id = std::to_string(i) + "_" + std::to_string(j);
+        char key[16];
+        snprintf(key, sizeof key, "%08u", unsigned((j * 7919 + i * 104729) % (SEGMENTS * DOCS * 100)));
+
+        std::vector<std::shared_ptr<stored_field>> stored;
+        // column present in all documents of all segments
+        stored.emplace_back(std::make_shared<stored_field>("dense", id));
+        // sparse column
+        if (j % 3) {
+          stored.emplace_back(std::make_shared<stored_field>("sparse", id));
+        }
+        // column present in all documents of a single segment
+        if (1 == i) {
+          stored.emplace_back(std::make_shared<stored_field>("single", id));
+        }
+
+        tests::document doc;
+        doc.insert(std::make_shared<stored_field>("id", id), true, false);
+        for (auto& field : stored) {
+          doc.insert(field, false, true);
+        }
+        doc.sorted = std::make_shared<stored_field>("key", key);
+
+        ASSERT_TRUE(insert(
+          *writer,
+          doc.indexed.begin(), doc.indexed.end(),
+          doc.stored.begin(), doc.stored.end(),
+          doc.sorted));
+
+        if (SEGMENTS - 1 == i && REMOVED == j) {
+          continue;
+        }
+
+        for (auto& field : stored) {
+          expected[static_cast<std::string>(field->name())][key] = field->value();
+        }
+        expected["id"][key] = id;
+      }
+
+      writer->commit(); // create segmentN
+    }
+
+    // remove a document from the last segment
+    auto filter = irs::by_term::make();
+    auto& filter_impl = static_cast<irs::by_term&>(*filter);
+    *filter_impl.mutable_field() = "id";
+    filter_impl.mutable_options()->term = irs::ref_cast<irs::byte_type>(
+      irs::string_ref(std::to_string(SEGMENTS - 1) + "_" + std::to_string(REMOVED)));
+    writer->documents().remove(std::move(filter));
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+  ASSERT_EQ(SEGMENTS, reader.size());
+
+  irs::memory_directory dir;
+  irs::index_meta::index_segment_t index_segment;
+  {
+    irs::merge_writer writer(dir, column_info, &test_comparer);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    index_segment.meta.codec = codec_ptr;
+    ASSERT_TRUE(writer.flush(index_segment));
+  }
+
+  auto segment = irs::segment_reader::open(dir, index_segment.meta);
+  ASSERT_EQ(SEGMENTS*DOCS - 1, segment.docs_count());
+
+  // merged doc id of each sort key
+  const auto& keys = expected["id"];
+  std::map<std::string, irs::doc_id_t> doc_ids;
+  for (auto& key : keys) {
+    doc_ids.emplace(key.first, irs::doc_id_t(irs::doc_limits::min() + doc_ids.size()));
+  }
+
+  for (auto& expected_column : expected) {
+    if (expected_column.first == "id") {
+      continue;
+    }
+
+    SCOPED_TRACE(expected_column.first);
+    auto* column = segment.column_reader(expected_column.first);
+    ASSERT_NE(nullptr, column);
+    ASSERT_EQ(expected_column.second.size(), column->size());
+
+    auto it = column->iterator();
+    ASSERT_NE(nullptr, it);
+    auto* payload = irs::get<irs::payload>(*it);
+    ASSERT_NE(nullptr, payload);
+
+    for (auto& expected_value : expected_column.second) {
+      ASSERT_TRUE(it->next());
+      ASSERT_EQ(doc_ids[expected_value.first], it->value());
+      ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected_value.second)), payload->value);
+    }
+    ASSERT_FALSE(it->next());
+  }
+
+  // postings are remapped according to merged order
+  auto* field = segment.field("id");
+  ASSERT_NE(nullptr, field);
+  auto terms = field->iterator();
+  ASSERT_NE(nullptr, terms);
+  for (auto& key : keys) {
+    ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref(key.second))));
+    auto docs = terms->postings(irs::flags::empty_instance());
+    ASSERT_TRUE(docs->next());
+    ASSERT_EQ(doc_ids[key.first], docs->value());
+    ASSERT_FALSE(docs->next());
+  }
+}
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/filter_cache.hpp"
+#include "search/term_filter.hpp"
+#include "store/memory_directory.hpp"
+
+namespace {
+
+void make_term(irs::by_term& filter, const irs::string_ref& field, const irs::string_ref& term) {
+  *filter.mutable_field() = field;
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+}
+
+irs::by_term make_term(const irs::string_ref& field, const irs::string_ref& term) {
+  irs::by_term filter;
+  make_term(filter, field, term);
+  return filter;
+}
+
+std::vector<irs::doc_id_t> execute(const irs::filter& filter, const irs::index_reader& reader) {
+  std::vector<irs::doc_id_t> docs;
+  auto prepared = filter.prepare(reader);
+
+  for (auto& segment : reader) {
+    auto it = segment.mask(prepared->execute(segment));
+    auto* doc = irs::get<irs::document>(*it);
+    EXPECT_NE(nullptr, doc);
+
+    while (it->next()) {
+      EXPECT_EQ(it->value(), doc->value);
+      docs.emplace_back(it->value());
+    }
+  }
+
+  return docs;
+}
+
+class filter_cache_test_case : public tests::filter_test_case_base {
+ protected:
+  void add_sequential() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+};
+
+TEST_P(filter_cache_test_case, admission_by_frequency) {
+  add_sequential();
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 2;
+  opts.min_cost = 0;
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("same", "xyz"));
+
+  const std::vector<irs::doc_id_t> expected{
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 };
+
+  // first usage, not cached
+  ASSERT_EQ(expected, execute(filter, rdr));
+  auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(0, stats.size);
+
+  // second usage, cached
+  ASSERT_EQ(expected, execute(filter, rdr));
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(1, stats.size);
+  ASSERT_LT(0, stats.memory);
+
+  // served from cache, equal filter
+  irs::cached_filter other;
+  other.cache(&cache);
+  other.filter(make_term("same", "xyz"));
+  ASSERT_EQ(filter, other);
+  ASSERT_EQ(expected, execute(other, rdr));
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(1, stats.size);
+
+  // seek over cached documents
+  {
+    auto it = filter.prepare(rdr)->execute(rdr[0]);
+    ASSERT_EQ(32, irs::cost::extract(*it));
+    ASSERT_EQ(7, it->seek(7));
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(8, it->value());
+    ASSERT_EQ(32, it->seek(32));
+    ASSERT_FALSE(it->next());
+    ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+  }
+
+  cache.clear();
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(0, stats.misses);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+}
+
+TEST_P(filter_cache_test_case, sparse) {
+  add_sequential();
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.min_cost = 0;
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("name", "C"));
+
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(std::vector<irs::doc_id_t>{ 3 }, execute(filter, rdr));
+  }
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(2, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(1, stats.size);
+
+  auto it = filter.prepare(rdr)->execute(rdr[0]);
+  ASSERT_EQ(1, irs::cost::extract(*it));
+  ASSERT_EQ(3, it->seek(2));
+  ASSERT_TRUE(irs::doc_limits::eof(it->seek(4)));
+}
+
+TEST_P(filter_cache_test_case, admission_by_cost) {
+  add_sequential();
+
+  auto rdr = open_reader();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.min_cost = 2;
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("name", "C"));
+
+  // too cheap to be cached
+  ASSERT_EQ(std::vector<irs::doc_id_t>{ 3 }, execute(filter, rdr));
+  ASSERT_EQ(std::vector<irs::doc_id_t>{ 3 }, execute(filter, rdr));
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.size);
+
+  // expensive enough
+  filter.filter(make_term("duplicated", "abcd"));
+  const auto expected = execute(filter, rdr);
+  ASSERT_LE(2, expected.size());
+  ASSERT_EQ(expected, execute(filter, rdr));
+
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(3, stats.misses);
+  ASSERT_EQ(1, stats.size);
+}
+
+TEST_P(filter_cache_test_case, segment_identity) {
+  add_sequential();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.min_cost = 0;
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("duplicated", "vczc"));
+
+  auto rdr = open_reader();
+  const auto expected = execute(filter, rdr);
+  ASSERT_LE(2, expected.size());
+  ASSERT_EQ(expected, execute(filter, rdr));
+  ASSERT_EQ(1, cache.statistics().hits);
+
+  // remove a document, i.e. change segment version
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    auto query = irs::by_term::make();
+    make_term(static_cast<irs::by_term&>(*query), "name", "B");
+    writer->documents().remove(std::move(query));
+    writer->commit();
+  }
+
+  auto new_rdr = open_reader();
+  ASSERT_EQ(1, new_rdr.size());
+  auto new_expected = expected;
+  new_expected.erase(std::find(new_expected.begin(), new_expected.end(), 2));
+  ASSERT_EQ(new_expected, execute(filter, new_rdr));
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(2, stats.size);
+
+  // old reader still uses its entry
+  ASSERT_EQ(expected, execute(filter, rdr));
+  ASSERT_EQ(2, cache.statistics().hits);
+}
+
+TEST_P(filter_cache_test_case, reader_identity) {
+  add_sequential();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.min_cost = 0;
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("same", "xyz"));
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  ASSERT_EQ(32, execute(filter, rdr).size());
+
+  // another index having a segment with the same name and version
+  irs::memory_directory other_dir;
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    auto* doc = gen.next();
+    ASSERT_NE(nullptr, doc);
+
+    auto writer = irs::index_writer::make(other_dir, codec(), irs::OM_CREATE);
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()));
+    writer->commit();
+  }
+
+  auto other_rdr = irs::directory_reader::open(other_dir, codec());
+  ASSERT_EQ(1, other_rdr.size());
+  ASSERT_EQ(std::vector<irs::doc_id_t>{ 1 }, execute(filter, other_rdr));
+  auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(2, stats.size);
+
+  // unchanged segments of a reopened reader are served from the cache
+  ASSERT_EQ(32, execute(filter, rdr.reopen()).size());
+  ASSERT_EQ(std::vector<irs::doc_id_t>{ 1 }, execute(filter, other_rdr.reopen()));
+  stats = cache.statistics();
+  ASSERT_EQ(2, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+}
+
+TEST_P(filter_cache_test_case, eviction) {
+  add_sequential();
+
+  auto rdr = open_reader();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.min_cost = 0;
+  opts.max_memory = 1; // every entry exceeds the limit
+  irs::filter_cache cache(opts);
+
+  irs::cached_filter filter;
+  filter.cache(&cache);
+  filter.filter(make_term("same", "xyz"));
+
+  ASSERT_EQ(32, execute(filter, rdr).size());
+  ASSERT_EQ(32, execute(filter, rdr).size());
+
+  const auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+}
+
+TEST(cached_filter_test, ctor) {
+  irs::cached_filter q;
+  ASSERT_EQ(irs::type<irs::cached_filter>::id(), q.type());
+  ASSERT_TRUE(q.empty());
+  ASSERT_EQ(nullptr, q.filter());
+  ASSERT_EQ(nullptr, q.cache());
+  ASSERT_EQ(irs::no_boost(), q.boost());
+}
+
+TEST(cached_filter_test, equal) {
+  irs::filter_cache cache;
+
+  irs::cached_filter lhs;
+  lhs.filter(make_term("field", "term"));
+  lhs.cache(&cache);
+
+  irs::cached_filter rhs;
+  rhs.filter(make_term("field", "term"));
+  rhs.cache(&cache);
+
+  ASSERT_EQ(lhs, rhs);
+  ASSERT_EQ(lhs.hash(), rhs.hash());
+
+  rhs.filter(make_term("field", "term1"));
+  ASSERT_NE(lhs, rhs);
+
+  rhs.filter(make_term("field", "term"));
+  rhs.cache(nullptr);
+  ASSERT_NE(lhs, rhs);
+}
+
+INSTANTIATE_TEST_CASE_P(
+  filter_cache_test,
+  filter_cache_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0")
+  ),
+  tests::to_string
+);
+
+}
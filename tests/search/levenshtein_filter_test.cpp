@@ -43,13 +43,16 @@ irs::by_edit_distance make_filter(
     const irs::string_ref term,
     irs::byte_type max_distance = 0,
     size_t max_terms = 0,
-    bool with_transpositions = false) {
+    bool with_transpositions = false,
+    irs::by_edit_distance_options::MatchStrategy strategy
+      = irs::by_edit_distance_options::MatchStrategy::AUTO) {
   irs::by_edit_distance q;
   *q.mutable_field() = field;
   q.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
   q.mutable_options()->max_distance = max_distance;
   q.mutable_options()->max_terms = max_terms;
   q.mutable_options()->with_transpositions = with_transpositions;
+  q.mutable_options()->strategy = strategy;
   return q;
 }
 
@@ -62,6 +65,7 @@ TEST(by_edit_distance_test, options) {
   ASSERT_EQ(0, opts.max_distance);
   ASSERT_EQ(0, opts.max_terms);
   ASSERT_FALSE(opts.with_transpositions);
+  ASSERT_EQ(irs::by_edit_distance_options::MatchStrategy::AUTO, opts.strategy);
   ASSERT_TRUE(opts.term.empty());
 }
 
@@ -82,6 +86,10 @@ TEST(by_edit_distance_test, equal) {
   ASSERT_NE(q, make_filter("field", "bar", 2, 0, true));
   ASSERT_NE(q, make_filter("field", "bar", 1, 1024, true));
   ASSERT_NE(q, make_filter("field", "bar", 1, 0, false));
+  ASSERT_EQ(q, make_filter("field", "bar", 1, 0, true,
+                           irs::by_edit_distance_options::MatchStrategy::BIT_PARALLEL));
+  ASSERT_EQ(q.hash(), make_filter("field", "bar", 1, 0, true,
+                                  irs::by_edit_distance_options::MatchStrategy::AUTOMATON).hash());
   {
     irs::by_prefix rhs;
     *rhs.mutable_field() = "field";
@@ -388,6 +396,74 @@ TEST_P(by_edit_distance_test_case, test_filter) {
   check_query(make_filter("title", "", 5, 0, true), docs_t{}, costs_t{0}, rdr);
 }
 
+TEST_P(by_edit_distance_test_case, test_strategies) {
+  using strategy_t = irs::by_edit_distance_options::MatchStrategy;
+
+  // add data
+  {
+    tests::json_doc_generator gen(
+      resource("levenshtein_sequential.json"),
+      &tests::generic_json_field_factory
+    );
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+  const auto* reader = segment.field("title");
+  ASSERT_NE(nullptr, reader);
+
+  auto visit = [&segment, reader](
+      const irs::string_ref& term,
+      irs::byte_type max_distance,
+      bool with_transpositions,
+      strategy_t strategy) {
+    irs::by_edit_distance_filter_options opts;
+    opts.term = irs::ref_cast<irs::byte_type>(term);
+    opts.max_distance = max_distance;
+    opts.with_transpositions = with_transpositions;
+    opts.strategy = strategy;
+
+    tests::empty_filter_visitor visitor;
+    auto field_visitor = irs::by_edit_distance::visitor(opts);
+    field_visitor(segment, *reader, visitor);
+    return visitor.terms();
+  };
+
+  const irs::string_ref TARGETS[] {
+    "", "a", "aa", "ab", "ba", "abc", "ababab", "bababa", "abcd", "aabbcc"
+  };
+
+  for (auto& target : TARGETS) {
+    for (irs::byte_type max_distance = 1; max_distance <= 3; ++max_distance) {
+      for (const bool with_transpositions : { false, true }) {
+        SCOPED_TRACE(testing::Message("Target: '") << target
+                     << "', Distance: " << size_t(max_distance)
+                     << ", Transpositions: " << with_transpositions);
+
+        const auto expected = visit(target, max_distance, with_transpositions, strategy_t::AUTOMATON);
+        ASSERT_EQ(expected, visit(target, max_distance, with_transpositions, strategy_t::BIT_PARALLEL));
+        ASSERT_EQ(expected, visit(target, max_distance, with_transpositions, strategy_t::AUTO));
+
+        docs_t expected_docs;
+        {
+          auto prepared = make_filter("title", target, max_distance, 0, with_transpositions,
+                                      strategy_t::AUTOMATON).prepare(rdr);
+          auto docs = prepared->execute(segment);
+          while (docs->next()) {
+            expected_docs.emplace_back(docs->value());
+          }
+        }
+
+        check_query(make_filter("title", target, max_distance, 0, with_transpositions,
+                                strategy_t::BIT_PARALLEL),
+                    expected_docs, rdr);
+      }
+    }
+  }
+}
+
 TEST_P(by_edit_distance_test_case, visit) {
   // add segment
   {
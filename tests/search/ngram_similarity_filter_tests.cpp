@@ -576,6 +576,59 @@ TEST_P(ngram_similarity_filter_test_case, check_matcher_10) {
   }
 }
 
+TEST_P(ngram_similarity_filter_test_case, check_matcher_reuse_between_docs) {
+  // candidate buffers are reused between documents of a segment, documents
+  // of different lengths must not see candidates of the previous ones
+  {
+    tests::json_doc_generator gen(
+      "[{ \"seq\" : 1, \"field\": [ \"1\", \"1\", \"2\", \"2\", \"3\", \"3\", \"4\", \"4\"] },"
+      " { \"seq\" : 2, \"field\": [ \"1\", \"3\", \"4\", \"5\", \"2\"] },"
+      " { \"seq\" : 3, \"field\": [ \"1\", \"2\", \"3\", \"4\", \"1\", \"2\", \"3\", \"4\"] },"
+      " { \"seq\" : 4, \"field\": [ \"4\", \"3\"] },"
+      " { \"seq\" : 5, \"field\": [ \"1\", \"2\", \"3\", \"4\", \"5\", \"6\", \"7\", \"8\", \"9\", \"1\", \"2\", \"3\", \"4\"] },"
+      " { \"seq\" : 6, \"field\": [ \"2\", \"3\"] }]",
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  irs::order order;
+  order.add<tests::sort::custom_sort>(false);
+  irs::by_ngram_similarity filter = make_filter("field", {"1", "2", "3", "4"}, 0.5f);
+
+  // document, longest sequence, frequency, document 4 matches 2 terms
+  // but has no long enough sequence
+  const std::vector<std::tuple<irs::doc_id_t, irs::string_ref, uint32_t>> expected{
+    { 1, "11223344", 1 },
+    { 2, "13452", 1 },
+    { 3, "12341234", 2 },
+    { 5, "1234567891234", 2 },
+    { 6, "23", 1 } };
+
+  auto prepared_order = order.prepare();
+  auto prepared = filter.prepare(rdr, prepared_order);
+  ASSERT_EQ(1, rdr.size());
+  auto docs = prepared->execute(rdr[0], prepared_order);
+  auto* doc = irs::get<irs::document>(*docs);
+  auto* boost = irs::get<irs::filter_boost>(*docs);
+  auto* frequency = irs::get<irs::frequency>(*docs);
+  ASSERT_TRUE(bool(doc));
+  ASSERT_TRUE(bool(boost));
+  ASSERT_TRUE(bool(frequency));
+
+  const irs::string_ref lhs = "1234";
+  for (auto& [id, rhs, freq] : expected) {
+    SCOPED_TRACE(testing::Message("doc=") << id);
+    ASSERT_TRUE(docs->next());
+    ASSERT_EQ(id, doc->value);
+    ASSERT_DOUBLE_EQ(
+      boost->value,
+      (irs::ngram_similarity<char, true>(lhs.begin(), lhs.size(), rhs.begin(), rhs.size(), 1)));
+    ASSERT_EQ(freq, frequency->value);
+  }
+  ASSERT_FALSE(docs->next());
+}
+
 TEST_P(ngram_similarity_filter_test_case, no_match_case) {
   {
     tests::json_doc_generator gen(
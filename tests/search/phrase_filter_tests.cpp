@@ -65,6 +65,51 @@ void analyzed_json_field_factory(
   }
 }
 
+void common_grams_json_field_factory(
+    tests::document& doc,
+    const std::string& name,
+    const tests::json_doc_generator::json_value& data) {
+  class analyzer_field : public tests::field_base {
+   public:
+    analyzer_field(
+        const std::string& name,
+        const irs::string_ref& value,
+        irs::analysis::analyzer::ptr stream)
+      : stream_(std::move(stream)), value_(value) {
+      this->name(name);
+      features() = { irs::type<irs::frequency>::get(), irs::type<irs::position>::get() };
+    }
+
+    irs::token_stream& get_tokens() const override {
+      stream_->reset(value_);
+      return *stream_;
+    }
+
+    bool write(irs::data_output&) const override { return false; }
+
+   private:
+    irs::analysis::analyzer::ptr stream_;
+    std::string value_;
+  }; // analyzer_field
+
+  if (data.is_string()) {
+    // tokenized field
+    doc.indexed.push_back(std::make_shared<analyzer_field>(
+      name + "_anl", data.str,
+      irs::analysis::analyzers::get(
+        "delimiter", irs::type<irs::text_format::json>::get(),
+        "{\"delimiter\":\" \"}")));
+
+    // tokenized field with common grams
+    doc.indexed.push_back(std::make_shared<analyzer_field>(
+      name + "_grams", data.str,
+      irs::analysis::analyzers::get(
+        "common_grams", irs::type<irs::text_format::json>::get(),
+        "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\" \"}},"
+        "\"words\":[\"the\",\"of\",\"in\",\"to\",\"we\",\"are\",\"as\",\"an\",\"a\"]}")));
+  }
+}
+
 }
 
 class phrase_filter_test_case : public tests::filter_test_case_base { };
@@ -7380,6 +7425,114 @@ TEST_P(phrase_filter_test_case, sequential_several_terms) {
   }
 }
 
+TEST_P(phrase_filter_test_case, sequential_common_grams) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      &tests::common_grams_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  auto make_phrase = [](const std::vector<irs::string_ref>& terms) {
+    irs::by_phrase q;
+    *q.mutable_field() = "phrase_anl";
+    for (auto& term : terms) {
+      q.mutable_options()->push_back<irs::by_term_options>().term =
+        irs::ref_cast<irs::byte_type>(term);
+    }
+    return q;
+  };
+
+  auto execute = [&rdr](const irs::filter& q) {
+    docs_t result;
+    auto prepared = q.prepare(rdr, irs::order::prepared::unordered());
+    for (const auto& sub : rdr) {
+      auto docs = prepared->execute(sub);
+      while (docs->next()) {
+        result.push_back(docs->value());
+      }
+    }
+    return result;
+  };
+
+  auto set_common_grams = [](irs::by_phrase& q, std::initializer_list<irs::string_ref> words) {
+    auto& common_grams = q.mutable_options()->common_grams();
+    common_grams.field = "phrase_grams";
+    for (auto& word : words) {
+      common_grams.words.emplace(irs::ref_cast<irs::byte_type>(word));
+    }
+  };
+
+  const std::vector<std::vector<irs::string_ref>> phrases{
+    { "as", "in", "the", "past" },
+    { "in", "the", "past" },
+    { "in", "the" },
+    { "the", "past" },
+    { "over", "the", "lazy", "dog" },
+    { "jumps", "over", "the" },
+    { "looking", "forward", "to", "the", "debate" },
+    { "we", "are", "looking", "forward" },
+    { "we", "do", "not", "see" },
+    { "quick", "brown", "fox" },
+    { "the", "end", "of" },
+    { "the", "the" },
+    { "the" },
+    { "of", "an", "endless" },
+    { "the", "missing", "past" },
+  };
+
+  for (auto& phrase : phrases) {
+    auto expected_query = make_phrase(phrase);
+    auto expected = execute(expected_query);
+
+    auto q = make_phrase(phrase);
+    set_common_grams(q, { "the", "of", "in", "to", "we", "are", "as", "an", "a" });
+    ASSERT_EQ(expected, execute(q));
+  }
+
+  // ensure bigrams are used: words mismatching the indexed ones
+  {
+    auto q = make_phrase({ "quick", "brown", "fox" });
+    set_common_grams(q, { "brown" });
+    ASSERT_TRUE(execute(q).empty());
+    ASSERT_FALSE(execute(make_phrase({ "quick", "brown", "fox" })).empty());
+  }
+
+  // no common words, original phrase
+  {
+    auto q = make_phrase({ "quick", "brown", "fox" });
+    set_common_grams(q, { "the" });
+    ASSERT_EQ(execute(make_phrase({ "quick", "brown", "fox" })), execute(q));
+  }
+
+  // phrase with gaps, original phrase
+  {
+    irs::by_phrase expected_query;
+    *expected_query.mutable_field() = "phrase_anl";
+    expected_query.mutable_options()->push_back<irs::by_term_options>().term =
+      irs::ref_cast<irs::byte_type>(irs::string_ref("as"));
+    expected_query.mutable_options()->push_back<irs::by_term_options>(1).term =
+      irs::ref_cast<irs::byte_type>(irs::string_ref("the"));
+    auto expected = execute(expected_query);
+    ASSERT_FALSE(expected.empty());
+
+    auto q = expected_query;
+    set_common_grams(q, { "as" });
+    ASSERT_EQ(expected, execute(q));
+  }
+
+  // companion field is missing, original phrase
+  {
+    auto q = make_phrase({ "as", "in", "the", "past" });
+    set_common_grams(q, { "the" });
+    q.mutable_options()->common_grams().field = "missing";
+    ASSERT_EQ(execute(make_phrase({ "as", "in", "the", "past" })), execute(q));
+  }
+}
+
 TEST(by_phrase_test, options) {
   irs::by_phrase_options opts;
   ASSERT_TRUE(opts.simple());
@@ -7829,6 +7982,28 @@ TEST(by_phrase_test, equal) {
 
     ASSERT_NE(q0, q1);
   }
+
+  // common grams
+  {
+    irs::by_phrase q0;
+    *q0.mutable_field() = "name";
+    q0.mutable_options()->push_back<irs::by_term_options>().term = irs::ref_cast<irs::byte_type>(irs::string_ref("state"));
+    q0.mutable_options()->push_back<irs::by_term_options>().term = irs::ref_cast<irs::byte_type>(irs::string_ref("of"));
+
+    irs::by_phrase q1 = q0;
+    ASSERT_EQ(q0, q1);
+    ASSERT_EQ(q0.hash(), q1.hash());
+
+    q1.mutable_options()->common_grams().field = "name_grams";
+    ASSERT_NE(q0, q1);
+
+    q0.mutable_options()->common_grams().field = "name_grams";
+    ASSERT_EQ(q0, q1);
+    ASSERT_EQ(q0.hash(), q1.hash());
+
+    q1.mutable_options()->common_grams().words.emplace(irs::ref_cast<irs::byte_type>(irs::string_ref("of")));
+    ASSERT_NE(q0, q1);
+  }
 }
 
 TEST(by_phrase_test, copy_move) {
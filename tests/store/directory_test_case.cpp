@@ -25,6 +25,7 @@
 #include "tests_param.hpp"
 
 #include "store/store_utils.hpp"
+#include "store/directory_attributes.hpp"
 #include "store/fs_directory.hpp"
 #include "store/memory_directory.hpp"
 #include "store/data_output.hpp"
@@ -1230,6 +1231,110 @@ TEST_P(directory_test_case, directory_size) {
   }
 }
 
+TEST_P(directory_test_case, io_advice_hints) {
+  {
+    irs::io_advice_hints hints;
+    ASSERT_TRUE(hints.empty());
+    ASSERT_EQ(nullptr, hints.get("_1.doc"));
+    ASSERT_EQ(irs::IOAdvice::SEQUENTIAL, hints.advice("_1.doc", irs::IOAdvice::SEQUENTIAL));
+
+    hints.set("doc", irs::IOAdvice::NORMAL);
+    hints.set("cs", irs::IOAdvice::RANDOM);
+    ASSERT_FALSE(hints.empty());
+
+    auto* hint = hints.get("_1.doc");
+    ASSERT_NE(nullptr, hint);
+    ASSERT_EQ(irs::IOAdvice::NORMAL, hint->advice);
+    ASSERT_EQ(nullptr, hints.get("doc"));
+    ASSERT_EQ(nullptr, hints.get("_1.doc_mask"));
+    ASSERT_EQ(nullptr, hints.get("_1."));
+    ASSERT_EQ(irs::IOAdvice::RANDOM, hints.advice("_1.cs", irs::IOAdvice::NORMAL));
+    ASSERT_EQ(irs::IOAdvice::READONCE_RANDOM,
+              hints.advice("_1.cs", irs::IOAdvice::READONCE));
+    ASSERT_EQ(irs::IOAdvice::NORMAL, hints.advice("_1.doc", irs::IOAdvice::NORMAL));
+
+    // access pattern given by a caller takes precedence
+    ASSERT_EQ(irs::IOAdvice::SEQUENTIAL, hints.advice("_1.cs", irs::IOAdvice::SEQUENTIAL));
+    ASSERT_EQ(irs::IOAdvice::READONCE_SEQUENTIAL,
+              hints.advice("_1.cs", irs::IOAdvice::READONCE_SEQUENTIAL));
+    ASSERT_EQ(irs::IOAdvice::RANDOM, hints.advice("_1.doc", irs::IOAdvice::RANDOM));
+
+    // 'READONCE' given by a hint is preserved
+    hints.set("cs", irs::IOAdvice::READONCE);
+    ASSERT_EQ(irs::IOAdvice::READONCE_SEQUENTIAL,
+              hints.advice("_1.cs", irs::IOAdvice::SEQUENTIAL));
+
+    hints.clear();
+    ASSERT_TRUE(hints.empty());
+  }
+
+  // write file
+  {
+    auto out = dir_->create("_1.doc");
+    ASSERT_NE(nullptr, out);
+
+    for (uint32_t i = 0; i < 100000; ++i) {
+      out->write_vint(i);
+    }
+  }
+
+  dir_->attributes().emplace<irs::io_advice_hints>()->set("doc", irs::IOAdvice::RANDOM);
+
+  // hints must not affect reading
+  for (auto advice : { irs::IOAdvice::NORMAL, irs::IOAdvice::SEQUENTIAL }) {
+    auto in = dir_->open("_1.doc", advice);
+    ASSERT_NE(nullptr, in);
+
+    for (uint32_t i = 0; i < 100000; ++i) {
+      ASSERT_EQ(i, in->read_vint());
+    }
+    ASSERT_TRUE(in->eof());
+  }
+
+  ASSERT_TRUE(dir_->attributes().remove<irs::io_advice_hints>());
+}
+
+TEST(io_advice_hints_test, advice_per_extension_and_pattern) {
+  irs::io_advice_hints hints;
+  hints.set("doc", irs::IOAdvice::NORMAL);
+  hints.set("cs", irs::IOAdvice::RANDOM);
+  hints.set("pos", irs::IOAdvice::READONCE_SEQUENTIAL);
+
+  struct {
+    irs::string_ref filename;
+    irs::IOAdvice requested;
+    irs::IOAdvice expected;
+  } const cases[] {
+    // hint with no access pattern
+    { "_1.doc", irs::IOAdvice::NORMAL, irs::IOAdvice::NORMAL },
+    { "_1.doc", irs::IOAdvice::SEQUENTIAL, irs::IOAdvice::SEQUENTIAL },
+    { "_1.doc", irs::IOAdvice::RANDOM, irs::IOAdvice::RANDOM },
+    { "_1.doc", irs::IOAdvice::READONCE, irs::IOAdvice::READONCE },
+    // hint with an access pattern
+    { "_1.cs", irs::IOAdvice::NORMAL, irs::IOAdvice::RANDOM },
+    { "_1.cs", irs::IOAdvice::SEQUENTIAL, irs::IOAdvice::SEQUENTIAL },
+    { "_1.cs", irs::IOAdvice::RANDOM, irs::IOAdvice::RANDOM },
+    { "_1.cs", irs::IOAdvice::READONCE, irs::IOAdvice::READONCE_RANDOM },
+    { "_1.cs", irs::IOAdvice::READONCE_SEQUENTIAL, irs::IOAdvice::READONCE_SEQUENTIAL },
+    // hint with an access pattern and 'READONCE'
+    { "_1.pos", irs::IOAdvice::NORMAL, irs::IOAdvice::READONCE_SEQUENTIAL },
+    { "_1.pos", irs::IOAdvice::SEQUENTIAL, irs::IOAdvice::READONCE_SEQUENTIAL },
+    { "_1.pos", irs::IOAdvice::RANDOM, irs::IOAdvice::READONCE_RANDOM },
+    { "_1.pos", irs::IOAdvice::READONCE, irs::IOAdvice::READONCE_SEQUENTIAL },
+    // no hint
+    { "_1.pay", irs::IOAdvice::NORMAL, irs::IOAdvice::NORMAL },
+    { "_1.pay", irs::IOAdvice::READONCE_RANDOM, irs::IOAdvice::READONCE_RANDOM },
+    { "_1.doc_mask", irs::IOAdvice::SEQUENTIAL, irs::IOAdvice::SEQUENTIAL },
+    { "segments_1", irs::IOAdvice::RANDOM, irs::IOAdvice::RANDOM },
+    { "doc", irs::IOAdvice::NORMAL, irs::IOAdvice::NORMAL },
+  };
+
+  for (auto& entry : cases) {
+    SCOPED_TRACE(entry.filename);
+    ASSERT_EQ(entry.expected, hints.advice(entry.filename, entry.requested));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   directory_test,
   directory_test_case,
@@ -21,7 +21,10 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <random>
+
 #include "tests_shared.hpp"
+#include "store/memory_directory.hpp"
 #include "store/store_utils.hpp"
 #ifdef IRESEARCH_SSE2
 #include "store/store_utils_simd.hpp"
@@ -471,6 +474,76 @@ TEST(store_utils_tests, vlong_from_array) {
   tests::detail::vencode_from_array(std::numeric_limits<uint64_t>::max(), 10);
 }
 
+TEST(store_utils_tests, vread_bulk) {
+  // mostly single byte values interleaved with values of all sizes
+  std::vector<uint64_t> values;
+  for (size_t i = 0; i < 1000; ++i) {
+    values.emplace_back(i % 100);
+    if (0 == i % 7) {
+      values.emplace_back(uint64_t(1) << (i % 64));
+    }
+    if (0 == i % 13) {
+      values.emplace_back(std::numeric_limits<uint64_t>::max() >> (i % 64));
+    }
+  }
+
+  irs::bstring buf;
+  {
+    irs::bytes_output out(buf);
+    for (auto value : values) {
+      out.write_vlong(value);
+    }
+  }
+
+  // read with windows of different sizes
+  for (size_t window : { 1, 3, 7, 16, 64, 4096 }) {
+    SCOPED_TRACE(window);
+    std::vector<uint64_t> actual(values.size());
+    const auto* begin = buf.c_str();
+    const auto* end = begin + buf.size();
+
+    size_t read = 0;
+    while (read < values.size()) {
+      const auto count = std::min(window, values.size() - read);
+      ASSERT_EQ(count, irs::vread_bulk(begin, end, actual.data() + read, count));
+      read += count;
+    }
+    ASSERT_EQ(end, begin);
+    ASSERT_EQ(0, irs::vread_bulk(begin, end, actual.data(), actual.size()));
+    ASSERT_EQ(values, actual);
+  }
+
+  // values truncated by the end of the range aren't read
+  std::vector<size_t> ends; // end offset of every value
+  for (const auto* it = buf.c_str(); ends.size() < values.size();) {
+    irs::vskip<uint64_t>(it);
+    ends.emplace_back(size_t(std::distance(buf.c_str(), it)));
+  }
+
+  for (size_t size = 0; size < 64; ++size) {
+    SCOPED_TRACE(size);
+    const auto expected_count = size_t(std::distance(
+      ends.begin(), std::upper_bound(ends.begin(), ends.end(), size)));
+    const auto* begin = buf.c_str();
+    const auto* end = begin + size;
+
+    std::vector<uint64_t> actual(values.size());
+    ASSERT_EQ(expected_count, irs::vread_bulk(begin, end, actual.data(), actual.size()));
+    ASSERT_EQ(expected_count ? ends[expected_count - 1] : 0,
+              size_t(std::distance(buf.c_str(), begin)));
+    ASSERT_TRUE(std::equal(values.begin(), values.begin() + expected_count, actual.begin()));
+  }
+
+  // read via bytes_ref_input
+  {
+    irs::bytes_ref_input in(buf);
+    std::vector<uint64_t> actual(values.size());
+    ASSERT_EQ(actual.size(), in.read_vlongs(actual.data(), actual.size()));
+    ASSERT_TRUE(in.eof());
+    ASSERT_EQ(values, actual);
+  }
+}
+
 TEST(store_utils_tests, zvfloat_read_write) {
   tests::detail::read_write_core<float_t>(
     {
@@ -823,6 +896,75 @@ TEST(store_utils_tests, read_write_block) {
   }
 }
 
+TEST(store_utils_tests, read_write_block_elias_fano) {
+  constexpr size_t BLOCK_SIZE = 128;
+  std::mt19937 engine;
+
+  // deltas of sequences having different density
+  std::vector<std::vector<uint32_t>> blocks;
+  blocks.emplace_back(BLOCK_SIZE, 1); // consecutive values
+  blocks.emplace_back(BLOCK_SIZE, 0); // equal values
+  blocks.emplace_back(BLOCK_SIZE, 1);
+  blocks.back()[0] = 0; // first doc of a posting list
+  blocks.emplace_back(BLOCK_SIZE, std::numeric_limits<uint32_t>::max() / BLOCK_SIZE);
+  for (const uint32_t max : { 2U, 3U, 10U, 129U, 1000U, 100000U, 1U << 24 }) {
+    std::uniform_int_distribution<uint32_t> delta(1, max);
+    auto& block = blocks.emplace_back(BLOCK_SIZE);
+    std::generate(block.begin(), block.end(), [&]() { return delta(engine); });
+  }
+
+  irs::memory_output out(irs::memory_allocator::global());
+  uint32_t encoded[BLOCK_SIZE];
+  size_t num_dense = 0;
+  for (auto& block : blocks) {
+    num_dense += irs::encode::elias_fano::write_block(out.stream, block.data(), encoded);
+  }
+  out.stream.flush();
+
+  // the two most dense random sequences, equal deltas are run length encoded
+  ASSERT_EQ(2, num_dense);
+
+  irs::memory_index_input in(out.file);
+  for (auto& block : blocks) {
+    std::vector<uint32_t> decoded(BLOCK_SIZE, std::numeric_limits<uint32_t>::max());
+    irs::encode::elias_fano::read_block(in, encoded, decoded.data());
+    ASSERT_EQ(block, decoded);
+  }
+  ASSERT_TRUE(in.eof());
+
+  // skip every other block
+  in.seek(0);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (i % 2) {
+      irs::encode::elias_fano::skip_block(in);
+    } else {
+      std::vector<uint32_t> decoded(BLOCK_SIZE);
+      irs::encode::elias_fano::read_block(in, encoded, decoded.data());
+      ASSERT_EQ(blocks[i], decoded);
+    }
+  }
+  ASSERT_TRUE(in.eof());
+}
+
+TEST(store_utils_tests, read_block_elias_fano_corrupted) {
+  constexpr size_t BLOCK_SIZE = 128;
+
+  // dense block header claiming a bitset larger than a block might take
+  irs::memory_output out(irs::memory_allocator::global());
+  out.stream.write_vlong(((64*BLOCK_SIZE + 1) << 2) | 1);
+  for (size_t i = 0; i <= BLOCK_SIZE / 2; ++i) {
+    out.stream.write_long(-1);
+  }
+  out.stream.flush();
+
+  irs::memory_index_input in(out.file);
+  uint32_t encoded[BLOCK_SIZE];
+  uint32_t decoded[BLOCK_SIZE];
+  ASSERT_THROW(irs::encode::elias_fano::read_block(in, encoded, decoded), irs::index_error);
+  in.seek(0);
+  ASSERT_THROW(irs::encode::elias_fano::skip_block(in), irs::index_error);
+}
+
 TEST(store_utils_tests, shift_pack_unpack_32) {
   tests::detail::shift_pack_unpack_core_32(2343242, true);
   tests::detail::shift_pack_unpack_core_32(2343242, false);
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "utils/automaton_cache.hpp"
+#include "utils/automaton_utils.hpp"
+
+TEST(automaton_cache_test, wildcard) {
+  irs::automaton_cache cache;
+
+  auto a = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("fo%")));
+  ASSERT_NE(nullptr, a);
+  ASSERT_TRUE(irs::accept<char>(*a, irs::string_ref("foo")));
+  ASSERT_FALSE(irs::accept<char>(*a, irs::string_ref("bar")));
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(1, stats.size);
+
+  // same automaton is returned
+  ASSERT_EQ(a, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("fo%"))));
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(1, stats.size);
+
+  // different expression
+  auto b = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("%ar")));
+  ASSERT_NE(nullptr, b);
+  ASSERT_NE(a, b);
+  ASSERT_TRUE(irs::accept<char>(*b, irs::string_ref("bar")));
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(2, stats.size);
+
+  cache.clear();
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(0, stats.misses);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_TRUE(irs::accept<char>(*a, irs::string_ref("foo"))); // still valid
+}
+
+TEST(automaton_cache_test, levenshtein) {
+  irs::automaton_cache cache;
+
+  const auto target = irs::ref_cast<irs::byte_type>(irs::string_ref("alphabet"));
+
+  auto a = cache.levenshtein(1, false, target);
+  ASSERT_NE(nullptr, a);
+  ASSERT_TRUE(irs::accept<char>(*a, irs::string_ref("alphabet")));
+  ASSERT_TRUE(irs::accept<char>(*a, irs::string_ref("alpabet")));
+  ASSERT_FALSE(irs::accept<char>(*a, irs::string_ref("alpbet")));
+  ASSERT_FALSE(irs::accept<char>(*a, irs::string_ref("lapahbet")));
+
+  // parameters are the part of the key
+  auto b = cache.levenshtein(1, true, target);
+  ASSERT_NE(nullptr, b);
+  ASSERT_NE(a, b);
+  auto c = cache.levenshtein(2, false, target);
+  ASSERT_NE(nullptr, c);
+  ASSERT_NE(a, c);
+  ASSERT_TRUE(irs::accept<char>(*c, irs::string_ref("alpbet")));
+
+  // wildcard with the same pattern is a different automaton
+  auto d = cache.wildcard(target);
+  ASSERT_NE(nullptr, d);
+  ASSERT_NE(a, d);
+
+  ASSERT_EQ(a, cache.levenshtein(1, false, target));
+  ASSERT_EQ(b, cache.levenshtein(1, true, target));
+  ASSERT_EQ(c, cache.levenshtein(2, false, target));
+
+  auto stats = cache.statistics();
+  ASSERT_EQ(3, stats.hits);
+  ASSERT_EQ(4, stats.misses);
+  ASSERT_EQ(4, stats.size);
+
+  // no parametric description
+  ASSERT_EQ(nullptr, cache.levenshtein(5, false, target));
+}
+
+TEST(automaton_cache_test, max_memory) {
+  // estimate memory consumed by a single entry, wildcards below are of the
+  // same shape and have keys of the same length
+  size_t entry_memory;
+  {
+    irs::automaton_cache cache;
+    auto a = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%")));
+    ASSERT_NE(nullptr, a);
+    entry_memory = cache.statistics().memory;
+    ASSERT_EQ(3 + irs::automaton_cache::memory(*a), entry_memory);
+    ASSERT_LT(sizeof(irs::automaton), entry_memory);
+  }
+
+  irs::automaton_cache cache(2*entry_memory);
+
+  auto a = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%")));
+  auto b = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("b%")));
+  ASSERT_EQ(2*entry_memory, cache.statistics().memory);
+  ASSERT_EQ(a, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%")))); // 'b%' is least recently used now
+  auto c = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("c%"))); // evicts 'b%'
+  auto stats = cache.statistics();
+  ASSERT_EQ(2, stats.size);
+  ASSERT_EQ(2*entry_memory, stats.memory);
+
+  ASSERT_EQ(a, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%"))));
+  ASSERT_EQ(c, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("c%"))));
+  ASSERT_NE(b, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("b%"))));
+
+  // automaton exceeding the limit on its own isn't cached
+  auto large = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%b%c%d%e%f%")));
+  ASSERT_NE(nullptr, large);
+  ASSERT_LT(2*entry_memory, 13 + irs::automaton_cache::memory(*large));
+  ASSERT_NE(large, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("a%b%c%d%e%f%"))));
+  stats = cache.statistics();
+  ASSERT_EQ(2, stats.size);
+  ASSERT_EQ(2*entry_memory, stats.memory);
+
+  // shrink
+  cache.max_memory(entry_memory);
+  stats = cache.statistics();
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(entry_memory, stats.memory);
+  ASSERT_EQ(entry_memory, stats.max_memory);
+
+  // caching disabled
+  cache.max_memory(0);
+  stats = cache.statistics();
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.memory);
+  auto d = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("d%")));
+  ASSERT_NE(nullptr, d);
+  ASSERT_TRUE(irs::accept<char>(*d, irs::string_ref("dd")));
+  ASSERT_NE(d, cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("d%"))));
+  ASSERT_EQ(0, cache.statistics().size);
+}
+
+TEST(automaton_cache_test, concurrent) {
+  constexpr size_t THREADS = 8;
+  constexpr size_t ITERATIONS = 100;
+
+  // room for 16 automatons of the same shape with keys of the same length
+  size_t entry_memory;
+  {
+    irs::automaton_cache cache;
+    cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref("00%")));
+    entry_memory = cache.statistics().memory;
+  }
+
+  irs::automaton_cache cache(16*entry_memory);
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{ false };
+
+  for (size_t i = 0; i < THREADS; ++i) {
+    threads.emplace_back([&cache, &failed, i]() {
+      for (size_t j = 0; j < ITERATIONS; ++j) {
+        const auto expr = std::to_string(10 + (i + j) % 32) + "%";
+        auto a = cache.wildcard(irs::ref_cast<irs::byte_type>(irs::string_ref(expr)));
+
+        if (!a || !irs::accept<char>(*a, irs::string_ref(expr + "abc"))) {
+          failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(failed);
+  const auto stats = cache.statistics();
+  ASSERT_EQ(THREADS*ITERATIONS, stats.hits + stats.misses);
+  ASSERT_EQ(16, stats.size);
+}
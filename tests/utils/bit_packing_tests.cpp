@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <random>
   
 using namespace iresearch;
 
@@ -181,6 +182,38 @@ TEST(bit_packing_tests, pack_unpack_32) {
   }
 }
 
+TEST(bit_packing_tests, unpack_block_32_kernels) {
+  std::mt19937 engine;
+  std::uniform_int_distribution<uint32_t> dist;
+
+  for (const auto isa : { packed::unpack_isa::SCALAR,
+                          packed::unpack_isa::AVX2,
+                          packed::unpack_isa::AVX512 }) {
+    const auto* kernels = packed::unpack_block32_kernels(isa);
+
+    if (!kernels) {
+      // instruction set isn't supported by the host CPU
+      ASSERT_NE(packed::unpack_isa::SCALAR, isa);
+      continue;
+    }
+
+    for (uint32_t bits = 1; bits <= packed::BLOCK_SIZE_32; ++bits) {
+      std::vector<uint32_t> src(packed::BLOCK_SIZE_32);
+      std::generate(src.begin(), src.end(), [&]() {
+        return dist(engine) & packed::max_value<uint32_t>(bits);
+      });
+
+      // exactly 'bits' words to catch reads beyond the end of a block
+      std::vector<uint32_t> encoded(bits, 0);
+      packed::pack_block(src.data(), encoded.data(), bits);
+
+      std::vector<uint32_t> decoded(packed::BLOCK_SIZE_32, 0);
+      kernels[bits - 1](encoded.data(), decoded.data());
+      ASSERT_EQ(src, decoded) << "isa=" << int(isa) << ", bits=" << bits;
+    }
+  }
+}
+
 TEST(bit_packing_tests, pack_unpack_64) {
   std::vector<uint64_t> src{
     14410, 21766, 15994, 29493, 20819, 14410123456789, 21766234567890, 159943456789012, 294934567890123, 208195678901234,
@@ -24,6 +24,7 @@
 #include "store/store_utils.hpp"
 #include "utils/lz4compression.hpp"
 #include "utils/delta_compression.hpp"
+#include "utils/zstdcompression.hpp"
 
 #include <numeric>
 #include <random>
@@ -202,3 +203,194 @@ TEST(compression_test, delta) {
     );
   }
 }
+
+#ifdef USE_ZSTD
+
+namespace {
+
+// generates a block of small JSON documents sharing structure and vocabulary
+irs::bstring json_block(std::mt19937& engine, size_t size) {
+  static const char* NAMES[] { "alice", "bob", "carol", "dave", "eve", "frank" };
+  static const char* CITIES[] { "Berlin", "Cologne", "Munich", "Hamburg" };
+
+  std::uniform_int_distribution<size_t> dist;
+  std::string block;
+
+  while (block.size() < size) {
+    block += "{\"_key\":\"";
+    block += std::to_string(dist(engine) % 1000000);
+    block += "\",\"name\":\"";
+    block += NAMES[dist(engine) % IRESEARCH_COUNTOF(NAMES)];
+    block += "\",\"address\":{\"city\":\"";
+    block += CITIES[dist(engine) % IRESEARCH_COUNTOF(CITIES)];
+    block += "\",\"zip\":";
+    block += std::to_string(10000 + dist(engine) % 90000);
+    block += "},\"active\":";
+    block += dist(engine) % 2 ? "true" : "false";
+    block += ",\"score\":";
+    block += std::to_string(dist(engine) % 100);
+    block += "}";
+  }
+
+  return irs::bstring(irs::ref_cast<irs::byte_type>(irs::string_ref(block)));
+}
+
+}
+
+TEST(compression_test, zstd) {
+  using namespace iresearch;
+  static_assert("iresearch::compression::zstd" == irs::type<irs::compression::zstd>::name());
+  ASSERT_TRUE(irs::compression::exists(irs::type<irs::compression::zstd>::get().name()));
+
+  std::vector<size_t> data(2047, 0);
+  std::random_device rnd_device;
+  std::mt19937 mersenne_engine {rnd_device()};
+  std::uniform_int_distribution<size_t> dist {1, 2142152};
+  auto generator = [&dist, &mersenne_engine](){ return dist(mersenne_engine); };
+
+  compression::zstd::zstd_decompressor decompressor;
+  compression::zstd::zstd_compressor compressor;
+  ASSERT_EQ(0, compressor.level());
+
+  for (size_t i = 0; i < 10; ++i) {
+    std::generate(data.begin(), data.end(), generator);
+
+    bstring compression_buf;
+    bstring data_buf(data.size()*sizeof(size_t), 0);
+    std::memcpy(&data_buf[0], data.data(), data_buf.size());
+
+    const auto compressed = compressor.compress(&data_buf[0], data_buf.size(), compression_buf);
+    ASSERT_EQ(compressed, bytes_ref(compression_buf.c_str(), compressed.size()));
+
+    // zstd doesn't modify data_buf
+    ASSERT_EQ(
+      bytes_ref(reinterpret_cast<const byte_type*>(data.data()), data.size()*sizeof(size_t)),
+      bytes_ref(data_buf)
+    );
+
+    bstring decompression_buf(data_buf.size(), 0); // ensure we have enough space in buffer
+    const auto decompressed = decompressor.decompress(&compression_buf[0], compressed.size(),
+                                                      &decompression_buf[0], decompression_buf.size());
+
+    ASSERT_EQ(data_buf, decompression_buf);
+    ASSERT_EQ(data_buf, decompressed);
+  }
+
+  // not enough data to train a dictionary
+  ASSERT_TRUE(compressor.dictionary().empty());
+}
+
+TEST(compression_test, zstd_dictionary) {
+  using namespace iresearch;
+
+  constexpr size_t BLOCK_SIZE = 8192;
+  constexpr size_t BLOCKS = 2*compression::zstd::TRAINING_SIZE/BLOCK_SIZE;
+
+  std::mt19937 engine;
+  std::vector<bstring> blocks;
+  std::generate_n(std::back_inserter(blocks), BLOCKS,
+                  [&engine](){ return json_block(engine, BLOCK_SIZE); });
+
+  auto compressor = compression::get_compressor(
+    type<compression::zstd>::get(), compression::options{});
+  ASSERT_NE(nullptr, compressor);
+  auto* zstd_compressor = dynamic_cast<compression::zstd::zstd_compressor*>(compressor.get());
+  ASSERT_NE(nullptr, zstd_compressor);
+
+  // compressor without a dictionary
+  compression::zstd::zstd_compressor plain_compressor(0, false);
+
+  std::vector<bstring> compressed;
+  size_t compressed_size = 0;
+  size_t plain_size = 0;
+
+  size_t samples = 0; // amount of data compressed so far
+
+  for (auto& block : blocks) {
+    bstring buf;
+
+    ASSERT_EQ(samples < compression::zstd::TRAINING_SIZE, zstd_compressor->dictionary().empty());
+    compressed.emplace_back(compressor->compress(&block[0], block.size(), buf));
+
+    if (samples >= compression::zstd::TRAINING_SIZE) {
+      compressed_size += compressed.back().size();
+      plain_size += plain_compressor.compress(&block[0], block.size(), buf).size();
+    }
+
+    samples += block.size();
+  }
+
+  const auto& dictionary = zstd_compressor->dictionary();
+  ASSERT_FALSE(dictionary.empty());
+  ASSERT_LE(dictionary.size(), compression::zstd::DICTIONARY_CAPACITY);
+  ASSERT_TRUE(plain_compressor.dictionary().empty());
+  ASSERT_LT(compressed_size, plain_size); // dictionary pays off
+
+  // flush dictionary
+  bstring payload;
+  {
+    bytes_output out(payload);
+    compressor->flush(out);
+  }
+
+  // decompressor without dictionary handles blocks compressed before training only
+  {
+    auto decompressor = compression::get_decompressor(type<compression::zstd>::get());
+    ASSERT_NE(nullptr, decompressor);
+    bstring empty_payload;
+    {
+      bytes_output out(empty_payload);
+      plain_compressor.flush(out);
+    }
+    ASSERT_TRUE(empty_payload.empty());
+
+    bstring buf(BLOCK_SIZE + 1024, 0);
+    ASSERT_EQ(blocks.front(), decompressor->decompress(
+      compressed.front().c_str(), compressed.front().size(), &buf[0], buf.size()));
+    ASSERT_TRUE(decompressor->decompress(
+      compressed.back().c_str(), compressed.back().size(), &buf[0], buf.size()).null());
+  }
+
+  auto decompressor = compression::get_decompressor(type<compression::zstd>::get());
+  ASSERT_NE(nullptr, decompressor);
+  bytes_ref_input in(payload);
+  ASSERT_TRUE(decompressor->prepare(in));
+  ASSERT_TRUE(in.eof());
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    bstring buf(BLOCK_SIZE + 1024, 0);
+    const auto decompressed = decompressor->decompress(
+      compressed[i].c_str(), compressed[i].size(), &buf[0], buf.size());
+    ASSERT_EQ(blocks[i], decompressed);
+  }
+}
+
+TEST(compression_test, zstd_no_dictionary) {
+  using namespace iresearch;
+
+  auto compressor = compression::get_compressor(
+    type<compression::zstd>::get(),
+    compression::options{ compression::options::Hint::SPEED, false });
+  ASSERT_NE(nullptr, compressor);
+  auto* zstd_compressor = dynamic_cast<compression::zstd::zstd_compressor*>(compressor.get());
+  ASSERT_NE(nullptr, zstd_compressor);
+  ASSERT_EQ(1, zstd_compressor->level());
+
+  std::mt19937 engine;
+  bstring buf;
+  for (size_t i = 0; i < 2*compression::zstd::TRAINING_SIZE; i += 8192) {
+    auto block = json_block(engine, 8192);
+    compressor->compress(&block[0], block.size(), buf);
+  }
+  ASSERT_TRUE(zstd_compressor->dictionary().empty());
+
+  // nothing to store in column metadata
+  bstring payload;
+  {
+    bytes_output out(payload);
+    compressor->flush(out);
+  }
+  ASSERT_TRUE(payload.empty());
+}
+
+#endif // USE_ZSTD
@@ -1038,3 +1038,75 @@ TEST(levenshtein_utils_test, test_description_invalid) {
     ASSERT_EQ(0, description.max_distance());
   }
 }
+
+TEST(levenshtein_utils_test, test_bit_parallel_distance) {
+  const irs::string_ref WORDS[] {
+    "", "a", "ab", "ba", "abc", "acb", "bca", "aec", "abcd", "badc",
+    "alphabet", "alpahbet", "lapahbet", "elephant", "relevant", "relevnat",
+    "aaaaaaaa", "aaaaaaab",
+    "\xD0\xBF\xD1\x83\xD1\x82\xD0\xB8\xD0\xBD",
+    "\xD1\x85\xD1\x83\xD0\xB9\xD0\xBB\xD0\xBE",
+    "\xD1\x83\xD0\xBF\xD1\x82\xD0\xB8\xD0\xBD",
+    "\xD0\xBF\xD1\x83\xD1\x82\xD0\xB8",
+    "0123456789012345678901234567890123456789012345678901234567890123",
+    "0123456789012345678901234567890123456789012345678901234567890124",
+    "1023456789012345678901234567890123456789012345678901234567890123",
+  };
+
+  for (irs::byte_type max_distance = 1; max_distance <= 3; ++max_distance) {
+    for (const bool with_transpositions : { false, true }) {
+      // parametric description is used as a reference implementation
+      const auto description = irs::make_parametric_description(max_distance, with_transpositions);
+      ASSERT_TRUE(bool(description));
+
+      for (auto& target : WORDS) {
+        irs::bit_parallel_edit_distance distance(
+          irs::ref_cast<irs::byte_type>(target), max_distance, with_transpositions);
+        ASSERT_TRUE(bool(distance));
+        ASSERT_EQ(max_distance, distance.max_distance());
+        ASSERT_EQ(irs::utf8_utils::utf8_length(irs::ref_cast<irs::byte_type>(target)),
+                  distance.target_size());
+
+        for (auto& word : WORDS) {
+          SCOPED_TRACE(testing::Message("Target: '") << target
+                       << "', Word: '" << word
+                       << "', Distance: " << size_t(max_distance)
+                       << ", Transpositions: " << with_transpositions);
+
+          ASSERT_EQ(irs::edit_distance(description,
+                                       irs::ref_cast<irs::byte_type>(target),
+                                       irs::ref_cast<irs::byte_type>(word)),
+                    distance(irs::ref_cast<irs::byte_type>(word)));
+        }
+      }
+    }
+  }
+
+  // transposition is a single change
+  {
+    irs::bit_parallel_edit_distance distance(
+      irs::ref_cast<irs::byte_type>(irs::string_ref("alphabet")), 1, true);
+    ASSERT_EQ(1, distance(irs::ref_cast<irs::byte_type>(irs::string_ref("alpahbet"))));
+    ASSERT_EQ(2, distance(irs::ref_cast<irs::byte_type>(irs::string_ref("lapahbet"))));
+  }
+
+  // truncated UTF-8 sequence
+  {
+    const irs::byte_type invalid[] { 0x61, 0xD0 };
+
+    irs::bit_parallel_edit_distance distance(
+      irs::ref_cast<irs::byte_type>(irs::string_ref("a")), 1, false);
+    ASSERT_TRUE(bool(distance));
+    ASSERT_EQ(2, distance(irs::bytes_ref(invalid, std::size(invalid))));
+
+    ASSERT_FALSE(bool(irs::bit_parallel_edit_distance(
+      irs::bytes_ref(invalid, std::size(invalid)), 1, false)));
+  }
+
+  // target is too long
+  {
+    const std::string target(irs::bit_parallel_edit_distance::MAX_TARGET_SIZE + 1, 'a');
+    ASSERT_FALSE(bool(irs::bit_parallel_edit_distance(
+      irs::ref_cast<irs::byte_type>(irs::string_ref(target)), 1, false)));
+  }
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/lru_cache.hpp"
+
+TEST(lru_cache_test, get_emplace_erase) {
+  irs::lru_cache<std::string, int> cache;
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.memory());
+  ASSERT_EQ(nullptr, cache.get("a"));
+
+  auto res = cache.emplace("a", 1, 10);
+  ASSERT_TRUE(res.second);
+  ASSERT_NE(nullptr, res.first);
+  ASSERT_EQ(1, *res.first);
+
+  // value is already cached
+  res = cache.emplace("a", 2, 20);
+  ASSERT_FALSE(res.second);
+  ASSERT_EQ(1, *res.first);
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(10, cache.memory());
+
+  ASSERT_TRUE(cache.emplace("b", 2, 20).second);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(30, cache.memory());
+  ASSERT_NE(nullptr, cache.get("b"));
+  ASSERT_EQ(2, *cache.get("b"));
+  ASSERT_NE(nullptr, cache.find("a"));
+  ASSERT_EQ(1, *cache.find("a"));
+
+  ASSERT_TRUE(cache.erase("a"));
+  ASSERT_FALSE(cache.erase("a"));
+  ASSERT_EQ(nullptr, cache.find("a"));
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(20, cache.memory());
+
+  cache.clear();
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(0, cache.memory());
+  ASSERT_EQ(nullptr, cache.get("b"));
+}
+
+TEST(lru_cache_test, shrink) {
+  irs::lru_cache<int, std::unique_ptr<int>> cache;
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(cache.emplace(i, std::make_unique<int>(i), 10).second);
+  }
+  ASSERT_EQ(40, cache.memory());
+
+  // 0 is the least recently used one, get marks 0 as recently used while
+  // find doesn't affect the order, so 1 and 2 are evicted first
+  ASSERT_NE(nullptr, cache.get(0));
+  ASSERT_NE(nullptr, cache.find(1));
+
+  std::vector<int> evicted;
+  auto visitor = [&evicted](int key, const std::unique_ptr<int>& value) {
+    ASSERT_EQ(key, *value);
+    evicted.push_back(key);
+  };
+
+  ASSERT_EQ(2, cache.shrink(20, 0, visitor));
+  ASSERT_EQ((std::vector<int>{ 1, 2 }), evicted);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(20, cache.memory());
+
+  // nothing to evict
+  ASSERT_EQ(0, cache.shrink(20, 0, visitor));
+
+  // the most recently used value is kept
+  ASSERT_EQ(1, cache.shrink(0, 1, visitor));
+  ASSERT_EQ((std::vector<int>{ 1, 2, 3 }), evicted);
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(10, cache.memory());
+  ASSERT_NE(nullptr, cache.find(0));
+
+  ASSERT_EQ(10, cache.pop(visitor));
+  ASSERT_EQ((std::vector<int>{ 1, 2, 3, 0 }), evicted);
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(0, cache.memory());
+
+  ASSERT_TRUE(cache.emplace(5, std::make_unique<int>(5), 10).second);
+  ASSERT_EQ(1, cache.shrink(0));
+  ASSERT_TRUE(cache.empty());
+}
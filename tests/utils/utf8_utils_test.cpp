@@ -454,3 +454,25 @@ TEST(utf8_utils_test, utf32_to_utf8) {
     ASSERT_EQ(buf[3], 0x96);
   }
 }
+
+TEST(utf8_utils_test, is_ascii) {
+  ASSERT_TRUE(irs::utf8_utils::is_ascii(irs::bytes_ref::EMPTY));
+  ASSERT_TRUE(irs::utf8_utils::is_ascii(irs::ref_cast<irs::byte_type>(irs::string_ref("quick brown fox"))));
+
+  // check every position of a non-ASCII byte within chunks of various size
+  for (size_t size = 1; size < 200; ++size) {
+    std::string str(size, 'a');
+    ASSERT_TRUE(irs::utf8_utils::is_ascii(irs::ref_cast<irs::byte_type>(irs::string_ref(str))));
+    str[size - 1] = '\x7F';
+    ASSERT_TRUE(irs::utf8_utils::is_ascii(irs::ref_cast<irs::byte_type>(irs::string_ref(str))));
+    str[size - 1] = 'a';
+
+    for (size_t i = 0; i < size; ++i) {
+      str[i] = '\x80';
+      ASSERT_FALSE(irs::utf8_utils::is_ascii(irs::ref_cast<irs::byte_type>(irs::string_ref(str))));
+      ASSERT_TRUE(irs::utf8_utils::is_ascii(
+        reinterpret_cast<const irs::byte_type*>(str.c_str()), i));
+      str[i] = 'a';
+    }
+  }
+}